@@ -8,6 +8,7 @@
 #include "ARAMacros.h"
 #include "AbstractNetworkClient.h"
 #include "TimeoutEventListener.h"
+#include "RouteEvictionListener.h"
 #include "Configuration.h"
 #include "Logger.h"
 #include "Address.h"
@@ -18,8 +19,10 @@
 #include "RoutingTable.h"
 #include "Packet.h"
 #include "ForwardingPolicy.h"
+#include "FlowCache.h"
 #include "PathReinforcementPolicy.h"
 #include "RouteDiscoveryInfo.h"
+#include "PeerStateTable.h"
 #include "Timer.h"
 #include "Time.h"
 
@@ -32,18 +35,12 @@
 
 ARA_NAMESPACE_BEGIN
 
-typedef std::unordered_map<AddressPtr, Timer*, AddressHash, AddressPredicate> RunningRouteDiscoveriesMap;
-typedef std::unordered_map<AddressPtr, std::unordered_set<unsigned int>*, AddressHash, AddressPredicate> LastReceivedPacketsMap;
-typedef std::unordered_map<AddressPtr, std::unordered_set<AddressPtr>*, AddressHash, AddressPredicate> KnownIntermediateHopsMap;
-typedef std::unordered_map<AddressPtr, unsigned int, AddressHash, AddressPredicate> LastRouteDiscoveriesMap;
-typedef std::unordered_map<AddressPtr, std::pair<Time*, NetworkInterface*>, AddressHash, AddressPredicate> NeighborActivityMap;
-typedef std::unordered_map<AddressPtr, Timer*, AddressHash, AddressPredicate> ScheduledPANTsMap;
 typedef std::unordered_set<Timer*> DeliveryTimerSet;
 
 /**
  * TODO write class description
  */
-class AbstractARAClient : public virtual AbstractNetworkClient, public TimeoutEventListener {
+class AbstractARAClient : public virtual AbstractNetworkClient, public TimeoutEventListener, public RouteEvictionListener {
 
 public:
     /**
@@ -110,15 +107,33 @@ public:
 
     virtual void timerHasExpired(Timer* responsibleTimer);
 
+    /**
+     * An evicted route is handled just like a route that has been deleted because of a route failure.
+     * @see AbstractARAClient::deleteRoutingTableEntry
+     */
+    virtual void routeHasBeenEvicted(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
     void setMaxNrOfRouteDiscoveryRetries(int maxNrOfRouteDiscoveryRetries);
 
-    void setForwardingPolicy(ForwardingPolicy* newForwardingPolicy);
+    virtual void setForwardingPolicy(ForwardingPolicy* newForwardingPolicy);
 
     int getMaxTTL() const;
 
 protected:
 
-    virtual void sendUnicast(Packet* packet, NetworkInterface* interface, AddressPtr receiver);
+    virtual void sendUnicast(Packet* packet, NetworkInterface* interface, const AddressPtr& receiver);
+
+    /**
+     * Returns the next hop of the given data packet. This is the next hop that is kept in the flow
+     * cache for the flow of the packet or the one chosen by the forwarding policy.
+     */
+    NextHop* getNextHop(const Packet* packet);
+
+    /**
+     * Sends the given data packet to the given next hop over a route that has already been
+     * reinforced to the given pheromone value.
+     */
+    void forwardDataPacket(Packet* packet, const AddressPtr& nextHop, NetworkInterface* interface, float newPheromoneValue);
 
     /**
      * This method either initializes or reinforces a route in the routing table.
@@ -136,11 +151,18 @@ protected:
      * Handles path reinforcement using the currently set PathReinforcementPolicy.
      * The new pheromone value is returned.
      */
-    virtual float reinforcePheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+    virtual float reinforcePheromoneValue(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface);
+
+    /**
+     * Reinforces the route the given handle refers to in place.
+     * The new pheromone value is returned.
+     */
+    virtual float reinforcePheromoneValue(RouteHandle& route);
 
     /**
      * Checks if the given packet has been received before by checking the source address and
-     * sequence number field.
+     * sequence number field. Packets other than DATA packets are also reported if their sequence
+     * number is too old to be remembered.
      */
     virtual bool hasBeenReceivedEarlier(const Packet* packet);
 
@@ -172,7 +194,7 @@ protected:
     void startRouteDiscoveryTimer(const Packet* packet);
     void forgetKnownIntermediateHopsFor(AddressPtr destination);
     void broadcastFANT(AddressPtr destination);
-    bool isRouteDiscoveryRunning(AddressPtr destination);
+    bool isRouteDiscoveryRunning(const AddressPtr& destination);
     virtual void handleNonSourceRouteDiscovery(Packet* packet);
     virtual void handlePacketWithZeroTTL(Packet* packet);
     void stopRouteDiscoveryTimer(AddressPtr destination);
@@ -181,6 +203,12 @@ protected:
     virtual void createNewRouteFrom(Packet* packet, NetworkInterface* interface);
     bool hasPreviousNodeBeenSeenBefore(const Packet* packet);
     void deleteRoutingTableEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+    /**
+     * Notifies the neighbors with a ROUTE_FAILURE packet if a route to the given destination has
+     * just been removed and at most one route is left.
+     */
+    void handleRemovedRoute(AddressPtr destination, NetworkInterface* interface);
     void broadcastRouteFailure(AddressPtr destination);
     void broadcastPANT(AddressPtr destination);
     void checkPantTimer(const Packet* packet);
@@ -190,8 +218,15 @@ protected:
     void handleExpiredPANTTimer(Timer* pantTimer);
 
     void startNeighborActivityTimer();
-    void registerActivity(AddressPtr neighbor, NetworkInterface* interface);
+    void registerActivity(const AddressPtr& neighbor, NetworkInterface* interface);
     void checkInactiveNeighbors();
+
+    /**
+     * Erases the state of the given node if it is neither a known neighbor nor involved in a route
+     * discovery or PANT and no route to it is left. The received sequence numbers of a node must be
+     * kept as long as it can be reached, because its packets may still come back over a loop.
+     */
+    void forgetPeerIfUnused(const AddressPtr& peer);
     bool isNewRouteDiscovery(const Packet* packet);
 
     /**
@@ -201,9 +236,8 @@ protected:
 
 protected:
     Timer* neighborActivityTimer = nullptr;
+    FlowCache* flowCache = nullptr;
 
-    RunningRouteDiscoveriesMap runningRouteDiscoveries;
-    ScheduledPANTsMap scheduledPANTs;
     DeliveryTimerSet runningDeliveryTimers;
 
     ForwardingPolicy* forwardingPolicy;
@@ -219,28 +253,13 @@ protected:
     bool isPreviousHopFeatureActivated;
     int maxNrOfRouteDiscoveryRetries;
 
-    //TODO the knownIntermediateHops and lastReceivedPackets may be merged into a single hashmap
-    LastReceivedPacketsMap lastReceivedPackets;
-
-    /**
-     * This hashmap records the seen hops to a specific destination. This includes direct neighbors as well as indirect
-     * nodes this client has learned from the penultimate packet field.
-     */
-    KnownIntermediateHopsMap knownIntermediateHops;
-
-    /**
-     * This hashmap holds information of the last time a neighbor has shown some activity.
-     * This could either be that this client has successfully received or send a packet to/from this client
-     */
-    NeighborActivityMap neighborActivityTimes;
-
     /**
-     * We identify each route discovery by its origin (source address) and sequence number.
-     * When we receive a new ant packet we check its sequence number with this. If they differ,
-     * this is a new route discovery and we need to forget about all knownIntermediateHops for
-     * the packets source we know so far.
+     * This table holds everything the client remembers about the other nodes: The recently received
+     * sequence numbers, the known intermediate hops and the last route discovery of each source,
+     * the last activity of each neighbor as well as the running route discoveries and scheduled
+     * PANTs for each destination (see PeerState).
      */
-    LastRouteDiscoveriesMap lastRouteDiscoverySeqNumbers;
+    PeerStateTable peerStates;
 };
 
 ARA_NAMESPACE_END
@@ -15,7 +15,7 @@
 
 ARA_NAMESPACE_BEGIN
 
-typedef std::unordered_map<AddressPtr, Timer*, AddressHash, AddressPredicate> RouteDiscoveryDelayTimerMap;
+typedef std::unordered_map<AddressId, Timer*> RouteDiscoveryDelayTimerMap;
 
 struct AntPacketRouteFitness {
     Packet* packet;
@@ -76,7 +76,7 @@ public:
 
 protected:
 
-    virtual void sendUnicast(Packet* packet, NetworkInterface* interface, AddressPtr receiver);
+    virtual void sendUnicast(Packet* packet, NetworkInterface* interface, const AddressPtr& receiver);
 
     virtual void updateRoutingTable(Packet* packet, NetworkInterface* interface);
 
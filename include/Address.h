@@ -5,6 +5,8 @@
 #ifndef ADDRESS_H_
 #define ADDRESS_H_
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <sstream>
 #include <stddef.h>
@@ -13,12 +15,46 @@
 
 namespace ARA {
 
+/**
+ * The id of an address in the AddressTable.
+ */
+typedef uint32_t AddressId;
+
+/**
+ * The id of an address that has not been interned in the AddressTable yet.
+ */
+const AddressId UNKNOWN_ADDRESS_ID = UINT32_MAX;
+
+/**
+ * The entry of an interned address in the AddressTable.
+ */
+struct InternedAddress;
+
 /**
  * This represents an arbitrary network address.
+ *
+ * Concrete addresses must not change their value once their id has been requested, because the
+ * id is cached in the object. The only exception is the assignment operator, which makes the
+ * address forget its id.
  */
 class Address {
 public:
-    virtual ~Address() {}
+    Address() : id(UNKNOWN_ADDRESS_ID), internedAddress(nullptr) {}
+
+    /**
+     * The interned id is not copied because the copy may be changed afterwards
+     * (e.g. by the assignment operator of a concrete address).
+     */
+    Address(const Address& otherAddress) : id(UNKNOWN_ADDRESS_ID), internedAddress(nullptr) {}
+
+    Address& operator=(const Address& otherAddress) {
+        forgetId();
+        return *this;
+    }
+
+    virtual ~Address() {
+        forgetId();
+    }
 
     /**
      * Returns a null-terminated textual representation of this address.
@@ -43,23 +79,122 @@ public:
         return out;
     }
 
+private:
+    /**
+     * Drops the reference of this address to its entry in the AddressTable.
+     */
+    void forgetId();
+
+    /**
+     * The id of this address in the AddressTable (or UNKNOWN_ADDRESS_ID if it has not
+     * been interned yet) and the entry it refers to. This is only accessed by the AddressTable.
+     */
+    mutable std::atomic<AddressId> id;
+    mutable InternedAddress* internedAddress;
+
+    friend class AddressTable;
+    friend struct InternedAddress;
+};
+
+/**
+ * The AddressTable interns addresses: Each distinct address (according to Address::equals(..))
+ * is mapped to a unique id. The ids are handed out consecutively, starting with 0. Hashing and comparing addresses via their ids are simple integer
+ * operations instead of virtual calls.
+ *
+ * The id is cached in the address object, so only the first lookup of each address object goes
+ * through the table. This first lookup costs a lock of the table (which is shared by all clients
+ * of the process) and a virtual getHashValue() and equals(..) call, so addresses should be reused
+ * where possible instead of creating new objects for each lookup.
+ *
+ * The table counts the address objects that cache an id and the references of state that is
+ * only kept by id (see AddressTable::retain(..)). An address is released once its count drops
+ * to zero. The released entries are collected incrementally by the following lookups.
+ * The ids of released addresses are never reused, so a stale id which is still kept somewhere
+ * can never be mistaken for another address. An equal address that is interned again later on
+ * gets a new id.
+ */
+class AddressTable {
+public:
+    /**
+     * Returns the id of the given address. The address is interned if no equal
+     * address has been interned before.
+     */
+    static AddressId getId(const std::shared_ptr<Address>& address) {
+        AddressId id = address->id.load(std::memory_order_relaxed);
+        if (id != UNKNOWN_ADDRESS_ID) {
+            return id;
+        }
+        return intern(address);
+    }
+
+    /**
+     * Returns the address that has been interned with the given id (which is equal to all
+     * addresses with this id).
+     *
+     * @throws NoSuchElementException if no address is interned with this id
+     */
+    static std::shared_ptr<Address> getAddress(AddressId id);
+
+    /**
+     * Keeps the address with the given id in the table until release(..) is called, even if
+     * no address object refers to the id anymore. This is used by state that is kept by id
+     * but does not hold the address itself.
+     *
+     * @throws NoSuchElementException if no address is interned with this id
+     */
+    static void retain(AddressId id);
+
+    /**
+     * Drops a reference that has been acquired with retain(..).
+     *
+     * @throws NoSuchElementException if no address is interned with this id
+     */
+    static void release(AddressId id);
+
+    /**
+     * Removes all addresses that are not referred to anymore right away (instead of waiting
+     * for the incremental collection).
+     */
+    static void releaseUnusedAddresses();
+
+    /**
+     * Returns the number of currently interned addresses (including the released ones
+     * that have not been collected yet).
+     */
+    static unsigned int size();
+
+private:
+    static AddressId intern(const std::shared_ptr<Address>& address);
+    static void forget(InternedAddress* internedAddress);
+
+    friend class Address;
 };
 
+inline void Address::forgetId() {
+    if (internedAddress != nullptr) {
+        id.store(UNKNOWN_ADDRESS_ID, std::memory_order_relaxed);
+        AddressTable::forget(internedAddress);
+        internedAddress = nullptr;
+    }
+}
+
 /**
- * This Functor is needed for std::unordered_map (hashmap implementation)
+ * This Functor is needed for std::unordered_map (hashmap implementation).
+ * The hash value is the id of the address in the AddressTable.
  */
 struct AddressHash {
-    size_t operator()(std::shared_ptr<Address> address) const {
-        return address->getHashValue();
+    size_t operator()(const std::shared_ptr<Address>& address) const {
+        return AddressTable::getId(address);
     }
 };
 
 /**
- * This Functor is needed for std::unordered_map (hashmap implementation)
+ * This Functor is needed for std::unordered_map (hashmap implementation).
+ * Two addresses are equal if they have the same id in the AddressTable.
  */
 struct AddressPredicate {
-    size_t operator()(std::shared_ptr<Address> address1, std::shared_ptr<Address> address2) const {
-        return address1->equals(address2);
+    bool operator()(const std::shared_ptr<Address>& address1, const std::shared_ptr<Address>& address2) const {
+        return AddressTable::getId(address1) == AddressTable::getId(address2);
     }
 };
 
@@ -0,0 +1,125 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef BASIC_ARA_CLIENT_H_
+#define BASIC_ARA_CLIENT_H_
+
+#include "ARAMacros.h"
+#include "AbstractARAClient.h"
+#include "Configuration.h"
+#include "Exception.h"
+
+#include <typeinfo>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The BasicARAClient is a front end of the AbstractARAClient for deployments whose routing table
+ * and policies are fixed at compile time. The calls into the routing table, the forwarding policy
+ * and the path reinforcement policy that are made for each DATA packet are bound to the given types,
+ * so they are direct calls that can be inlined instead of virtual calls.
+ *
+ * Each object of the configuration must be of exactly the given type (not of a subclass that might
+ * override the statically bound methods), otherwise an Exception is thrown on initialization. The
+ * evaporation policy is only checked because it is applied by the routing table itself.
+ *
+ * Everything else behaves exactly like the AbstractARAClient, so concrete clients only need to
+ * derive from this class instead of the AbstractARAClient.
+ */
+template<class RoutingTableT, class ForwardingPolicyT, class PathReinforcementPolicyT, class EvaporationPolicyT>
+class BasicARAClient : public AbstractARAClient {
+
+public:
+    /**
+     * If this constructor is used, BasicARAClient::initialize must be called manually
+     * (@see AbstractARAClient::AbstractARAClient()).
+     */
+    BasicARAClient() {}
+
+    BasicARAClient(Configuration& configuration) {
+        initialize(configuration);
+    }
+
+    /**
+     * Initializes the client like AbstractARAClient::initialize and checks that the objects of
+     * the given configuration are of the types of this client.
+     */
+    void initialize(Configuration& configuration) {
+        AbstractARAClient::initialize(configuration);
+        typedRoutingTable = getAs<RoutingTableT>(routingTable, "The routing table does not match the type of the BasicARAClient");
+        typedForwardingPolicy = getAs<ForwardingPolicyT>(forwardingPolicy, "The forwarding policy does not match the type of the BasicARAClient");
+        typedReinforcementPolicy = getAs<PathReinforcementPolicyT>(pathReinforcementPolicy, "The path reinforcement policy does not match the type of the BasicARAClient");
+        typedEvaporationPolicy = getAs<EvaporationPolicyT>(evaporationPolicy, "The evaporation policy does not match the type of the BasicARAClient");
+    }
+
+    /**
+     * Forwards deliverable packets over the statically bound routing table and policies. All other
+     * packets are handled by AbstractARAClient::sendPacket.
+     */
+    void sendPacket(Packet* packet) {
+        typedRoutingTable->RoutingTableT::triggerEvaporation();
+
+        const AddressPtr& destination = packet->getDestination();
+        if (packet->getTTL() > 0 && isRouteDiscoveryRunning(destination) == false && typedRoutingTable->RoutingTableT::isDeliverable(packet)) {
+            NextHop* nextHop = getNextHop(packet);
+            NetworkInterface* interface = nextHop->getInterface();
+            AddressPtr nextHopAddress = nextHop->getAddress();
+            float newPheromoneValue = BasicARAClient::reinforcePheromoneValue(destination, nextHopAddress, interface);
+            forwardDataPacket(packet, nextHopAddress, interface, newPheromoneValue);
+        }
+        else {
+            AbstractARAClient::sendPacket(packet);
+        }
+    }
+
+    /**
+     * Sets the new forwarding policy, which must be of the forwarding policy type of this client.
+     */
+    void setForwardingPolicy(ForwardingPolicy* newForwardingPolicy) {
+        ForwardingPolicyT* newTypedForwardingPolicy = getAs<ForwardingPolicyT>(newForwardingPolicy, "The forwarding policy does not match the type of the BasicARAClient");
+        AbstractARAClient::setForwardingPolicy(newForwardingPolicy);
+        typedForwardingPolicy = newTypedForwardingPolicy;
+    }
+
+protected:
+    NextHop* getNextHop(const Packet* packet) {
+        if (flowCache != nullptr) {
+            NextHop* nextHop = flowCache->getNextHop(packet, routingTable);
+            if (nextHop != nullptr) {
+                return nextHop;
+            }
+        }
+        return typedForwardingPolicy->ForwardingPolicyT::getNextHop(packet);
+    }
+
+    float reinforcePheromoneValue(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface) {
+        RouteHandle route = typedRoutingTable->RoutingTableT::findRoute(destination, nextHop, interface);
+        return BasicARAClient::reinforcePheromoneValue(route);
+    }
+
+    float reinforcePheromoneValue(RouteHandle& route) {
+        float newPheromoneValue = typedReinforcementPolicy->PathReinforcementPolicyT::calculateReinforcedValue(route.getPheromoneValue());
+        route.setPheromoneValue(newPheromoneValue);
+        return newPheromoneValue;
+    }
+
+private:
+    template<class T, class BaseType>
+    static T* getAs(BaseType* object, const char* errorMessage) {
+        if (object == nullptr || typeid(*object) != typeid(T)) {
+            throw Exception(errorMessage);
+        }
+        return dynamic_cast<T*>(object);
+    }
+
+protected:
+    RoutingTableT* typedRoutingTable = nullptr;
+    ForwardingPolicyT* typedForwardingPolicy = nullptr;
+    PathReinforcementPolicyT* typedReinforcementPolicy = nullptr;
+    EvaporationPolicyT* typedEvaporationPolicy = nullptr;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -43,6 +43,14 @@ public:
     virtual unsigned int getMaxNeighborInactivityTimeInMilliSeconds();
     virtual unsigned int getPANTIntervalInMilliSeconds();
     virtual bool isPreviousHopFeatureActivated();
+    virtual bool isLazyEvaporationActivated();
+    virtual unsigned int getMaxNrOfBucketsPerEvaporation();
+    virtual unsigned int getMaxNrOfRoutingTableEntries();
+    virtual bool isPheromoneAwareEvictionActivated();
+    virtual unsigned int getRandomNumberGeneratorSeed();
+    virtual unsigned int getRandomNumberGeneratorStream();
+    virtual unsigned int getFlowCacheDwellTimeInMilliSeconds();
+    virtual float getFlowCachePheromoneShiftThreshold();
 
     void setMaximumHopCount(int maxTTL);
     void setNeighborActivityCheckInterval(unsigned int newIntervalInMilliSeconds);
@@ -50,6 +58,16 @@ public:
     void setPANTInterval(unsigned int newIntervalInMilliSeconds);
     void activatePreviousHopFeature();
     void deactivatePreviousHopFeature();
+    void activateLazyEvaporation();
+    void deactivateLazyEvaporation();
+    void setMaxNrOfBucketsPerEvaporation(unsigned int maxNrOfBuckets);
+    void setMaxNrOfRoutingTableEntries(unsigned int maxNrOfEntries);
+    void activatePheromoneAwareEviction();
+    void deactivatePheromoneAwareEviction();
+    void setRandomNumberGeneratorSeed(unsigned int seed);
+    void setRandomNumberGeneratorStream(unsigned int stream);
+    void setFlowCacheDwellTime(unsigned int dwellTimeInMilliSeconds);
+    void setFlowCachePheromoneShiftThreshold(float threshold);
 
 protected:
     RoutingTable* routingTable;
@@ -65,6 +83,14 @@ protected:
     unsigned int maxNeighborInactivityTimeInMilliSeconds;
     unsigned int pantIntervalInMilliSeconds;
     bool previousHopFeatureIsActivated;
+    bool lazyEvaporationIsActivated;
+    unsigned int maxNrOfBucketsPerEvaporation;
+    unsigned int maxNrOfRoutingTableEntries;
+    bool pheromoneAwareEvictionIsActivated;
+    unsigned int randomNumberGeneratorSeed;
+    unsigned int randomNumberGeneratorStream;
+    unsigned int flowCacheDwellTimeInMilliSeconds;
+    float flowCachePheromoneShiftThreshold;
 };
 
 } /* namespace ARA */
@@ -0,0 +1,205 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef CONCURRENT_ROUTINGTABLE_H_
+#define CONCURRENT_ROUTINGTABLE_H_
+
+#include "ARAMacros.h"
+#include "RoutingTable.h"
+#include "RoutingTableEntry.h"
+#include "EpochManager.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The ConcurrentRoutingTable can be shared between the thread that processes the packets and
+ * the timer threads of the ~StandardClock.
+ *
+ * All methods which are used to make forwarding decisions (RoutingTable::getNextHopCandidates,
+ * RoutingTable::isDeliverable, RoutingTable::getPheromoneValue, RoutingTable::exists and the
+ * lookup of RoutingTable::findRoute) never take a lock. The routes of each destination are
+ * stored in an array which is published via an atomic pointer (read-copy-update). All
+ * modifications are serialized by a single mutex. The pheromone values and timestamps of
+ * existing routes are updated (and evaporated) in place, because they are atomic (see
+ * ~RoutingTableEntry). Only if a route is added or removed, the writer copies the routes of
+ * the destination, modifies the copy and publishes it. The old array is handed over to an
+ * ~EpochManager which deletes it as soon as no reader can see it anymore.
+ *
+ * The destinations are kept in an open addressing hash table (the directory) whose slots are
+ * atomic pointers. New destinations are inserted in place. The directory itself is only copied
+ * and published again if it needs to grow. Destinations without any routes are kept in the
+ * directory until it is rebuilt the next time.
+ *
+ * The views and handles returned by RoutingTable::getNextHopCandidates and RoutingTable::findRoute
+ * keep their entries alive (see ~EpochGuard). All other ~RoutingTableEntry pointers which are
+ * returned by this table (via RoutingTable::getPossibleNextHops, RoutingTable::getEntryAt,
+ * RoutingTable::forEachEntry, the iterator or RoutingTable::getAllRoutesThatLeadOver) are only
+ * valid until the table is modified the next time, just like in the standard ~RoutingTable.
+ *
+ * Lookups never modify this table, so the lazy evaporation can not be applied on lookup.
+ * If it is activated anyway, only its background pass is applied. This table can not be used
+ * with EARA, because entries are stored by value.
+ */
+class ConcurrentRoutingTable : public RoutingTable {
+    public:
+        ConcurrentRoutingTable();
+        virtual ~ConcurrentRoutingTable();
+
+        float getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * Copies the given entry into this table. The entry object itself is deleted
+         * afterwards because this table stores all entries by value.
+         */
+        void update(AddressPtr destination, RoutingTableEntry* entry);
+        void update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+        RouteHandle findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * The route is looked up again while holding the lock, because another thread may have
+         * modified the routes of the destination since the handle has been created.
+         */
+        void update(RouteHandle& route, float pheromoneValue);
+
+        bool removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+        RoutingTableEntryList getPossibleNextHops(const Packet* packet);
+        RoutingTableEntryList getPossibleNextHops(AddressPtr destination);
+        NextHopCandidates getNextHopCandidates(const Packet* packet);
+        bool isDeliverable(const Packet* packet);
+        bool isDeliverable(AddressPtr destination);
+        bool exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+        unsigned int getTotalNumberOfEntries() const;
+        std::deque<RoutingTableEntryTupel> getAllRoutesThatLeadOver(AddressPtr nextHop) const;
+        void forEachEntry(const RoutingTableVisitor& visitor) const;
+        void triggerEvaporation();
+
+    protected:
+        void evaporateEntries(long timeDifference);
+
+        /**
+         * The buckets of this table are the slots of its directory.
+         */
+        void evaporateBuckets(unsigned int nrOfBuckets);
+        RoutingTableEntryTupel findEntryAt(int wantedPosition) const;
+        bool moveToFirstEntry(IteratorPosition& position) const;
+        bool moveToNextEntry(IteratorPosition& position) const;
+        RoutingTableEntryTupel getEntryAtPosition(const IteratorPosition& position) const;
+        RoutingTableEntry* findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface);
+        void removeEvictedRoute(const RouteEviction::Route& route);
+
+    private:
+        /**
+         * The routes of a destination. No route is added to or removed from an array after it
+         * has been published, only the pheromone values and timestamps of its routes change.
+         */
+        typedef std::vector<RoutingTableEntry> RouteArray;
+
+        struct Destination {
+            Destination(AddressPtr address) : address(address), routes(nullptr) {}
+
+            const AddressPtr address;
+
+            /**
+             * The currently published routes or nullptr if there are no routes to this destination.
+             */
+            std::atomic<RouteArray*> routes;
+        };
+
+        struct Directory {
+            Directory(size_t capacity);
+            ~Directory();
+
+            size_t capacity;
+            size_t mask;
+            std::atomic<Destination*>* slots;
+        };
+
+        ConcurrentRoutingTable(const ConcurrentRoutingTable& other) = delete;
+        ConcurrentRoutingTable& operator=(const ConcurrentRoutingTable& other) = delete;
+
+        size_t hashOf(const AddressPtr& destination) const;
+        Destination* findDestination(const AddressPtr& destination) const;
+
+        /**
+         * Returns the published routes to the given destination or nullptr if there are none.
+         * The caller must be inside an epoch of the ConcurrentRoutingTable::epochManager or hold the lock.
+         */
+        RouteArray* findRoutes(const AddressPtr& destination) const;
+
+        /**
+         * Returns the routes of the destination at the given slot of the current directory
+         * or nullptr if the slot is empty or the destination has no routes.
+         */
+        RouteArray* getRoutesAt(size_t slot) const;
+
+        // all following methods must only be called while holding the lock
+        Destination* findOrCreateDestination(AddressPtr destination);
+        void rebuildDirectory();
+
+        /**
+         * Returns a modifiable copy of the currently published routes of the given destination
+         * with room for one more route.
+         */
+        RouteArray* copyRoutes(Destination* destination) const;
+
+        /**
+         * Publishes the given routes for the destination and retires the old ones.
+         * An empty array is not published but deleted immediately.
+         */
+        void publish(Destination* destination, RouteArray* routes);
+
+        /**
+         * Sets the pheromone value of the route and creates it if necessary. The evicted routes
+         * must be taken from the RoutingTable::eviction before the lock is released.
+         * @return the entry of the route in the currently published routes
+         */
+        RoutingTableEntry* updateRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+        void updateInPlace(RoutingTableEntry* entry, float pheromoneValue);
+        bool removeRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * Returns true if the entry belongs to the currently published routes of the destination.
+         */
+        bool isPublished(Destination* destination, RoutingTableEntry* entry) const;
+
+        /**
+         * Removes the route at the given position from the result of an evaporation pass.
+         * The remaining routes are only copied when the first route is removed.
+         * @return the routes which remain so far
+         */
+        RouteArray* removeEvaporatedRoute(Destination* destination, RouteArray* routes, unsigned int position, RouteArray* remainingRoutes);
+
+        /**
+         * Evaporates the routes of the given destination by the time that has passed since the
+         * timestamp of each route and publishes the result if any route has been changed.
+         */
+        void evaporateDestination(Destination* destination);
+
+        static unsigned int find(RouteArray* routes, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * The minimal number of slots of the directory.
+         */
+        static const size_t MIN_CAPACITY = 16;
+
+        std::atomic<Directory*> directory;
+
+        /**
+         * The number of used slots in the current directory (including destinations without routes).
+         * This is only accessed while holding the lock.
+         */
+        size_t nrOfUsedSlots;
+        std::atomic<unsigned int> nrOfEntries;
+
+        mutable std::mutex lock;
+        mutable EpochManager epochManager;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* CONCURRENT_ROUTINGTABLE_H_ */
@@ -35,6 +35,14 @@ public:
     virtual unsigned int getMaxNeighborInactivityTimeInMilliSeconds() = 0;
     virtual unsigned int getPANTIntervalInMilliSeconds() = 0;
     virtual bool isPreviousHopFeatureActivated() = 0;
+    virtual bool isLazyEvaporationActivated() = 0;
+    virtual unsigned int getMaxNrOfBucketsPerEvaporation() = 0;
+    virtual unsigned int getMaxNrOfRoutingTableEntries() = 0;
+    virtual bool isPheromoneAwareEvictionActivated() = 0;
+    virtual unsigned int getRandomNumberGeneratorSeed() = 0;
+    virtual unsigned int getRandomNumberGeneratorStream() = 0;
+    virtual unsigned int getFlowCacheDwellTimeInMilliSeconds() = 0;
+    virtual float getFlowCachePheromoneShiftThreshold() = 0;
 };
 
 ARA_NAMESPACE_END
@@ -43,9 +43,16 @@ class CubicEvaporationPolicy {
         void checkExponent(unsigned int exponent);
 
     private:
+        float getAmountOfEvaporation(float milliSecondsSinceLastTraffic) const;
+
         unsigned int alpha;
         float plateauCenterDepth;
         unsigned int exponent;
+
+        /**
+         * This is alpha^exponent which is updated whenever alpha or the exponent changes.
+         */
+        float potentiatedAlpha;
 };
 
 ARA_NAMESPACE_END
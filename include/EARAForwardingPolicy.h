@@ -17,7 +17,7 @@ ARA_NAMESPACE_BEGIN
  * This purely virtual interface is used by the AbstractEARAClient to determine
  * the next hop for a given packet and calculate the initial energy fitness with the given weights.
  */
-class EARAForwardingPolicy : public ForwardingPolicy {
+class EARAForwardingPolicy : public virtual ForwardingPolicy {
     public:
         virtual float getPheromoneWeight() = 0;
         virtual float getEnergyWeight() = 0;
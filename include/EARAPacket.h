@@ -16,6 +16,7 @@ ARA_NAMESPACE_BEGIN
 class EARAPacket : public Packet {
     public:
         EARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0);
+        EARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload);
         unsigned int getTotalEnergyValue() const;
         unsigned int getMinimumEnergyValue() const;
 
@@ -25,11 +25,12 @@ class EARAPacketFactory : public PacketFactory {
         virtual EARAPacket* makeClone(const Packet* originalPacket);
 
     protected:
+        virtual std::size_t getPacketSize() const;
 
         /**
           * This will always create EARAPacket instances
           */
-         virtual EARAPacket* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0, AddressPtr previousHop=nullptr);
+         virtual EARAPacket* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload=PayloadBuffer(), AddressPtr previousHop=nullptr);
 
 };
 
@@ -8,6 +8,7 @@
 #include "ARAMacros.h"
 #include "RoutingTable.h"
 #include "EARARoutingTableEntry.h"
+#include "WeightedFitness.h"
 
 ARA_NAMESPACE_BEGIN
 
@@ -16,12 +17,36 @@ struct EARARoutingTableEntryTupel {
     EARARoutingTableEntry* entry;
 };
 
+/**
+ * The visitor that is called by EnergyAwareRoutingTable::forEachEntry for each route in the table.
+ */
+typedef std::function<void (const AddressPtr& destination, EARARoutingTableEntry* entry)> EARARoutingTableVisitor;
+
 class EnergyAwareRoutingTable : public RoutingTable {
     public:
+        EnergyAwareRoutingTable();
+
+        /**
+         * Iterates over all routes of the table just like the RoutingTable::const_iterator
+         * but returns the ~EARARoutingTableEntry objects.
+         */
+        class const_iterator : public RoutingTable::const_iterator {
+            public:
+                const_iterator(const RoutingTable::const_iterator& iterator) : RoutingTable::const_iterator(iterator) {}
+
+                EARARoutingTableEntryTupel operator*() const;
+                const_iterator& operator++();
+        };
+
         virtual void update(AddressPtr destination, RoutingTableEntry* entry) {RoutingTable::update(destination, entry);};
         virtual void update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
         virtual void update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue, float normalizedEnergyValue);
 
+        /**
+         * Updates the pheromone value of an existing route. New routes can only be created if an energy value is supplied.
+         */
+        virtual void update(RouteHandle& route, float pheromoneValue);
+
         /**
          * Updates only the energy value of a given hop but not the pheromone value.
          * If the route does not yet exist this method will do nothing.
@@ -40,9 +65,42 @@ class EnergyAwareRoutingTable : public RoutingTable {
          */
         EARARoutingTableEntryTupel getEntryAt(int wantedPosition) const;
 
+        /**
+         * Calls the given visitor for each route in this table. The visitor must not modify the table.
+         */
+        void forEachEntry(const EARARoutingTableVisitor& visitor) const;
+
+        const_iterator begin() const;
+        const_iterator end() const;
+
+        /**
+         * Lets NextHopCandidates::sample choose the routes by their weighted fitness instead of
+         * their pheromone value. The cumulative fitness of the routes of each destination is cached
+         * and only calculated again after a pheromone or energy value of the destination has changed.
+         */
+        void activateFitnessWeighting(const WeightedFitness& fitness);
+        void deactivateFitnessWeighting();
+
+        bool isFitnessWeightingActivated() const;
+
+        /**
+         * Returns true if the fitness weighting is activated with the given weights.
+         */
+        bool isFitnessWeightingActivated(const WeightedFitness& fitness) const;
+
+        /**
+         * Returns the weighted fitness of the route if the fitness weighting is activated
+         * and its pheromone value otherwise.
+         */
+        virtual float getSelectionWeight(RoutingTableEntry* entry) const;
+
     protected:
         void updateExistingEntry(RoutingTableEntry* oldEntry, RoutingTableEntry* newEntry);
         EARARoutingTableEntry* getRoutingTableEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+    private:
+        bool fitnessWeightingIsActivated;
+        WeightedFitness fitness;
 };
 
 ARA_NAMESPACE_END
@@ -11,6 +11,7 @@
 #include "EnergyAwareRoutingTable.h"
 #include "NextHop.h"
 #include "Packet.h"
+#include "WeightedFitness.h"
 
 #include <vector>
 
@@ -18,6 +19,10 @@ ARA_NAMESPACE_BEGIN
 
 /**
  * The class provides the forwarding policy for the energy aware ant routing (EARA).
+ *
+ * If the fitness weighting of the ~EnergyAwareRoutingTable is activated with the weights of
+ * this policy, the next hop is sampled from the cumulative fitness that is cached by the table.
+ * Otherwise the weighted fitness of each candidate is calculated for each packet.
  */
 class EnergyAwareStochasticForwardingPolicy : public StochasticForwardingPolicy, public virtual EARAForwardingPolicy {
     public:
@@ -32,16 +37,21 @@ class EnergyAwareStochasticForwardingPolicy : public StochasticForwardingPolicy,
         void setEnergyWeight(float beta);
 
     private:
-        int getRandomNodeIndex(std::vector<float> cumulativeSum);
+        /**
+         * Returns pheromoneValue^pheromoneWeight * energyValue^energyWeight of the given route.
+         */
+        float getWeightedProduct(RoutingTableEntry* possibleNextHop);
+
+        /**
+         * Passes the changed weights on to the routing table if it caches the fitness of the routes.
+         */
+        void updateFitnessWeighting();
 
     protected:
         EnergyAwareRoutingTable* routingTable;
 
-        /** the weight of the pheromone variable in the transmission probability **/
-        float pheromoneWeight;
-
-        /** the weight of the energy variable in the transmission probability **/
-        float energyWeight;
+        /** the weights of the pheromone and energy variable in the transmission probability **/
+        WeightedFitness fitness;
 };
 
 ARA_NAMESPACE_END
@@ -0,0 +1,46 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef EPOCH_GUARD_H_
+#define EPOCH_GUARD_H_
+
+#include "ARAMacros.h"
+#include "EpochManager.h"
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * An EpochGuard keeps a reader inside the current epoch of an ~EpochManager for as long as it
+ * exists, so none of the objects the reader has loaded in the meantime are deleted.
+ * A copy of a guard stays in the same epoch as the original.
+ *
+ * A default constructed guard does not protect anything. It is used by all data structures
+ * that are not shared between threads.
+ */
+class EpochGuard {
+    public:
+        EpochGuard();
+        explicit EpochGuard(EpochManager* epochManager);
+        EpochGuard(const EpochGuard& other);
+        EpochGuard(EpochGuard&& other);
+        ~EpochGuard();
+
+        EpochGuard& operator=(const EpochGuard& other);
+        EpochGuard& operator=(EpochGuard&& other);
+
+        /**
+         * Returns true if this guard holds an epoch of some ~EpochManager.
+         */
+        bool isActive() const;
+
+    private:
+        void release();
+
+        EpochManager* epochManager;
+        unsigned long epoch;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* EPOCH_GUARD_H_ */
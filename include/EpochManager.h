@@ -0,0 +1,109 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef EPOCH_MANAGER_H_
+#define EPOCH_MANAGER_H_
+
+#include "ARAMacros.h"
+
+#include <atomic>
+#include <vector>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The EpochManager implements a simple epoch based memory reclamation. It allows readers to
+ * access objects that are shared between threads without taking any lock, while a writer
+ * replaces these objects and hands the old ones over to EpochManager::retire.
+ *
+ * Each reader enters the current epoch (see ~EpochGuard) before it loads a shared pointer and
+ * leaves the epoch after it is done with the object. The epoch can only be advanced if no reader
+ * is left in the previous epoch. Thus, an object which has been retired in epoch e can not be
+ * seen by any reader anymore as soon as the epoch has been advanced to e+2.
+ *
+ * EpochManager::retire and EpochManager::reclaim must only be called by one thread at a time
+ * (usually while holding the lock of the writers), all other methods can be called concurrently.
+ */
+class EpochManager {
+    public:
+        EpochManager();
+
+        /**
+         * Deletes all retired objects. There must be no reader left at this point.
+         */
+        ~EpochManager();
+
+        /**
+         * Enters the current epoch and returns it. This never blocks but may need to retry
+         * if the epoch is advanced at the same time.
+         */
+        unsigned long enter();
+
+        /**
+         * Enters the given epoch again. This must only be called by a reader that has
+         * already entered the given epoch and has not left it yet.
+         */
+        void join(unsigned long epoch);
+
+        /**
+         * Leaves the given epoch which has been returned by EpochManager::enter.
+         */
+        void leave(unsigned long epoch);
+
+        /**
+         * Hands over an object which is no longer reachable for new readers.
+         * The object is deleted as soon as no reader can access it anymore.
+         */
+        template<class T> void retire(T* object) {
+            retire(object, &deleteObject<T>);
+        }
+
+        void retire(void* object, void (*deleter)(void*));
+
+        /**
+         * Advances the epoch if no reader is left in the previous epoch and deletes all
+         * objects that have been retired before the previous epoch.
+         * @return false if the epoch could not be advanced because some reader is still active
+         */
+        bool reclaim();
+
+        unsigned long getCurrentEpoch() const;
+
+        /**
+         * Returns the number of retired objects which have not been deleted yet.
+         */
+        unsigned int getNrOfRetiredObjects() const;
+
+    private:
+        struct RetiredObject {
+            void* object;
+            void (*deleter)(void*);
+        };
+
+        template<class T> static void deleteObject(void* object) {
+            delete static_cast<T*>(object);
+        }
+
+        EpochManager(const EpochManager& other) = delete;
+        EpochManager& operator=(const EpochManager& other) = delete;
+
+        void deleteRetiredObjects(std::vector<RetiredObject>& objects);
+
+        std::atomic<unsigned long> epoch;
+
+        /**
+         * The number of active readers in all even and all odd epochs. Two counters suffice
+         * because there can never be readers in more than two adjacent epochs at once.
+         */
+        std::atomic<unsigned int> nrOfReaders[2];
+
+        /**
+         * The objects that have been retired in the last even and the last odd epoch.
+         */
+        std::vector<RetiredObject> retiredObjects[2];
+};
+
+ARA_NAMESPACE_END
+
+#endif /* EPOCH_MANAGER_H_ */
@@ -0,0 +1,64 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef EVAPORATION_KERNELS_H_
+#define EVAPORATION_KERNELS_H_
+
+#include "ARAMacros.h"
+
+#include <cstddef>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The EvaporationKernels apply the same evaporation step to a whole array of pheromone values.
+ * They are used by the batch evaporation of the evaporation policies (see EvaporationPolicy::evaporate).
+ *
+ * Each kernel is available as SSE, AVX2 and scalar implementation. The best implementation
+ * that is supported by the CPU is selected at runtime. All implementations lead to the same results.
+ */
+class EvaporationKernels {
+    public:
+        enum InstructionSet {
+            SCALAR,
+            SSE,
+            AVX2
+        };
+
+        /**
+         * Multiplies all values with the given factor and sets each value that drops below
+         * the threshold to zero.
+         */
+        static void multiply(float* values, size_t nrOfValues, float factor, float threshold);
+
+        /**
+         * Subtracts the given amount from all values and sets each value that drops below
+         * the threshold to zero.
+         */
+        static void subtract(float* values, size_t nrOfValues, float amount, float threshold);
+
+        /**
+         * Returns the instruction set that is used by the kernels.
+         */
+        static InstructionSet getInstructionSet();
+
+        /**
+         * Returns the best instruction set that is supported by this CPU.
+         */
+        static InstructionSet getSupportedInstructionSet();
+
+        /**
+         * Restricts the kernels to the given instruction set. This is only meant to be used by tests
+         * and benchmarks. If the instruction set is not supported by the CPU, the best supported
+         * one is used instead.
+         */
+        static void setInstructionSet(InstructionSet instructionSet);
+
+    private:
+        static InstructionSet instructionSet;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -27,10 +27,33 @@ namespace ARA {
              */
             virtual float evaporate(float oldPheromoneValue, int milliSecondsSinceLastEvaporation) = 0;
 
+            /**
+             * Evaporates all given pheromone values in place by the same amount of time.
+             * This is used by the routing tables to evaporate all routes at once. Subclasses should
+             * compute everything that only depends on the time once per call and use the
+             * vectorized EvaporationKernels. The default implementation simply calls the scalar
+             * evaporate method for each value.
+             */
+            virtual void evaporate(float* pheromoneValues, size_t nrOfValues, int milliSecondsSinceLastEvaporation) {
+                for (size_t i = 0; i < nrOfValues; i++) {
+                    pheromoneValues[i] = evaporate(pheromoneValues[i], milliSecondsSinceLastEvaporation);
+                }
+            }
+
             virtual bool isEvaporationNecessary(unsigned int timeDifferenceInMillis) {
                 return timeDifferenceInMillis >= minimumTimeDifferenceBeforeEvaporation;
             }
 
+            /**
+             * Returns true if the pheromone value can be evaporated in several steps
+             * with the same result as in a single step over the whole time, that is
+             * evaporate(evaporate(x, a), b) equals evaporate(x, a+b). Only such policies
+             * can be used for the lazy evaporation of the ~RoutingTable.
+             */
+            virtual bool isLazyEvaluationSupported() const {
+                return false;
+            }
+
             unsigned int getTimeInterval() const {
                 return timeInterval;
             }
@@ -29,6 +29,8 @@ class ExponentialEvaporationPolicy : public EvaporationPolicy {
         ExponentialEvaporationPolicy(float evaporationFactor, unsigned int timeIntervalMillis, float threshold);
 
         float evaporate(float oldPheromoneValue, int millisecondsSinceLastEvaporation);
+        void evaporate(float* pheromoneValues, size_t nrOfValues, int millisecondsSinceLastEvaporation);
+        bool isLazyEvaluationSupported() const;
 
     protected:
         float threshold;
@@ -0,0 +1,198 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef FLAT_ROUTINGTABLE_H_
+#define FLAT_ROUTINGTABLE_H_
+
+#include "ARAMacros.h"
+#include "RoutingTable.h"
+#include "RoutingTableEntry.h"
+
+#include <vector>
+#include <type_traits>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The FlatRoutingTable is a cache friendly alternative to the standard ~RoutingTable.
+ *
+ * All destinations are kept in a single open addressing hash table (with linear probing).
+ * The hash values of all slots are stored in their own contiguous array so a lookup
+ * only touches the slots whose hash value matches. The routes of each destination are
+ * stored in place as small inline arrays of ~RoutingTableEntry objects. Only destinations
+ * with more than FlatRoutingTable::INLINE_ROUTES routes spill their routes to the heap.
+ *
+ * Please note that all RoutingTableEntry pointers which are returned by this table
+ * are only valid until the table is modified the next time (update, removeEntry or
+ * evaporation). A ~RouteHandle notices this and looks its route up again. This table
+ * can not be used with EARA, because entries are stored by value and the
+ * EARARoutingTableEntry objects would lose their energy values.
+ */
+class FlatRoutingTable : public RoutingTable {
+    public:
+        /**
+         * The number of routes per destination that are stored inline without any heap allocation.
+         */
+        static const unsigned int INLINE_ROUTES = 4;
+
+        FlatRoutingTable();
+        virtual ~FlatRoutingTable();
+
+        float getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * Copies the given entry into this table. The entry object itself is deleted
+         * afterwards because this table stores all entries by value.
+         */
+        void update(AddressPtr destination, RoutingTableEntry* entry);
+        void update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+        RouteHandle findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+        void update(RouteHandle& route, float pheromoneValue);
+
+        bool removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+        RoutingTableEntryList getPossibleNextHops(const Packet* packet);
+        RoutingTableEntryList getPossibleNextHops(AddressPtr destination);
+        NextHopCandidates getNextHopCandidates(const Packet* packet);
+        bool isDeliverable(const Packet* packet);
+        bool isDeliverable(AddressPtr destination);
+        bool exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+        unsigned int getTotalNumberOfEntries() const;
+        std::deque<RoutingTableEntryTupel> getAllRoutesThatLeadOver(AddressPtr nextHop) const;
+        void forEachEntry(const RoutingTableVisitor& visitor) const;
+
+    protected:
+        void evaporateEntries(long timeDifference);
+
+        /**
+         * The buckets of this table are its slots.
+         */
+        void evaporateBuckets(unsigned int nrOfBuckets);
+        RoutingTableEntryTupel findEntryAt(int wantedPosition) const;
+        bool moveToFirstEntry(IteratorPosition& position) const;
+        bool moveToNextEntry(IteratorPosition& position) const;
+        RoutingTableEntryTupel getEntryAtPosition(const IteratorPosition& position) const;
+        RoutingTableEntry* findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface);
+        void removeEvictedRoute(const RouteEviction::Route& route);
+
+        /**
+         * Returns the slot at which the probe sequence of the given destination starts
+         * with the current capacity of this table.
+         */
+        size_t getHomeSlot(const AddressPtr& destination) const;
+
+    private:
+        /**
+         * A small vector of RoutingTableEntry objects that stores up to INLINE_ROUTES
+         * entries inside the object itself and moves all of them to the heap
+         * if more entries are added. The entries are always stored contiguously.
+         */
+        class RouteList {
+            public:
+                RouteList();
+                RouteList(RouteList&& other);
+                RouteList& operator=(RouteList&& other);
+                ~RouteList();
+
+                unsigned int size() const { return nrOfEntries; }
+                bool empty() const { return nrOfEntries == 0; }
+                RoutingTableEntry* at(unsigned int position) const { return entries + position; }
+
+                RoutingTableEntry* add(AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+                void erase(unsigned int position);
+                void clear();
+
+                /**
+                 * Returns the position of the entry with the given next hop and interface
+                 * or size() if there is no such entry.
+                 */
+                unsigned int find(AddressPtr nextHop, NetworkInterface* interface) const;
+
+            private:
+                RouteList(const RouteList& other) = delete;
+                RouteList& operator=(const RouteList& other) = delete;
+
+                bool isInline() const;
+                void moveEntriesFrom(RouteList& other);
+
+                typedef std::aligned_storage<sizeof(RoutingTableEntry), alignof(RoutingTableEntry)>::type EntryStorage;
+
+                RoutingTableEntry* entries;
+                unsigned int nrOfEntries;
+                unsigned int capacity;
+                EntryStorage inlineEntries[INLINE_ROUTES];
+        };
+
+        struct Slot {
+            AddressPtr destination;
+            RouteList routes;
+
+            /**
+             * The best entry of the aggregates points into the routes, so it has to be
+             * adjusted whenever the routes are moved (see FlatRoutingTable::moveSlot).
+             */
+            PheromoneAggregates aggregates;
+        };
+
+        static const size_t EMPTY_SLOT = 0;
+        static const size_t NOT_FOUND = (size_t) -1;
+
+        size_t hashOf(const AddressPtr& destination) const;
+        size_t findSlot(const AddressPtr& destination) const;
+
+        /**
+         * Works like findSlot but applies all pending evaporation to the routes of the
+         * destination first if the lazy evaporation is used.
+         */
+        size_t findEvaporatedSlot(const AddressPtr& destination);
+
+        /**
+         * Evaporates all routes in the given slot and deletes the ones whose pheromone
+         * value has dropped to zero. The slot itself is not removed.
+         * @return true if there are no routes left in the slot
+         */
+        bool evaporateSlot(size_t position);
+        size_t findOrCreateSlot(AddressPtr destination);
+
+        /**
+         * Works like the protected findStoredEntry but also returns the slot of the route.
+         */
+        RoutingTableEntry* findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface, Slot*& slot);
+
+        /**
+         * Timestamps the given entry whose pheromone value has just been changed and updates the aggregates of its slot.
+         */
+        void routeHasBeenUpdated(Slot& slot, RoutingTableEntry* entry, float oldPheromoneValue);
+        void recomputeAggregates(Slot& slot);
+
+        /**
+         * Adds a new route to the given slot and registers it in the indexes of this table.
+         */
+        RoutingTableEntry* addRoute(Slot& slot, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+
+        /**
+         * Makes room for a new route (see RoutingTable::makeRoomForNewEntry) and adds it to the slot of the destination.
+         */
+        RoutingTableEntry* addRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
+        void removeSlot(size_t position);
+
+        /**
+         * Moves the destination, the routes and the aggregates of the source slot into the empty target slot.
+         */
+        void moveSlot(Slot& target, Slot& source);
+        void grow();
+
+        /**
+         * The hash value of each slot or EMPTY_SLOT if the slot is not used.
+         * This is kept apart from the slots so probing stays within a few cache lines.
+         */
+        std::vector<size_t> hashes;
+        std::vector<Slot> slots;
+        size_t mask;
+        unsigned int nrOfDestinations;
+        unsigned int nrOfEntries;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* FLAT_ROUTINGTABLE_H_ */
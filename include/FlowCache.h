@@ -0,0 +1,105 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef FLOW_CACHE_H_
+#define FLOW_CACHE_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "NextHop.h"
+#include "NetworkInterface.h"
+#include "Packet.h"
+#include "RoutingTable.h"
+#include "Time.h"
+
+#include <unordered_map>
+#include <utility>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The FlowCache remembers the next hop that has been chosen for a flow of data packets, which is
+ * identified by the source and destination of the packets. Subsequent packets of the flow are sent
+ * to the same next hop, so they do not need a new forwarding decision and are not reordered.
+ *
+ * The next hop is chosen again by the ~ForwardingPolicy if the dwell time has passed since it has been
+ * chosen, if the route does no longer exist or leads back over the sender or source of the packet,
+ * or if its pheromone value has changed by more than the given fraction since the flow has last used
+ * the route (e.g. because it has evaporated or has been reinforced by other packets).
+ */
+class FlowCache {
+    public:
+        FlowCache(unsigned int dwellTimeInMilliSeconds, float maxPheromoneShift);
+        ~FlowCache();
+
+        /**
+         * Returns the cached next hop of the flow of the given packet or nullptr if the next hop needs
+         * to be chosen again. The returned object is only valid until the cache is modified.
+         */
+        NextHop* getNextHop(const Packet* packet, RoutingTable* routingTable);
+
+        /**
+         * Records that the given packet has been sent over the given route, which has the given
+         * pheromone value afterwards. If the flow has been using another route before or the cached
+         * route could not be used for this packet, this route is now cached as a new forwarding decision.
+         */
+        void routeHasBeenUsed(const Packet* packet, const AddressPtr& nextHop, NetworkInterface* interface, float pheromoneValue);
+
+        /**
+         * Returns the number of flows in this cache (including expired ones that have not yet been purged).
+         */
+        unsigned int size() const;
+
+    private:
+        /**
+         * The ids of the source and the destination in the AddressTable. Both ids are retained
+         * in the AddressTable while the flow is cached, so they are never replaced by new ones.
+         */
+        typedef std::pair<AddressId, AddressId> FlowId;
+
+        struct FlowIdHash {
+            size_t operator()(const FlowId& flow) const {
+                return ((size_t) flow.first * 0x9e3779b1u) ^ flow.second;
+            }
+        };
+
+        struct Flow {
+            NextHop nextHop;
+            float pheromoneValue;
+            Time* selectionTime;
+
+            /**
+             * True if the cached next hop has not been usable for the last packet, so the
+             * ~ForwardingPolicy has to make a new decision for the flow.
+             */
+            bool isDecisionPending;
+        };
+
+        typedef std::unordered_map<FlowId, Flow, FlowIdHash> FlowMap;
+
+        bool hasExpired(const Flow& flow) const;
+
+        /**
+         * Returns true if the given packet can be sent over the cached next hop of the flow.
+         */
+        bool isUsable(Flow& flow, const Packet* packet, RoutingTable* routingTable);
+
+        /**
+         * Deletes all expired flows. This is done whenever the number of flows has doubled since the
+         * last purge, so the cache does not grow with flows that have ended.
+         */
+        void purgeExpiredFlows();
+
+        void releaseFlowId(const FlowId& flowId);
+
+        unsigned int dwellTimeInMilliSeconds;
+        float maxPheromoneShift;
+        unsigned int nextPurgeSize;
+        FlowMap flows;
+        Time* currentTime;
+};
+
+ARA_NAMESPACE_END
+
+#endif
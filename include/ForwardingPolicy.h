@@ -9,6 +9,8 @@
 #include "NextHop.h"
 #include "Packet.h"
 
+#include <cstdint>
+
 ARA_NAMESPACE_BEGIN
 
 /**
@@ -24,6 +26,13 @@ class ForwardingPolicy {
          * policy.
          */
         virtual NextHop* getNextHop(const Packet* packet) = 0;
+
+        /**
+         * Seeds the random number generator of a stochastic forwarding policy. The same seed
+         * and stream always lead to the same forwarding decisions. Deterministic forwarding
+         * policies ignore this.
+         */
+        virtual void initializeRandomNumberGenerator(uint64_t seed, uint64_t stream=0) {};
 };
 
 ARA_NAMESPACE_END
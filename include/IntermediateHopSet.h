@@ -0,0 +1,91 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef INTERMEDIATE_HOP_SET_H_
+#define INTERMEDIATE_HOP_SET_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+
+#include <cstdint>
+#include <vector>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The IntermediateHopSet remembers the ids of the hops that have been seen on the paths from a
+ * single source during the current route discovery. The first IntermediateHopSet::INLINE_CAPACITY
+ * hops are stored in a small array and all further hops are only looked up in a Bloom filter.
+ * Once the set has spilled to the Bloom filter, contains() may return true for hops which have
+ * never been inserted. For the loop detection of the ~AbstractARAClient this only means that a
+ * route is not created, which is the conservative choice.
+ *
+ * The set holds the addresses of all inserted hops, so their ids stay valid in the AddressTable
+ * until the set is cleared. The spilled addresses are kept in a vector which keeps its memory
+ * over clear(), so only the first spill of a set allocates. The Bloom filter itself is only wiped
+ * when the set spills over again.
+ */
+class IntermediateHopSet {
+    public:
+        /**
+         * The number of hops which are stored exactly.
+         */
+        static const unsigned int INLINE_CAPACITY = 8;
+
+        /**
+         * The number of bits of the Bloom filter (must be a multiple of 64 and at most 256).
+         */
+        static const unsigned int BLOOM_FILTER_SIZE = 256;
+
+        IntermediateHopSet();
+
+        /**
+         * Returns true if the given hop has been inserted since the set has been cleared the last
+         * time (or if the Bloom filter reports a false positive).
+         */
+        bool contains(AddressId hop) const;
+
+        void insert(const AddressPtr& hop);
+
+        /**
+         * Forgets all hops and drops their addresses.
+         */
+        void clear();
+
+        bool isEmpty() const;
+
+    private:
+        bool containsInline(AddressId hop) const;
+
+        /**
+         * Checks the addresses of the spilled hops, which is only done if the Bloom filter
+         * reports a hop that is inserted again (so each address is only kept once).
+         */
+        bool containsSpilled(AddressId hop) const;
+        bool bloomFilterContains(AddressId hop) const;
+        void addToBloomFilter(AddressId hop);
+
+        /**
+         * Returns the hash of the hop from which both Bloom filter positions are taken.
+         */
+        static uint64_t hash(AddressId hop);
+
+        static const unsigned int NR_OF_WORDS = BLOOM_FILTER_SIZE / 64;
+
+        AddressId hops[INLINE_CAPACITY];
+        AddressPtr hopAddresses[INLINE_CAPACITY];
+        std::vector<AddressPtr> spilledHops;
+        uint8_t nrOfHops;
+
+        /**
+         * True if more than INLINE_CAPACITY hops have been inserted since the last call to clear().
+         * The content of the Bloom filter is only meaningful if this is true.
+         */
+        bool hasSpilled;
+        uint64_t bloomFilter[NR_OF_WORDS];
+};
+
+ARA_NAMESPACE_END
+
+#endif /* INTERMEDIATE_HOP_SET_H_ */
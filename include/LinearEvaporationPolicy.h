@@ -26,6 +26,8 @@ namespace ARA {
             LinearEvaporationPolicy(float evaporationFactor, float threshold, unsigned int timeIntervalMillis = 1000);
 
             float evaporate(float oldPheromoneValue, int millisecondsSinceLastEvaporation);
+            void evaporate(float* pheromoneValues, size_t nrOfValues, int millisecondsSinceLastEvaporation);
+            bool isLazyEvaluationSupported() const;
 
         protected:
             float threshold;
@@ -11,7 +11,14 @@ namespace ARA {
     class LinearPathReinforcementPolicy : public PathReinforcementPolicy {
         public:
             LinearPathReinforcementPolicy(float deltaPhi);
-            float calculateReinforcedValue(float oldPheromoneValue);
+
+            /**
+             * This is defined inline so clients that know this policy at compile time
+             * (like the BasicARAClient) can inline the reinforcement.
+             */
+            float calculateReinforcedValue(float oldPheromoneValue) {
+                return oldPheromoneValue + deltaPhi;
+            }
 
             void setDeltaPhi(float deltaPhi);
         private:
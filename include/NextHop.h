@@ -15,7 +15,7 @@ class NextHop {
 public:
     NextHop(std::shared_ptr<Address> address, NetworkInterface* interface);
 
-    std::shared_ptr<Address> getAddress();
+    const std::shared_ptr<Address>& getAddress();
     NetworkInterface* getInterface();
 
 private:
@@ -0,0 +1,173 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef NEXT_HOP_CANDIDATES_H_
+#define NEXT_HOP_CANDIDATES_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "Packet.h"
+#include "RoutingTableEntry.h"
+#include "EpochGuard.h"
+
+#include <deque>
+#include <vector>
+
+ARA_NAMESPACE_BEGIN
+
+class RoutingTable;
+
+/**
+ * The aggregated pheromone values of all routes to one destination.
+ * These are kept up to date by the ~RoutingTable whenever a route is added,
+ * updated, removed or evaporated.
+ */
+struct PheromoneAggregates {
+    float sumOfPheromoneValues = 0;
+
+    /**
+     * The first route with the highest pheromone value or nullptr if there are no routes.
+     */
+    RoutingTableEntry* bestEntry = nullptr;
+
+    /**
+     * The running sums of the selection weights (see RoutingTable::getSelectionWeight) in the order of the routes.
+     * This is built lazily by NextHopCandidates::sample and cleared whenever the weights of the destination change.
+     * Clearing keeps the capacity so the distribution can be rebuilt without allocating memory.
+     */
+    mutable std::vector<float> cumulativeSelectionWeights;
+};
+
+/**
+ * A NextHopCandidates object is a read only view on the routes to the destination of a packet.
+ * It skips all routes that would lead the packet back over its source or sender (this would create
+ * a loop) without copying the routes of the ~RoutingTable into a new list.
+ *
+ * The view does not own any of the entries. It is only valid until the routing table is modified
+ * the next time (update, removeEntry or evaporation), unless the table is shared between threads:
+ * The ~ConcurrentRoutingTable hands an ~EpochGuard to the view, which keeps the viewed entries
+ * alive for as long as the view (or any copy of it) exists. The view refers to the addresses of
+ * the packet as well, so the packet must not be changed or deleted while the view is used.
+ */
+class NextHopCandidates {
+    public:
+        class Iterator {
+            public:
+                RoutingTableEntry* operator*() const;
+                Iterator& operator++();
+                bool operator==(const Iterator& other) const;
+                bool operator!=(const Iterator& other) const;
+
+            private:
+                friend class NextHopCandidates;
+                Iterator(const NextHopCandidates* candidates, unsigned int position);
+
+                const NextHopCandidates* candidates;
+                unsigned int position;
+        };
+
+        /**
+         * Creates an empty view.
+         */
+        NextHopCandidates();
+
+        /**
+         * Creates a view on a list of pointers to the routes of the packet destination.
+         */
+        NextHopCandidates(const std::deque<RoutingTableEntry*>* entries, const Packet* packet);
+
+        /**
+         * Creates a view on a list of pointers to the routes of the packet destination
+         * whose pheromone values are aggregated by the given routing table.
+         */
+        NextHopCandidates(const std::deque<RoutingTableEntry*>* entries, const Packet* packet, const PheromoneAggregates* aggregates, const RoutingTable* routingTable);
+
+        /**
+         * Creates a view on a contiguous array of the routes of the packet destination.
+         */
+        NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet);
+
+        /**
+         * Creates a view on a contiguous array of the routes of the packet destination
+         * whose pheromone values are aggregated by the given routing table.
+         */
+        NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet, const PheromoneAggregates* aggregates, const RoutingTable* routingTable);
+
+        /**
+         * Creates a view on a contiguous array of routes that is protected by the given guard.
+         */
+        NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet, const EpochGuard& guard);
+
+        Iterator begin() const;
+        Iterator end() const;
+
+        /**
+         * Returns true if there is no valid candidate. This stops at the first valid candidate.
+         */
+        bool empty() const;
+
+        /**
+         * Returns the number of valid candidates. This needs to check all routes.
+         */
+        unsigned int size() const;
+
+        /**
+         * Returns the first candidate with the highest pheromone value or nullptr if there is no candidate.
+         * If the routing table aggregates the pheromone values, this does not need to look at
+         * the other candidates unless the best route leads over the source or sender of the packet.
+         */
+        RoutingTableEntry* getBestCandidate() const;
+
+        /**
+         * Returns the sum of the pheromone values of all candidates.
+         * If the routing table aggregates the pheromone values, this does not need to look at
+         * any candidate unless some route leads over the source or sender of the packet.
+         */
+        float getSumOfPheromoneValues() const;
+
+        /**
+         * Picks a candidate with a probability that is proportional to its selection weight
+         * (see RoutingTable::getSelectionWeight). Without a routing table this is the pheromone value.
+         * The given random number must be between 0 and 1. Returns nullptr if there is no candidate.
+         *
+         * If the routing table aggregates the pheromone values and no route leads back over the source
+         * or sender of the packet, the candidate is found by a binary search in the cached cumulative
+         * distribution of the destination. Otherwise the candidates are scanned. If the selection
+         * weights of all candidates are zero, each candidate is picked with the same probability.
+         */
+        RoutingTableEntry* sample(float randomNumber) const;
+
+    private:
+        RoutingTableEntry* getEntryAt(unsigned int position) const;
+        bool isCandidate(unsigned int position) const;
+        bool isCandidate(RoutingTableEntry* entry) const;
+        bool isAggregationComplete() const;
+        float getSelectionWeight(RoutingTableEntry* entry) const;
+
+        /**
+         * Returns the first position at or after the given one which holds a valid candidate.
+         */
+        unsigned int skipToCandidate(unsigned int position) const;
+
+        const std::deque<RoutingTableEntry*>* entryList;
+        RoutingTableEntry* entryArray;
+        unsigned int nrOfEntries;
+        const Packet* packet;
+        AddressId sourceId;
+        AddressId senderId;
+        const PheromoneAggregates* aggregates;
+        const RoutingTable* routingTable;
+        EpochGuard guard;
+
+        /**
+         * Whether any route leads over the source or sender of the packet. This is only checked
+         * once (if the aggregates are used at all), because it takes a pass over all routes.
+         */
+        mutable bool isExclusionKnown;
+        mutable bool hasExcludedRoute;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* NEXT_HOP_CANDIDATES_H_ */
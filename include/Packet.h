@@ -8,6 +8,7 @@
 #include "ARAMacros.h"
 #include "Address.h"
 #include "PacketType.h"
+#include "PayloadBuffer.h"
 
 #include <stddef.h>
 #include <memory>
@@ -22,20 +23,34 @@ ARA_NAMESPACE_BEGIN
 class Packet {
 public:
     Packet(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0);
+
+    /**
+     * Creates a packet that shares the given payload instead of copying it.
+     */
+    Packet(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload);
     Packet(AddressPtr source, AddressPtr destination, char type, unsigned int seqNr, int ttl);
     virtual ~Packet();
 
+    /**
+     * The memory of all packets (including the ones of subclasses) is managed by the ~PacketPool,
+     * so packets can still be created with new and destroyed with delete.
+     */
+    static void* operator new(std::size_t size);
+    static void operator delete(void* packet, std::size_t size);
+
     /**
      * Returns the address of the node that has initially created and send a packet
      * with this payload and sequence number directed at the destination node.
      * It must not be confused with the sender of this packet which corresponds
      * to the node from which this packet has been received (layer 2).
+     * Like the other address getters, this returns a reference to the address of the
+     * packet which is only valid as long as the packet is neither changed nor deleted.
      *
      * @see Packet::getDestination()
      * @see Packet::getSender()
      * @see Packet::getPenultimateHop()
      */
-    AddressPtr getSource() const;
+    const AddressPtr& getSource() const;
 
     /**
      * Returns the address of the node to whom the payload of this packet is directed.
@@ -46,7 +61,7 @@ public:
      * @see Packet::getSender()
      * @see Packet::getPenultimateHop()
      */
-    AddressPtr getDestination() const;
+    const AddressPtr& getDestination() const;
 
     /**
      * Returns the address of the node from which this packet has been received (layer 2).
@@ -57,7 +72,7 @@ public:
      * @see Packet::getDestination()
      * @see Packet::getPenultimateHop()
      */
-    AddressPtr getSender() const;
+    const AddressPtr& getSender() const;
 
     /**
      * Returns the address of the node from which the sender has received this packet.
@@ -67,7 +82,37 @@ public:
      * @see Packet::getDestination()
      * @see Packet::getSender()
      */
-    AddressPtr getPreviousHop() const;
+    const AddressPtr& getPreviousHop() const;
+
+    /**
+     * Returns the id of the source address in the AddressTable.
+     * Two packets have the same source id if (and only if) their sources are equal.
+     */
+    AddressId getSourceId() const {
+        return AddressTable::getId(source);
+    }
+
+    /**
+     * Returns the id of the destination address in the AddressTable.
+     */
+    AddressId getDestinationId() const {
+        return AddressTable::getId(destination);
+    }
+
+    /**
+     * Returns the id of the sender address in the AddressTable.
+     */
+    AddressId getSenderId() const {
+        return AddressTable::getId(sender);
+    }
+
+    /**
+     * Returns the id of the previous hop address in the AddressTable.
+     * The previous hop must not be the nullptr.
+     */
+    AddressId getPreviousHopId() const {
+        return AddressTable::getId(previousHop);
+    }
 
     /**
      * Returns the null-terminated string representation of the address of the source.
@@ -161,6 +206,11 @@ public:
 
     unsigned int getPayloadLength() const;
 
+    /**
+     * Returns the buffer of the payload, which can be shared with other packets.
+     */
+    const PayloadBuffer& getPayloadBuffer() const;
+
     /**
      * Two packets are defined to be equal if they have the same source and sequence number
      * TODO is it really okay to define equality this way? What about the payload, destination and type?
@@ -186,8 +236,7 @@ protected:
     AddressPtr previousHop;
     char type;
     unsigned int seqNr;
-    const char* payload;
-    unsigned int payloadSize;
+    PayloadBuffer payload;
     int ttl;
 
 friend struct PacketPredicate;
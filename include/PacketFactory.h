@@ -8,6 +8,9 @@
 #include "ARAMacros.h"
 #include "Address.h"
 #include "Packet.h"
+#include "PacketPool.h"
+
+#include <cstddef>
 
 ARA_NAMESPACE_BEGIN
 
@@ -29,7 +32,7 @@ class PacketFactory {
         void setPreviousHopFeature(bool isActivated);
 
         /**
-         * Creates a copy of the original packet.
+         * Creates a copy of the original packet. The clone shares the payload of the original packet.
          *
          * Note: The result of this method is a newly created object which must be
          * deleted later by the calling class.
@@ -46,6 +49,12 @@ class PacketFactory {
          */
         Packet* makeDataPacket(AddressPtr source, AddressPtr destination, unsigned int newSequenceNumber, const char* payload, unsigned int payloadSize);
 
+        /**
+         * Creates a new DATA packet like the method above, but the packet shares the given payload
+         * instead of copying it (@see PayloadBuffer::adopt to hand over a buffer of the caller).
+         */
+        Packet* makeDataPacket(AddressPtr source, AddressPtr destination, unsigned int newSequenceNumber, const PayloadBuffer& payload);
+
         /**
          * Creates a new FANT based on the given addresses and sequence number.
          *
@@ -123,14 +132,32 @@ class PacketFactory {
           */
          Packet* makeHelloPacket(AddressPtr source, AddressPtr destination, unsigned int sequenceNumber);
 
+         /**
+          * Returns a packet to the ~PacketPool. This is the same as deleting the packet, which is
+          * still possible for all packets, and must only be called once the packet is not used anymore.
+          */
+         void release(Packet* packet);
+
+         /**
+          * Reserves memory for the given number of packets of this factory in the ~PacketPool of the
+          * calling thread, so no memory is allocated until more packets are in use at the same time.
+          * @see PacketPool::getStatistics() for the number of packets that are used at most
+          */
+         void reservePackets(unsigned int nrOfPackets);
+
          void setMaxHopCount(int n);
          int getMaximumNrOfHops();
     protected:
+         /**
+          * Returns the size of the packets that are created by this factory.
+          */
+         virtual std::size_t getPacketSize() const;
+
          /**
           * This method is responsible for creating the actual packet instance.
           * It can be overridden if another other Packet class shall be used.
           */
-         virtual Packet* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0, AddressPtr previousHop=nullptr);
+         virtual Packet* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload=PayloadBuffer(), AddressPtr previousHop=nullptr);
 
          int maxHopCount;
          bool isPreviousHopFeatureEnabled;
@@ -0,0 +1,104 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef PACKET_POOL_H_
+#define PACKET_POOL_H_
+
+#include "ARAMacros.h"
+
+#include <cstddef>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The statistics of the PacketPool. Each thread counts its own allocations and releases. The
+ * statistics are the sums of the counters of all threads (including the ones that have already
+ * ended) except for the number of free packets, which is reported for the free lists of the
+ * calling thread. A packet may be released by another thread than the one which has allocated it,
+ * so only the sums are balanced.
+ */
+struct PacketPoolStatistics {
+    /** The number of packets that have been allocated (including the reused ones) */
+    unsigned long nrOfAllocations;
+
+    /** The number of allocations that have been served from the free lists */
+    unsigned long nrOfReusedPackets;
+
+    /** The number of packets that have been released */
+    unsigned long nrOfReleases;
+
+    /** The number of packets that have been allocated but not yet released */
+    long nrOfPacketsInUse;
+
+    /**
+     * The sum of the highest numbers of packets in use by each thread so far, which is a good size
+     * for the pool. Each thread only sees the packets it has allocated minus the packets it has
+     * released. This is exact as long as all packets are released by the threads which have
+     * allocated them and an upper bound otherwise.
+     */
+    long maxNrOfPacketsInUse;
+
+    /** The number of released packets that are kept for reuse by the calling thread */
+    unsigned long nrOfFreePackets;
+};
+
+/**
+ * The PacketPool provides the memory of all packets (@see Packet::operator new). Released packets are
+ * not freed but kept in a free list, so a client that has reached its steady state does not allocate
+ * any memory for new packets. Each thread has its own free lists and statistics counters, so
+ * allocating and releasing a packet needs no locking and no atomic read-modify-write operation.
+ *
+ * The packets are grouped into size classes, because the subclasses of ~Packet have different sizes.
+ * Packets that are larger than the largest size class are allocated directly.
+ */
+class PacketPool {
+    public:
+        /**
+         * Returns memory for a packet of the given size.
+         */
+        static void* allocate(std::size_t size);
+
+        /**
+         * Returns the memory of a packet of the given size to the pool of the calling thread.
+         * If the free list of its size class is full, the memory is freed.
+         */
+        static void release(void* packet, std::size_t size);
+
+        /**
+         * Allocates the given number of packets of the given size in advance, so the pool of the
+         * calling thread does not need to allocate memory until more packets are used at once.
+         */
+        static void reserve(std::size_t size, unsigned int nrOfPackets);
+
+        /**
+         * Frees all packets in the free lists of the calling thread.
+         */
+        static void clear();
+
+        /**
+         * Sets the maximum number of released packets per size class that are kept for reuse
+         * by the calling thread. The default is 4096.
+         */
+        static void setMaxNrOfFreePackets(unsigned int maxNrOfFreePackets);
+
+        static PacketPoolStatistics getStatistics();
+
+        /**
+         * Resets the counters of the statistics of all threads. The maximum number of packets in
+         * use starts again at the current number of packets in use. This should only be called
+         * while no other thread allocates or releases packets, because their counters are not
+         * modified atomically.
+         */
+        static void resetStatistics();
+
+        /**
+         * The size of the size classes and the size of the largest packet that is pooled.
+         */
+        static const std::size_t SIZE_CLASS_GRANULARITY = 64;
+        static const std::size_t MAX_POOLED_PACKET_SIZE = 1024;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -15,7 +15,7 @@
 ARA_NAMESPACE_BEGIN
 
 typedef std::deque<Packet*> PacketQueue;
-typedef std::unordered_map<AddressPtr, PacketQueue, AddressHash, AddressPredicate> TrappedPacketsMap;
+typedef std::unordered_map<AddressId, PacketQueue> TrappedPacketsMap;
 
 /**
  * The PacketTrap is responsible for storing packets while the route discovery
@@ -62,20 +62,20 @@ public:
      * The packets are in the same order as PacketTrap::trapPacket(..) has been
      * called on them. All returned packets are automatically untrapped.
      */
-    PacketQueue untrapDeliverablePackets(AddressPtr destination);
+    PacketQueue untrapDeliverablePackets(const AddressPtr& destination);
 
     /**
      * This will remove all packets for the given destination address from this packet trap
      * and return them in a list object.
      */
-    PacketQueue removePacketsForDestination(AddressPtr destination);
+    PacketQueue removePacketsForDestination(const AddressPtr& destination);
 
     /**
      * Returns the number of trapped packets for a given destination or the
      * total number of all trapped packets if destination is the nullptr.
      * This will most likely only be used for statistics and performance analysis.
      */
-    unsigned int getNumberOfTrappedPackets(AddressPtr destination=nullptr);
+    unsigned int getNumberOfTrappedPackets(const AddressPtr& destination=nullptr);
 
     /**
      * Set the assigned routing table.
@@ -91,8 +91,8 @@ private:
     /**
      * This hashmap stores all trapped packets.
      * In Java we would write: HashMap<Address, Queue<Packet>>
-     * The keys are the packet destinations and the values are a
-     * queue of packets.
+     * The keys are the ids of the packet destinations (in the AddressTable)
+     * and the values are a queue of packets.
      *
      * This is a Hashmap because everytime PacketTrap::getDeliverablePackets()
      * is called we want to find all packets for a specific destination fast.
@@ -0,0 +1,122 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef PAYLOAD_BUFFER_H_
+#define PAYLOAD_BUFFER_H_
+
+#include "ARAMacros.h"
+
+#include <atomic>
+
+/**
+ * Payloads up to this size (in bytes) are stored inside the PayloadBuffer (and thus inside the
+ * packet) instead of a separate allocation. It can be changed at compile time via the
+ * PAYLOAD_INLINE_CAPACITY variable of the Makefile (e.g. make PAYLOAD_INLINE_CAPACITY=64) or
+ * with -DARA_PAYLOAD_INLINE_CAPACITY=64. A value of 0 disables the inline storage.
+ */
+#ifndef ARA_PAYLOAD_INLINE_CAPACITY
+#define ARA_PAYLOAD_INLINE_CAPACITY 32
+#endif
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * An immutable buffer for the payload of packets.
+ *
+ * Small payloads (like the ones of sensor readings) are stored inline and copied with the buffer.
+ * Larger payloads are reference counted, so copies of a PayloadBuffer share the same memory and
+ * clones of a packet do not need to copy its payload. The memory is freed when the last
+ * PayloadBuffer that refers to it is destroyed.
+ */
+class PayloadBuffer {
+    public:
+        static const unsigned int INLINE_CAPACITY = ARA_PAYLOAD_INLINE_CAPACITY;
+
+        /**
+         * Creates an empty buffer.
+         */
+        PayloadBuffer() : buffer(nullptr), inlineSize(0) {}
+
+        /**
+         * Creates a buffer with a copy of the given data. If the size is 0, the data is assumed
+         * to be a null terminated string. If the data is nullptr, the buffer is empty.
+         */
+        PayloadBuffer(const char* data, unsigned int size);
+
+        PayloadBuffer(const PayloadBuffer& other);
+        PayloadBuffer(PayloadBuffer&& other);
+        PayloadBuffer& operator=(const PayloadBuffer& other);
+        PayloadBuffer& operator=(PayloadBuffer&& other);
+        ~PayloadBuffer();
+
+        /**
+         * Creates a buffer that takes the ownership of the given data without copying it (even if
+         * it would fit inline). The data must have been allocated with new[] and must not be modified
+         * or deleted by the caller anymore.
+         */
+        static PayloadBuffer adopt(char* data, unsigned int size);
+
+        const char* getData() const {
+            if (isInline()) {
+                return inlineData;
+            }
+            return buffer == nullptr ? nullptr : buffer->data;
+        }
+
+        unsigned int getSize() const {
+            if (isInline()) {
+                return inlineSize;
+            }
+            return buffer == nullptr ? 0 : buffer->size;
+        }
+
+        bool isEmpty() const {
+            return isInline() == false && buffer == nullptr;
+        }
+
+        /**
+         * Returns true if the data is stored inside this object.
+         */
+        bool isInline() const {
+            return inlineSize > 0;
+        }
+
+        /**
+         * Returns the number of PayloadBuffer objects that share the data of this buffer
+         * (which is always 1 for inline data).
+         */
+        unsigned int getNrOfReferences() const;
+
+    private:
+        /**
+         * The data of a copied buffer is stored right behind this header in the same allocation.
+         */
+        struct Buffer {
+            std::atomic<unsigned int> nrOfReferences;
+            const char* data;
+            unsigned int size;
+            bool isAdopted;
+        };
+
+        explicit PayloadBuffer(Buffer* buffer) : buffer(buffer), inlineSize(0) {}
+        static Buffer* makeBuffer(const char* data, unsigned int size, bool isAdopted);
+        void copyFrom(const PayloadBuffer& other);
+        void moveFrom(PayloadBuffer& other);
+        void retain();
+        void release();
+
+        union {
+            Buffer* buffer;
+            char inlineData[INLINE_CAPACITY > 0 ? INLINE_CAPACITY : 1];
+        };
+
+        /**
+         * The size of the inline data or 0 if the data is not stored inline.
+         */
+        unsigned int inlineSize;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef PEER_STATE_TABLE_H_
+#define PEER_STATE_TABLE_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "IntermediateHopSet.h"
+#include "NetworkInterface.h"
+#include "SequenceNumberWindow.h"
+#include "Time.h"
+#include "Timer.h"
+
+#include <unordered_map>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The PeerState holds everything an ~AbstractARAClient remembers about another node, whether
+ * the node is the source of received packets, a neighbor or the destination of a route discovery.
+ * The timers and time objects are owned by the client.
+ */
+struct PeerState {
+    PeerState();
+
+    /**
+     * The sequence numbers of the packets that have recently been received from this node.
+     */
+    SequenceNumberWindow receivedSequenceNumbers;
+
+    /**
+     * The hops that have been seen on the paths from this node. This includes direct neighbors as
+     * well as indirect nodes the client has learned from the previous hop field of the packets.
+     */
+    IntermediateHopSet knownIntermediateHops;
+
+    /**
+     * The sequence number of the last route discovery (ant packet) that has been started by this node.
+     * We identify each route discovery by its origin (source address) and sequence number.
+     * When we receive a new ant packet we check its sequence number with this. If they differ,
+     * this is a new route discovery and we need to forget about all knownIntermediateHops.
+     */
+    unsigned int lastRouteDiscoverySequenceNumber;
+    bool hasSeenRouteDiscovery;
+
+    /**
+     * The last time this neighbor has shown some activity (or nullptr if it is no known neighbor)
+     * and the interface over which it has been active. This could either be that the client has
+     * successfully received or send a packet to/from this neighbor.
+     */
+    Time* lastActivityTime;
+    NetworkInterface* lastActivityInterface;
+
+    /**
+     * True while a route discovery for this destination is running. The route discovery timer is
+     * nullptr after the first BANT has come back, but the route discovery is not completely finished
+     * until the delivery timer has expired.
+     */
+    bool isRouteDiscoveryRunning;
+    Timer* routeDiscoveryTimer;
+
+    /**
+     * The timer of the PANT that is scheduled to be sent to this destination (or nullptr).
+     */
+    Timer* pantTimer;
+};
+
+/**
+ * The PeerStateTable stores the PeerState of each node the client knows by the id of its
+ * address in the AddressTable. The states are never moved (the returned references stay
+ * valid until the table is deleted), so the client looks up the state of a node once and
+ * then works on the state directly.
+ *
+ * The table remembers the last state that has been looked up, because the client usually
+ * looks up the same node (the source of the current packet) several times in a row.
+ *
+ * The ids of all nodes with a state are retained in the AddressTable, so they stay valid
+ * (e.g. for AddressTable::getAddress(..)) until the state is erased. The table can not be
+ * copied because the client owns the timers and time objects in the states.
+ */
+class PeerStateTable {
+    public:
+        typedef std::unordered_map<AddressId, PeerState>::iterator iterator;
+
+        PeerStateTable() {}
+        PeerStateTable(const PeerStateTable& other) = delete;
+        PeerStateTable& operator=(const PeerStateTable& other) = delete;
+        ~PeerStateTable();
+
+        /**
+         * Returns the state of the node with the given id. A new state is created if the node is not yet known.
+         */
+        PeerState& get(AddressId id) {
+            if (id == lastId) {
+                return *lastState;
+            }
+            return *lookup(id, true);
+        }
+
+        PeerState& get(const AddressPtr& address) {
+            return get(AddressTable::getId(address));
+        }
+
+        /**
+         * Returns the state of the node with the given id or nullptr if the node is not known.
+         */
+        PeerState* find(AddressId id) {
+            if (id == lastId) {
+                return lastState;
+            }
+            return lookup(id, false);
+        }
+
+        PeerState* find(const AddressPtr& address) {
+            return find(AddressTable::getId(address));
+        }
+
+        /**
+         * Deletes the state of the node with the given id (if it is known) and releases its id.
+         * The timers and time objects of the state must have been deleted before.
+         */
+        void erase(AddressId id);
+
+        void erase(const AddressPtr& address) {
+            erase(AddressTable::getId(address));
+        }
+
+        iterator begin();
+        iterator end();
+        unsigned int size() const;
+
+    private:
+        /**
+         * Returns the state of the node or nullptr if the node is not known and should not be created.
+         */
+        PeerState* lookup(AddressId id, bool create);
+
+        std::unordered_map<AddressId, PeerState> states;
+        AddressId lastId = UNKNOWN_ADDRESS_ID;
+        PeerState* lastState = nullptr;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* PEER_STATE_TABLE_H_ */
@@ -0,0 +1,59 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef RANDOM_NUMBER_GENERATOR_H_
+#define RANDOM_NUMBER_GENERATOR_H_
+
+#include "ARAMacros.h"
+
+#include <cstdint>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * A small and fast pseudo random number generator (PCG32, see http://www.pcg-random.org).
+ *
+ * In contrast to random() each instance has its own state, so several clients in one process
+ * neither share their random numbers nor contend for a lock. The same seed and stream always
+ * lead to the same sequence of numbers on every platform. Generators that are seeded with the
+ * same seed but different streams produce independent sequences.
+ */
+class RandomNumberGenerator {
+    public:
+        RandomNumberGenerator(uint64_t seed=0, uint64_t stream=0);
+
+        /**
+         * Restarts the generator with the given seed on the given stream.
+         */
+        void seed(uint64_t seed, uint64_t stream=0);
+
+        /**
+         * Returns the next uniformly distributed 32 bit number.
+         */
+        uint32_t next() {
+            uint64_t oldState = state;
+            state = oldState * MULTIPLIER + increment;
+            uint32_t xorShifted = ((oldState >> 18) ^ oldState) >> 27;
+            uint32_t rotation = oldState >> 59;
+            return (xorShifted >> rotation) | (xorShifted << ((-rotation) & 31));
+        }
+
+        /**
+         * Returns the next uniformly distributed number in [0, 1).
+         */
+        float nextFloat() {
+            // a float can represent all multiples of 2^-24 in [0, 1) exactly
+            return (next() >> 8) * (1.0f / 16777216.0f);
+        }
+
+    private:
+        static const uint64_t MULTIPLIER = 6364136223846793005ULL;
+
+        uint64_t state;
+        uint64_t increment;
+};
+
+ARA_NAMESPACE_END
+
+#endif
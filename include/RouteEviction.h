@@ -0,0 +1,156 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_EVICTION_H_
+#define ROUTE_EVICTION_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "NetworkInterface.h"
+#include "RoutingTableEntry.h"
+#include "RouteEvictionListener.h"
+
+#include <functional>
+#include <vector>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The RouteEviction limits the number of routes in a ~RoutingTable (see RoutingTable::setMaxNrOfEntries).
+ *
+ * It keeps all routes of the table in the order in which they have been updated the last time.
+ * The queue is a doubly linked list whose nodes are stored in a single vector and refer to each
+ * other by their index. Removed nodes are reused, so tracking a route does not allocate any memory
+ * once the table is full. Each ~RoutingTableEntry remembers the index of its node, so the table
+ * may copy or move its entries around as long as it removes each route via RouteEviction::forget.
+ *
+ * The nodes identify their routes by destination, next hop and interface instead of pointing to
+ * the entries, because not all tables keep their entries at a fixed address.
+ */
+class RouteEviction {
+    public:
+        struct Route {
+            AddressPtr destination;
+            AddressPtr nextHop;
+            NetworkInterface* interface;
+        };
+
+        /**
+         * Returns the current pheromone value of the given route which must exist in the table.
+         */
+        typedef std::function<float (const Route& route)> PheromoneLookup;
+
+        /**
+         * The number of least recently updated routes that are compared by the pheromone aware eviction.
+         */
+        static const unsigned int NR_OF_CANDIDATES = 8;
+
+        RouteEviction();
+
+        void setMaxNrOfEntries(unsigned int maxNrOfEntries);
+        unsigned int getMaxNrOfEntries() const;
+        void setPheromoneAware(bool isActivated);
+        bool isPheromoneAware() const;
+
+        /**
+         * The memory management of the listener is not handled by this class.
+         */
+        void setListener(RouteEvictionListener* listener);
+
+        bool isSizeLimited() const {
+            return maxNrOfEntries > 0;
+        }
+
+        /**
+         * Returns true if a route has to be evicted before a new route is added.
+         */
+        bool isFull() const {
+            return nrOfRoutes > 0 && nrOfRoutes + 1 > maxNrOfEntries;
+        }
+
+        /**
+         * Appends the new route of the given entry to the queue if the size of the table is limited.
+         */
+        void track(const AddressPtr& destination, RoutingTableEntry* entry);
+
+        /**
+         * Moves the route of the given entry to the end of the queue because it has just been updated.
+         */
+        void touch(RoutingTableEntry* entry) {
+            if (entry->getEvictionQueuePosition() != RoutingTableEntry::NOT_TRACKED) {
+                moveToEnd(entry->getEvictionQueuePosition());
+            }
+        }
+
+        /**
+         * Removes the route of the given entry from the queue. This must be called before the entry
+         * is removed from the table.
+         */
+        void forget(RoutingTableEntry* entry);
+
+        /**
+         * Chooses the route that is evicted next. If the pheromone aware eviction is activated, this
+         * is the route with the lowest pheromone value among the RouteEviction::NR_OF_CANDIDATES least
+         * recently updated routes. Otherwise, it is the least recently updated route.
+         * The queue must not be empty.
+         */
+        Route chooseRoute(const PheromoneLookup& getPheromoneValue) const;
+
+        /**
+         * Remembers a route that has been evicted. The listener is not notified right away, because
+         * the table is still in the middle of the update that made room for a new route.
+         */
+        void routeHasBeenEvicted(const Route& route);
+
+        /**
+         * Returns all remembered evicted routes and forgets them. A table that is shared between
+         * threads takes the routes while holding its lock and notifies the listener afterwards.
+         */
+        std::vector<Route> takeEvictedRoutes();
+
+        /**
+         * Notifies the listener about the given evicted routes.
+         */
+        void notifyListener(const std::vector<Route>& routes);
+
+        /**
+         * Notifies the listener about all remembered evicted routes.
+         */
+        void notifyListener();
+
+        unsigned int size() const {
+            return nrOfRoutes;
+        }
+
+    private:
+        struct Node {
+            Route route;
+            unsigned int previous;
+            unsigned int next;
+        };
+
+        static const unsigned int NONE = RoutingTableEntry::NOT_TRACKED;
+
+        void unlink(unsigned int position);
+        void append(unsigned int position);
+        void moveToEnd(unsigned int position);
+
+        /**
+         * The nodes of the queue and of the free list (which is only linked via Node::next).
+         */
+        std::vector<Node> nodes;
+        unsigned int first;
+        unsigned int last;
+        unsigned int firstFree;
+        unsigned int nrOfRoutes;
+
+        unsigned int maxNrOfEntries;
+        bool pheromoneAware;
+        RouteEvictionListener* listener;
+        std::vector<Route> evictedRoutes;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* ROUTE_EVICTION_H_ */
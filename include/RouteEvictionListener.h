@@ -0,0 +1,32 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_EVICTION_LISTENER_H_
+#define ROUTE_EVICTION_LISTENER_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "NetworkInterface.h"
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The RouteEvictionListener is notified by the ~RoutingTable whenever a route had to be
+ * evicted because the capacity of the table (see RoutingTable::setMaxNrOfEntries) has been exhausted.
+ */
+class RouteEvictionListener {
+public:
+    virtual ~RouteEvictionListener() {}
+
+    /**
+     * Notifies this listener that the route to the given destination over the given next hop
+     * and interface has been removed from the routing table. This is called after the update which
+     * caused the eviction has been completed, so the listener may look up or modify the table.
+     */
+    virtual void routeHasBeenEvicted(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) = 0;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_HANDLE_H_
+#define ROUTE_HANDLE_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "NetworkInterface.h"
+#include "RoutingTableEntry.h"
+#include "EpochGuard.h"
+
+ARA_NAMESPACE_BEGIN
+
+class RoutingTable;
+
+/**
+ * A RouteHandle refers to a single destination/nextHop/interface route in a ~RoutingTable,
+ * regardless of whether this route already exists or not. It is returned by RoutingTable::findRoute
+ * and remembers where the route (or the routes of its destination) are stored in the table,
+ * so the pheromone value can be read and updated without looking the route up again.
+ *
+ * The handle remembers the RoutingTable::getRouteGeneration at which it has been bound. If routes
+ * have been added to or removed from the table since then (which may move the bound route in memory),
+ * the handle looks the route up again before it is used. Handles of a ~ConcurrentRoutingTable
+ * additionally hold an ~EpochGuard, so the bound entry can still be read if another thread modifies
+ * the table in the meantime.
+ */
+class RouteHandle {
+    public:
+        RouteHandle(RoutingTable* routingTable, AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+        /**
+         * Returns true if the route does exist in the routing table.
+         */
+        bool exists() const;
+
+        /**
+         * Returns the pheromone value of the route or 0 if the route does not exist.
+         */
+        float getPheromoneValue() const;
+
+        /**
+         * Sets the pheromone value of the route. If the route does not exist yet, it is created.
+         */
+        void setPheromoneValue(float newPheromoneValue);
+
+        AddressPtr getDestination() const;
+        AddressPtr getNextHop() const;
+        NetworkInterface* getInterface() const;
+
+        /**
+         * Returns the entry of this route or nullptr if the route does not exist.
+         */
+        RoutingTableEntry* getEntry() const;
+
+        /**
+         * Returns where the routes of the destination are stored in the routing table or nullptr
+         * if the destination is unknown. The meaning of this pointer depends on the routing table.
+         */
+        void* getRoutes() const;
+
+        /**
+         * This is called by the routing table implementations to bind this handle to the stored route.
+         * The handle is bound to the current generation of the routing table.
+         */
+        void bind(RoutingTableEntry* entry, void* routes);
+
+        /**
+         * Binds this handle like RouteHandle::bind(RoutingTableEntry*, void*) and keeps the
+         * given guard until the handle is destroyed.
+         */
+        void bind(RoutingTableEntry* entry, void* routes, const EpochGuard& guard);
+
+    private:
+        /**
+         * Looks the route up again if the routing table has been changed since this handle has been bound.
+         */
+        void refresh() const;
+
+        RoutingTable* routingTable;
+        AddressPtr destination;
+        AddressPtr nextHop;
+        NetworkInterface* interface;
+
+        // the binding is refreshed lazily, even by the const getters
+        mutable RoutingTableEntry* entry;
+        mutable void* routes;
+        mutable EpochGuard guard;
+        mutable unsigned long generation;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* ROUTE_HANDLE_H_ */
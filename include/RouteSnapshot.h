@@ -0,0 +1,54 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_SNAPSHOT_H_
+#define ROUTE_SNAPSHOT_H_
+
+#include "ARAMacros.h"
+#include "RouteSnapshotResolver.h"
+
+#include <string>
+
+ARA_NAMESPACE_BEGIN
+
+class RoutingTable;
+
+/**
+ * The RouteSnapshot writes the routes of a ~RoutingTable to a file and reads them back
+ * (see RoutingTable::snapshot and RoutingTable::restore).
+ *
+ * A snapshot is a compact binary file which can be memory-mapped: A fixed size header is
+ * followed by a fixed size record for each route (destination, next hop, interface, pheromone
+ * value and the time since the pheromone value has been evaporated the last time) and the
+ * textual representations of all addresses the routes refer to. The file is written in the
+ * byte order of this host and is not meant to be exchanged between different machines.
+ */
+class RouteSnapshot {
+    public:
+        /**
+         * Writes all routes of the given table to the file at the given path. The age of each
+         * route is the difference between the given timestamp and the timestamp of its entry
+         * (see RoutingTableEntry::getTimestamp).
+         * @throws Exception if the file could not be written
+         */
+        static void write(const RoutingTable& table, long currentTimestamp, const std::string& path);
+
+        /**
+         * Adds the routes from the snapshot at the given path to the given table. The pheromone
+         * values are evaporated with the evaporation policy of the table.
+         * @return the number of restored routes
+         * @throws Exception if the file could not be read or is not a valid snapshot
+         */
+        static unsigned int restore(RoutingTable& table, const std::string& path, RouteSnapshotResolver* resolver);
+
+    private:
+        /**
+         * Restores the routes from a memory-mapped snapshot.
+         */
+        static unsigned int restoreRoutes(RoutingTable& table, const char* snapshot, size_t snapshotSize, RouteSnapshotResolver* resolver);
+};
+
+ARA_NAMESPACE_END
+
+#endif /* ROUTE_SNAPSHOT_H_ */
@@ -0,0 +1,41 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_SNAPSHOT_RESOLVER_H_
+#define ROUTE_SNAPSHOT_RESOLVER_H_
+
+#include "ARAMacros.h"
+#include "Address.h"
+#include "NetworkInterface.h"
+
+#include <string>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The RouteSnapshotResolver is used by RoutingTable::restore to turn the addresses that are
+ * stored in a routing table snapshot back into address objects and network interfaces.
+ * The snapshot stores each address by its textual representation (see Address::toString)
+ * and each interface by its local address.
+ */
+class RouteSnapshotResolver {
+public:
+    virtual ~RouteSnapshotResolver() {}
+
+    /**
+     * Creates the address object for the given textual representation.
+     * Routes that refer to an address for which nullptr is returned are not restored.
+     */
+    virtual AddressPtr resolveAddress(const std::string& address) = 0;
+
+    /**
+     * Returns the network interface with the given local address or nullptr
+     * if there is no such interface anymore. Routes over unknown interfaces are not restored.
+     */
+    virtual NetworkInterface* resolveInterface(AddressPtr localAddress) = 0;
+};
+
+ARA_NAMESPACE_END
+
+#endif
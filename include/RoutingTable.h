@@ -11,11 +11,20 @@
 #include "NetworkInterface.h"
 #include "EvaporationPolicy.h"
 #include "RoutingTableEntry.h"
+#include "NextHopCandidates.h"
+#include "RouteHandle.h"
+#include "RouteEviction.h"
+#include "RouteEvictionListener.h"
+#include "RouteSnapshotResolver.h"
 #include "ExponentialEvaporationPolicy.h"
 #include "Clock.h"
 
+#include <atomic>
 #include <deque>
+#include <functional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 ARA_NAMESPACE_BEGIN
 
@@ -25,41 +34,150 @@ struct RoutingTableEntryTupel {
 };
 
 #define RoutingTableEntryList std::deque<RoutingTableEntry*>
-typedef std::unordered_map<AddressPtr, RoutingTableEntryList*, AddressHash, AddressPredicate> RoutingTableMap;
+
+/**
+ * All routes to one destination together with the aggregates of their pheromone values.
+ */
+struct DestinationRoutes {
+    RoutingTableEntryList entries;
+    PheromoneAggregates aggregates;
+};
+
+typedef std::unordered_map<AddressPtr, DestinationRoutes*, AddressHash, AddressPredicate> RoutingTableMap;
+typedef std::unordered_map<AddressPtr, unsigned int, AddressHash, AddressPredicate> DestinationCounterMap;
+typedef std::unordered_map<AddressPtr, DestinationCounterMap, AddressHash, AddressPredicate> NextHopIndex;
+
+/**
+ * The visitor that is called by RoutingTable::forEachEntry for each route in the table.
+ */
+typedef std::function<void (const AddressPtr& destination, RoutingTableEntry* entry)> RoutingTableVisitor;
 
 class RoutingTable {
 
+protected:
+    /**
+     * The position of a RoutingTable::const_iterator. Each implementation only uses the
+     * fields it needs: The standard table walks its map and the flat table its slots.
+     */
+    struct IteratorPosition {
+        RoutingTableMap::const_iterator destination;
+        size_t slot;
+        unsigned int route;
+    };
+
 public:
+    /**
+     * A forward iterator over all routes of a table. Dereferencing it returns the
+     * destination together with the ~RoutingTableEntry. The iterator is invalidated
+     * if the table is modified.
+     */
+    class const_iterator {
+        public:
+            RoutingTableEntryTupel operator*() const;
+            const_iterator& operator++();
+            bool operator==(const const_iterator& other) const;
+            bool operator!=(const const_iterator& other) const;
+
+        protected:
+            friend class RoutingTable;
+            const_iterator(const RoutingTable* table, bool isAtEnd);
+
+            const RoutingTable* table;
+            IteratorPosition position;
+            bool isAtEnd;
+    };
+
     RoutingTable();
     virtual ~RoutingTable();
 
+protected:
+    /**
+     * Alternative table layouts which keep their routes in their own data structures pass false,
+     * so the RoutingTable::table of the standard layout is not created at all. Such a table must
+     * override every virtual method which uses the RoutingTable::table. The implementations of this
+     * class throw an Exception if they are called for an alternative layout anyway.
+     */
+    explicit RoutingTable(bool usesStandardLayout);
+
+public:
+
     /**
      * Get the pheromone value for a specific route in this routing table.
      */
-    float getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
-   
+    virtual float getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
     virtual void update(AddressPtr destination, RoutingTableEntry* entry);
     virtual void update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue);
 
-    void removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
-    RoutingTableEntryList getPossibleNextHops(const Packet* packet);
-    RoutingTableEntryList getPossibleNextHops(AddressPtr destination);
+    /**
+     * Looks up the route to the given destination over the given next hop and interface
+     * and returns a handle to it. The returned handle may refer to a route that does not exist yet.
+     * Reading or updating the pheromone value via the handle needs no further lookup.
+     */
+    virtual RouteHandle findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+
+    /**
+     * Sets the pheromone value of the route the given handle refers to and creates the route
+     * if it does not exist yet. This is called by RouteHandle::setPheromoneValue.
+     */
+    virtual void update(RouteHandle& route, float pheromoneValue);
+
+    /**
+     * Returns a number that changes whenever a route is added to or removed from this table
+     * (or the routes are moved in memory for any other reason). A ~RouteHandle only trusts
+     * the route it is bound to as long as this number has not changed.
+     */
+    unsigned long getRouteGeneration() const {
+        return routeGeneration.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Removes the route to the given destination over the given next hop and interface.
+     * @return true if the route did exist and has been removed, false otherwise
+     */
+    virtual bool removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+    virtual RoutingTableEntryList getPossibleNextHops(const Packet* packet);
+    virtual RoutingTableEntryList getPossibleNextHops(AddressPtr destination);
+
+    /**
+     * Returns a view on all routes to the packet destination that do *not* lead over the
+     * source or sender of the packet. Unlike RoutingTable::getPossibleNextHops(const Packet*)
+     * this does not copy any routes. The view is only valid until this table is modified.
+     *
+     * The standard table keeps the sum and the maximum of the pheromone values of each destination
+     * up to date and hands them to the view (see NextHopCandidates::getBestCandidate). Hence, the
+     * pheromone values of the returned entries must only be changed via this table.
+     */
+    virtual NextHopCandidates getNextHopCandidates(const Packet* packet);
+
+    /**
+     * Returns true if at least one route to the given destination leads over the given next hop.
+     * This only needs to look at the RoutingTable::nextHopIndex.
+     */
+    bool hasRouteOver(const AddressPtr& destination, const AddressPtr& nextHop) const;
+
+    /**
+     * Returns the weight with which NextHopCandidates::sample chooses the given route.
+     * This is the pheromone value unless a subclass weights its routes differently. Subclasses
+     * must call RoutingTable::invalidateSelectionWeights whenever the weights change otherwise.
+     */
+    virtual float getSelectionWeight(RoutingTableEntry* entry) const;
 
     /**
      * Checks if a route to the packet destination exists, that does *not* lead
      * over the packets sender.
      */
-    bool isDeliverable(const Packet* packet);
+    virtual bool isDeliverable(const Packet* packet);
 
     /**
      * Returns true if there is at least one stored route for the given destination in this routing table.
      */
-    bool isDeliverable(AddressPtr destination);
+    virtual bool isDeliverable(AddressPtr destination);
 
     /**
      * The method checks if an destination/nextHop/interface entry already exists.
      */
-    bool exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
+    virtual bool exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface);
 
     /**
      * A convenience method which returns the negated result of RoutingTable::exists(...)
@@ -70,37 +188,321 @@ public:
     void setEvaporationPolicy(EvaporationPolicy* policy);
     EvaporationPolicy* getEvaporationPolicy() const;
 
+    /**
+     * Activates or deactivates the lazy evaporation of this table.
+     *
+     * If the lazy evaporation is activated, the evaporation is no longer applied to the whole
+     * table at once. Each entry remembers when its pheromone value has been touched the last
+     * time and the evaporated value is computed when the routes to its destination are looked up.
+     * Entries that are not looked up anymore are removed by a background pass that only visits
+     * a few buckets of the table each time RoutingTable::triggerEvaporation is called.
+     *
+     * The lazy evaporation is only used if the evaporation policy supports it
+     * (see EvaporationPolicy::isLazyEvaluationSupported). It should be set before the table is used.
+     * Please note that the entries returned by RoutingTable::getEntryAt or
+     * RoutingTable::getAllRoutesThatLeadOver may carry pheromone values that are not evaporated yet.
+     */
+    void setLazyEvaporation(bool isActivated);
+    bool isLazyEvaporationActivated() const;
+
+    /**
+     * Sets the maximum number of buckets that are evaporated each time RoutingTable::triggerEvaporation
+     * is called. If this is greater than 0, the evaporation is applied incrementally: Each call
+     * continues at the bucket where the previous call has stopped and each entry is evaporated by
+     * the time that has passed since it has been evaporated or updated the last time. This puts a
+     * hard bound on the work per packet regardless of the size of the table and still leads to the
+     * same pheromone values as evaporating the whole table at once.
+     *
+     * If the lazy evaporation is used, this also limits the buckets visited by its background pass.
+     * A value of 0 (the default) evaporates the whole table at once.
+     */
+    void setMaxNrOfBucketsPerEvaporation(unsigned int maxNrOfBuckets);
+    unsigned int getMaxNrOfBucketsPerEvaporation() const;
+
+    /**
+     * Sets the maximum number of routes in this table. If a new route is added to a full table,
+     * the weakest route is evicted first (see RoutingTable::setPheromoneAwareEviction) and the
+     * RouteEvictionListener is notified. A value of 0 (the default) does not limit the table.
+     *
+     * The limit only counts routes. The memory used per route and per destination depends on the
+     * standard library and is not accounted for, so a table with many destinations that have a
+     * single route each needs more memory than one with the same number of routes to few destinations.
+     *
+     * The limit should be set before the table is used (routes that have been added before are never evicted).
+     */
+    void setMaxNrOfEntries(unsigned int maxNrOfEntries);
+    unsigned int getMaxNrOfEntries() const;
+
+    /**
+     * Decides which route is evicted if the table is full. The table keeps all routes ordered by the
+     * time they have been updated the last time. If the pheromone aware eviction is activated (the default),
+     * the route with the lowest pheromone value among the RouteEviction::NR_OF_CANDIDATES least
+     * recently updated routes is evicted. Otherwise, the least recently updated route is evicted.
+     */
+    void setPheromoneAwareEviction(bool isActivated);
+    bool isPheromoneAwareEvictionActivated() const;
+
+    /**
+     * Sets the listener that is notified about each evicted route.
+     * The memory management of the listener is not handled by this table.
+     */
+    void setEvictionListener(RouteEvictionListener* listener);
+
     /**
      * Returns the total number of all entries in this table.
      * This is the sum of all routes to all destinations.
      */
-    unsigned int getTotalNumberOfEntries() const;
+    virtual unsigned int getTotalNumberOfEntries() const;
 
     /**
      * Returns the n'th ~RoutingTableEntry.
      * This method is only used to display the routing table entries to the user.
+     * Please note that this needs to walk the table from the beginning on each call,
+     * so use RoutingTable::forEachEntry or the iterator to visit all entries.
+     * @see RoutingTable::findEntryAt
      */
     RoutingTableEntryTupel getEntryAt(int wantedPosition) const;
 
+    /**
+     * Calls the given visitor for each route in this table. The visitor must not modify the table.
+     */
+    virtual void forEachEntry(const RoutingTableVisitor& visitor) const;
+
+    const_iterator begin() const;
+    const_iterator end() const;
+
+    /**
+     * Writes all routes of this table to the file at the given path, so they can be restored
+     * with RoutingTable::restore after a restart of this node. See ~RouteSnapshot for the format.
+     * @throws Exception if the file could not be written
+     */
+    void snapshot(const std::string& path) const;
+
+    /**
+     * Adds the routes from a snapshot that has been written by RoutingTable::snapshot to this table.
+     * Each pheromone value is evaporated by the age it had when the snapshot has been taken plus the
+     * (wall clock) time that has passed since then, so stale routes decay like they would have in a
+     * running table. Routes that have evaporated completely are not restored.
+     * @return the number of restored routes
+     * @throws Exception if the file could not be read or is not a valid snapshot
+     */
+    unsigned int restore(const std::string& path, RouteSnapshotResolver* resolver);
+
     /**
      * Triggers the evaporation process if enough time since the last evaporation has passed.
      */
-    void triggerEvaporation();
+    virtual void triggerEvaporation();
 
     /**
      * Returns all known routes that lead over the given next hop.
+     * This only needs to look at the destinations that are registered for this
+     * next hop in the RoutingTable::nextHopIndex.
      */
-    std::deque<RoutingTableEntryTupel> getAllRoutesThatLeadOver(AddressPtr nextHop) const;
+    virtual std::deque<RoutingTableEntryTupel> getAllRoutesThatLeadOver(AddressPtr nextHop) const;
 
 private:
     void applyEvaporation(Time* currentTime);
 
+    /**
+     * Throws an Exception with the given message if an alternative layout is used. This guards
+     * all methods which use the RoutingTable::table, so an alternative layout that misses to
+     * override one of them fails loudly instead of dereferencing a null pointer.
+     */
+    void requireStandardLayout(const char* message) const;
+
+    /**
+     * Evaporates all routes of the given destination and deletes the ones whose pheromone
+     * value has dropped to zero.
+     * @return true if there are no routes left for the destination
+     */
+    bool evaporateRoutes(AddressPtr destination, DestinationRoutes* routes);
+
+    void addToAggregates(DestinationRoutes* routes, RoutingTableEntry* entry);
+    void updateAggregates(DestinationRoutes* routes, RoutingTableEntry* entry, float oldPheromoneValue);
+
+    /**
+     * Updates the PheromoneAggregates of the given destination after the given entry has been
+     * removed from its routes (but before it is deleted).
+     */
+    void removeFromAggregates(DestinationRoutes* routes, RoutingTableEntry* entry);
+    void recomputeAggregates(DestinationRoutes* routes);
+
 protected:
+    /**
+     * The number of buckets that are visited by the background pass of the lazy evaporation
+     * each time RoutingTable::triggerEvaporation is called.
+     */
+    static const unsigned int NR_OF_BUCKETS_PER_LAZY_EVAPORATION = 4;
+
     bool hasTableBeenAccessedEarlier();
+
+    /**
+     * Updates the given PheromoneAggregates after the given entry has been added to the end of the routes.
+     */
+    static void addToAggregates(PheromoneAggregates& aggregates, RoutingTableEntry* entry);
+
+    /**
+     * Updates the given PheromoneAggregates after the pheromone value of the given entry has been changed.
+     * @return false if the aggregates have to be recomputed from all routes of the destination
+     */
+    static bool updateAggregates(PheromoneAggregates& aggregates, RoutingTableEntry* entry, float oldPheromoneValue);
+
+    /**
+     * Resets the given PheromoneAggregates to those of a destination without any routes.
+     */
+    static void resetAggregates(PheromoneAggregates& aggregates);
+
+    /**
+     * Evicts routes (via RoutingTable::removeEvictedRoute) until a new route fits into the table.
+     * Each implementation must call this before it adds a new route and has to report all added,
+     * updated and removed routes to the RoutingTable::eviction.
+     */
+    void makeRoomForNewEntry();
+
+    /**
+     * Notifies the listener about all evicted routes. This is called as soon as the update which
+     * made room for a new route has been completed.
+     */
+    void notifyEvictionListener() {
+        eviction.notifyListener();
+    }
+
+    /**
+     * Returns the entry of the given route without applying any pending evaporation
+     * or nullptr if the route does not exist.
+     */
+    virtual RoutingTableEntry* findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface);
+
+    /**
+     * Removes a route that has been chosen by the RoutingTable::eviction. This is called while
+     * the table is in the middle of an update, so implementations must neither notify anybody nor
+     * acquire any lock here.
+     */
+    virtual void removeEvictedRoute(const RouteEviction::Route& route);
+
+    /**
+     * Returns true if the lazy evaporation is activated and supported by the evaporation policy.
+     */
+    bool isLazyEvaporationUsed() const;
+
+    /**
+     * Returns the routes to the given destination or nullptr if there are none.
+     * If the lazy evaporation is used, all pending evaporation is applied to the routes first.
+     */
+    RoutingTableEntryList* findEntries(const AddressPtr& destination);
+
+    /**
+     * Works like RoutingTable::findEntries but returns the routes together with their aggregates.
+     */
+    DestinationRoutes* findRoutes(const AddressPtr& destination);
+
+    /**
+     * Discards the cached cumulative selection weights of the given destination, or of all
+     * destinations if routes is nullptr (see RoutingTable::getSelectionWeight).
+     */
+    void invalidateSelectionWeights(DestinationRoutes* routes);
+
+    /**
+     * Evaporates the pheromone value of the given entry by the time that has passed since its
+     * timestamp (see RoutingTableEntry::getTimestamp) and sets the timestamp to the current time.
+     * @return false if the pheromone value has dropped to zero and the entry needs to be deleted
+     */
+    bool evaporateEntry(RoutingTableEntry* entry);
+
+    /**
+     * Evaporates all entries in the next nrOfBuckets buckets of this table, starting at the
+     * RoutingTable::evaporationCursor, and deletes all entries whose pheromone value has dropped
+     * to zero. Each entry is evaporated by the time that has passed since its own timestamp.
+     */
+    virtual void evaporateBuckets(unsigned int nrOfBuckets);
     virtual void updateExistingEntry(RoutingTableEntry* oldEntry, RoutingTableEntry* newEntry);
+
+    /**
+     * Applies the evaporation policy to all entries of this table and deletes all
+     * entries whose pheromone value has dropped to zero. All pheromone values are
+     * evaporated in a single batch.
+     * This is called by RoutingTable::triggerEvaporation if the evaporation policy
+     * decides that an evaporation is necessary.
+     */
+    virtual void evaporateEntries(long timeDifference);
+
+    /**
+     * Does the actual work for RoutingTable::getEntryAt. This is a separate method
+     * because the EnergyAwareRoutingTable hides getEntryAt with its own return type
+     * while alternative table layouts still need to provide their own lookup.
+     */
+    virtual RoutingTableEntryTupel findEntryAt(int wantedPosition) const;
+
+    /**
+     * Moves the given position to the first route of this table.
+     * @return false if the table is empty
+     */
+    virtual bool moveToFirstEntry(IteratorPosition& position) const;
+
+    /**
+     * Moves the given position to the next route of this table.
+     * @return false if there are no more routes
+     */
+    virtual bool moveToNextEntry(IteratorPosition& position) const;
+
+    virtual RoutingTableEntryTupel getEntryAtPosition(const IteratorPosition& position) const;
+
+    /**
+     * Registers a new route to the given destination over the given next hop in the
+     * RoutingTable::nextHopIndex. This must be called by each implementation whenever
+     * a route is added to the table.
+     */
+    void addToNextHopIndex(const AddressPtr& destination, const AddressPtr& nextHop);
+
+    /**
+     * Removes a route to the given destination over the given next hop from the
+     * RoutingTable::nextHopIndex. This must be called by each implementation whenever
+     * a route is removed from the table (this includes evaporation).
+     */
+    void removeFromNextHopIndex(const AddressPtr& destination, const AddressPtr& nextHop);
+
+    /**
+     * Tells all existing ~RouteHandle objects that the routes they are bound to may have moved.
+     * This is already done whenever a route is added to or removed from the RoutingTable::nextHopIndex,
+     * so implementations only need to call this if they move routes without adding or removing any.
+     */
+    void invalidateRouteHandles() {
+        routeGeneration.fetch_add(1, std::memory_order_relaxed);
+    }
+
     Time* lastAccessTime;
 
-    RoutingTableMap table;
+    /**
+     * The number of milliseconds between the first and the latest call to RoutingTable::triggerEvaporation.
+     * This is only updated if the lazy or incremental evaporation is used and serves as time base
+     * for the timestamps of all entries.
+     */
+    long currentTimestamp;
+
+    /**
+     * The bucket at which the next incremental evaporation (or background pass of the lazy evaporation) continues.
+     */
+    size_t evaporationCursor;
+    bool lazyEvaporation;
+    unsigned int maxNrOfBucketsPerEvaporation;
+
+    /**
+     * The routes of the standard layout or nullptr if an alternative layout is used.
+     */
+    RoutingTableMap* table;
+
+    /**
+     * This secondary index maps each next hop to all destinations which can be reached over it.
+     * The number of routes is counted for each destination because the same next hop may be
+     * used over more than one interface.
+     */
+    NextHopIndex nextHopIndex;
+
+    /**
+     * See RoutingTable::getRouteGeneration. This is atomic because the ~ConcurrentRoutingTable
+     * changes it while other threads check their handles.
+     */
+    std::atomic<unsigned long> routeGeneration;
 
     /**
      * The memory management of the evaporationPolicy member is handled in class
@@ -108,6 +510,17 @@ protected:
      */
     EvaporationPolicy* evaporationPolicy;
 
+    /**
+     * Limits the number of routes in this table (see RoutingTable::setMaxNrOfEntries).
+     */
+    RouteEviction eviction;
+
+    /**
+     * The buffer in which RoutingTable::evaporateEntries collects the pheromone values of all
+     * routes for the batch evaporation (see EvaporationPolicy::evaporate). It is kept to avoid
+     * an allocation per sweep.
+     */
+    std::vector<float> pheromoneValues;
 };
 
 ARA_NAMESPACE_END
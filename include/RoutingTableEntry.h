@@ -9,29 +9,65 @@
 #include "NextHop.h"
 #include "NetworkInterface.h"
 
+#include <atomic>
 #include <iostream>
 
 ARA_NAMESPACE_BEGIN
 
 class RoutingTableEntry {
     public:
+        /**
+         * The eviction queue position of an entry whose route is not tracked by a ~RouteEviction.
+         */
+        static const unsigned int NOT_TRACKED = (unsigned int) -1;
+
         RoutingTableEntry(std::shared_ptr<Address> address, NetworkInterface* interface, float pheromoneValue);
+        RoutingTableEntry(const RoutingTableEntry& other);
+        RoutingTableEntry& operator=(const RoutingTableEntry& other);
         virtual ~RoutingTableEntry();
 
         NextHop* getNextHop();
-        std::shared_ptr<Address> getAddress();
+        const std::shared_ptr<Address>& getAddress();
         NetworkInterface* getNetworkInterface();
         float getPheromoneValue();
         void setPheromoneValue(float newPheromoneValue);
 
+        /**
+         * Returns the time (in milliseconds since the routing table has been accessed for the first time)
+         * at which the pheromone value of this entry has been set or evaporated the last time.
+         * This is only used by the lazy evaporation of the ~RoutingTable.
+         */
+        long getTimestamp();
+        void setTimestamp(long newTimestamp);
+
+        /**
+         * Returns the position of the node of this route in the ~RouteEviction queue of its table.
+         * The position is copied together with the entry.
+         */
+        unsigned int getEvictionQueuePosition() const {
+            return evictionQueuePosition;
+        }
+
+        void setEvictionQueuePosition(unsigned int position) {
+            evictionQueuePosition = position;
+        }
+
         friend std::ostream& operator<<(std::ostream& out, RoutingTableEntry& entry) {
             out << "[next hop] " << entry.getAddress()->toString() << " [phi] " << entry.getPheromoneValue();
             return out;
         }
 
     private:
-        NextHop* nextHop;
-        float pheromoneValue;
+        NextHop nextHop;
+
+        /**
+         * The pheromone value and timestamp are atomic because the ~ConcurrentRoutingTable updates
+         * them in place while other threads read them. All accesses are relaxed, so this costs
+         * nothing compared to plain fields on the common platforms.
+         */
+        std::atomic<float> pheromoneValue;
+        unsigned int evictionQueuePosition;
+        std::atomic<long> timestamp;
 };
 
 ARA_NAMESPACE_END
@@ -0,0 +1,80 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef SEQUENCE_NUMBER_WINDOW_H_
+#define SEQUENCE_NUMBER_WINDOW_H_
+
+#include "ARAMacros.h"
+
+#include <cstdint>
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * The SequenceNumberWindow remembers which sequence numbers of a single source have been received.
+ * Only the last SequenceNumberWindow::SIZE sequence numbers up to the highest one that has been
+ * received so far are remembered in a bitmap, so each window needs constant memory and each
+ * lookup and insertion takes constant (amortized) time.
+ *
+ * Sequence numbers are compared in serial number arithmetic (RFC 1982), so the window keeps
+ * working when the sequence numbers of the source wrap around. Sequence numbers which are older
+ * than the window can not be told apart from duplicates anymore. They are not contained in the
+ * window, but the client may check isOutdated(..) to decide what to do with them.
+ */
+class SequenceNumberWindow {
+    public:
+        /**
+         * The number of sequence numbers which are remembered (must be a multiple of 64).
+         */
+        static const unsigned int SIZE = 1024;
+
+        SequenceNumberWindow();
+
+        /**
+         * Returns true if the given sequence number has been inserted before and is still
+         * remembered by this window.
+         */
+        bool contains(unsigned int sequenceNumber) const;
+
+        /**
+         * Returns true if the given sequence number is too old to be remembered by this window,
+         * so it is unknown whether it has been inserted before.
+         */
+        bool isOutdated(unsigned int sequenceNumber) const;
+
+        /**
+         * Remembers the given sequence number. If it is newer than all sequence numbers that
+         * have been inserted before, the window is moved forward and forgets the sequence
+         * numbers that fall out of it.
+         */
+        void insert(unsigned int sequenceNumber);
+
+    private:
+        /**
+         * Returns how many sequence numbers the given one lies behind the highest sequence number
+         * (negative if it is newer than the highest one).
+         */
+        int32_t getDistanceToHighestSequenceNumber(unsigned int sequenceNumber) const;
+
+        bool isSet(unsigned int sequenceNumber) const;
+        void set(unsigned int sequenceNumber);
+
+        /**
+         * Clears the bits of the given number of sequence numbers that follow the highest one.
+         */
+        void clearAfterHighestSequenceNumber(unsigned int nrOfSequenceNumbers);
+
+        static const unsigned int NR_OF_WORDS = SIZE / 64;
+
+        /**
+         * The bitmap is a ring buffer: The bit of a sequence number is at position sequenceNumber % SIZE.
+         */
+        uint64_t bits[NR_OF_WORDS];
+        unsigned int highestSequenceNumber;
+        bool isEmpty;
+};
+
+ARA_NAMESPACE_END
+
+#endif /* SEQUENCE_NUMBER_WINDOW_H_ */
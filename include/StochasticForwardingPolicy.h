@@ -11,10 +11,10 @@
 #include "Packet.h"
 #include "RoutingTable.h"
 #include "Exception.h"
+#include "RandomNumberGenerator.h"
 
 #include <deque>
 #include <vector>
-#include <numeric>
 
 ARA_NAMESPACE_BEGIN
 
@@ -27,11 +27,18 @@ class StochasticForwardingPolicy : public virtual ForwardingPolicy {
          */
         virtual NextHop* getNextHop(const Packet* packet);
 
+        virtual void initializeRandomNumberGenerator(uint64_t seed, uint64_t stream=0);
+
     protected:
         RoutingTable* routingTable;
 
-        void initializeRandomNumberGenerator(unsigned int seed=((unsigned)time(0)));
-        float getRandomNumber();
+        /**
+         * Returns a random number between 0 and 1 from the random number generator of this policy.
+         */
+        virtual float getRandomNumber();
+
+    private:
+        RandomNumberGenerator randomNumberGenerator;
 };
 
 ARA_NAMESPACE_END
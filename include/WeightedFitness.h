@@ -0,0 +1,53 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef WEIGHTED_FITNESS_H_
+#define WEIGHTED_FITNESS_H_
+
+#include "ARAMacros.h"
+
+ARA_NAMESPACE_BEGIN
+
+/**
+ * Calculates the weighted fitness pheromoneValue^pheromoneWeight * energyValue^energyWeight
+ * which determines the probability with which EARA chooses a route.
+ *
+ * The weights are analyzed once when they are set. Integer and half-integer weights
+ * (like the default weights 1 and 2) are then calculated with a few multiplications
+ * and at most one square root instead of calling pow.
+ */
+class WeightedFitness {
+    public:
+        WeightedFitness(float pheromoneWeight=1.0, float energyWeight=2.0);
+
+        float calculate(float pheromoneValue, float energyValue) const;
+
+        float getPheromoneWeight() const;
+        float getEnergyWeight() const;
+        void setPheromoneWeight(float pheromoneWeight);
+        void setEnergyWeight(float energyWeight);
+
+        bool operator==(const WeightedFitness& other) const;
+        bool operator!=(const WeightedFitness& other) const;
+
+    private:
+        struct Exponent {
+            float value;
+
+            /** true if the value is a non negative multiple of 0.5 that is small enough to be multiplied out */
+            bool isHalfInteger;
+            unsigned int integerPart;
+            bool hasHalf;
+        };
+
+        static Exponent makeExponent(float value);
+        static float power(float base, const Exponent& exponent);
+
+        Exponent pheromoneExponent;
+        Exponent energyExponent;
+};
+
+ARA_NAMESPACE_END
+
+#endif
@@ -19,7 +19,8 @@ class EARAPacketFactory : public ::ARA::EARAPacketFactory {
         void setMaxHopCount(int newMaxHopCount);
 
     protected:
-        virtual EARAPacket* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0, AddressPtr previousHop=nullptr);
+        virtual std::size_t getPacketSize() const;
+        virtual EARAPacket* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload=PayloadBuffer(), AddressPtr previousHop=nullptr);
 
     private:
         int calculatePacketSize(Packet* packet);
@@ -15,9 +15,9 @@ class EARARoutingTableWatcher : public RoutingTableWatcher {
     public:
         EARARoutingTableWatcher(EnergyAwareRoutingTable* table);
 
-        virtual std::string at(int i) const;
-
     protected:
+        virtual void renderEntries() const;
+
         EnergyAwareRoutingTable* table;
 };
 
@@ -13,6 +13,11 @@
 
 OMNETARA_NAMESPACE_BEGIN
 
+/**
+ * An OMNeTAddress must not be changed once its id has been requested from the AddressTable,
+ * so the setters of the IPv4Address are hidden. Please note that the value can still be changed
+ * through a reference to the IPv4Address base, which must not be done either.
+ */
 class OMNeTAddress : public Address, public IPv4Address {
 public:
 
@@ -49,6 +54,9 @@ public:
     bool equals(const IPv4Address& ipAddress) const {return IPv4Address::equals(ipAddress);}
 
     size_t getHashValue() const;
+
+private:
+    using IPv4Address::set;
 };
 
 OMNETARA_NAMESPACE_END
@@ -32,12 +32,21 @@ class OMNeTConfiguration : public virtual Configuration {
         virtual unsigned int getMaxNeighborInactivityTimeInMilliSeconds();
         virtual unsigned int getPANTIntervalInMilliSeconds();
         virtual bool isPreviousHopFeatureActivated();
+        virtual bool isLazyEvaporationActivated();
+        virtual unsigned int getMaxNrOfBucketsPerEvaporation();
+        virtual unsigned int getMaxNrOfRoutingTableEntries();
+        virtual bool isPheromoneAwareEvictionActivated();
+        virtual unsigned int getRandomNumberGeneratorSeed();
+        virtual unsigned int getRandomNumberGeneratorStream();
+        virtual unsigned int getFlowCacheDwellTimeInMilliSeconds();
+        virtual float getFlowCachePheromoneShiftThreshold();
 
         Logger* getLogger();
 
     protected:
         cModule* getHostModule();
         void setLogLevel(const char* logLevelParameter);
+        RoutingTable* createRoutingTable(const char* routingTableParameter);
 
     protected:
         RoutingTable* routingTable;
@@ -53,6 +62,14 @@ class OMNeTConfiguration : public virtual Configuration {
         unsigned int maxNeighborInactivityTimeInMilliSeconds;
         unsigned int pantIntervalInMilliSeconds;
         bool previousHopFeatureIsActivated;
+        bool lazyEvaporationIsActivated;
+        unsigned int maxNrOfBucketsPerEvaporation;
+        unsigned int maxNrOfRoutingTableEntries;
+        bool pheromoneAwareEvictionIsActivated;
+        unsigned int randomNumberGeneratorSeed;
+        unsigned int randomNumberGeneratorStream;
+        unsigned int flowCacheDwellTimeInMilliSeconds;
+        float flowCachePheromoneShiftThreshold;
 
         cModule* simpleModule;
         OMNeTLogger* logger;
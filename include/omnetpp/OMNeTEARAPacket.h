@@ -22,7 +22,7 @@ class OMNeTEARAPacket : public cPacket, public EARAPacket {
     bool operator==(const OMNeTEARAPacket&);
 
   public:
-    OMNeTEARAPacket(AddressPtr source=nullptr, AddressPtr destination=nullptr, AddressPtr sender=nullptr, char type=0, unsigned int seqNr=0, int ttl=50, const char* payload=nullptr, unsigned int payloadSize=0);
+    OMNeTEARAPacket(AddressPtr source=nullptr, AddressPtr destination=nullptr, AddressPtr sender=nullptr, char type=0, unsigned int seqNr=0, int ttl=50, const PayloadBuffer& payload=PayloadBuffer());
     OMNeTEARAPacket(const OMNeTEARAPacket& other);
     OMNeTEARAPacket& operator=(const OMNeTEARAPacket& other);
     virtual OMNeTEARAPacket *dup() const {return new OMNeTEARAPacket(*this);}
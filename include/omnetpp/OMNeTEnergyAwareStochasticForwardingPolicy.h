@@ -13,8 +13,8 @@ OMNETARA_NAMESPACE_BEGIN
 
 /**
 * The class provides a energy aware stochastic forwarding policy for class ARA. The
-* class overwrites the getRandomNumber() method of the base class. It uses a
-* pseudo-random number generator provided by OMNeT++.
+* random number generator is seeded by the EARA module (see parameters
+* randomNumberGeneratorSeed and randomNumberGeneratorStream).
 *
 * OMNeT++ does only support the standard constructor for its SimpleModules.
 * This class implements that and adds a setRoutingTable method which
@@ -29,11 +29,6 @@ class OMNeTEnergyAwareStochasticForwardingPolicy : public EnergyAwareStochasticF
          */
         void setRoutingTable(EnergyAwareRoutingTable* routingTable);
     protected:
-        /**
-        *  The method returns a random number which uses OMNeT++ pseudo random number generators
-        */
-        float getRandomNumber();
-
         virtual void initialize();
 };
 
@@ -14,8 +14,8 @@ OMNETARA_NAMESPACE_BEGIN
 
 /**
 * The class provides a stochastic forwarding policy for class OMNeTARA. The
-* class overwrites the getRandomNumber() method of the base class. It uses a
-* pseudo-random number generator provided by OMNeT++.
+* random number generator is seeded by the ARA module (see parameters
+* randomNumberGeneratorSeed and randomNumberGeneratorStream).
 *
 * OMNeT++ does only support the standard constructor for its SimpleModules.
 * This class implements that and adds a setRoutingTable method which
@@ -29,12 +29,6 @@ class OMNeTStochasticForwardingPolicy : public StochasticForwardingPolicy, publi
          * This must be called after the constructor, because stupid OMNeT++ does only allow standard constructors...
          */
         void setRoutingTable(RoutingTable* routingTable);
-
-    protected:
-        /**
-         * Returns a random number which uses OMNeT++ pseudo random number generators.
-         */
-        virtual float getRandomNumber();
 };
 
 OMNETARA_NAMESPACE_END
@@ -19,7 +19,8 @@ public:
     PacketFactory(int maxHopCount) : ::ARA::PacketFactory(maxHopCount) {};
 
 protected:
-    virtual Packet* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload=nullptr, unsigned int payloadSize=0, AddressPtr previousHop=nullptr);
+    virtual std::size_t getPacketSize() const;
+    virtual Packet* makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload=PayloadBuffer(), AddressPtr previousHop=nullptr);
 
 private:
     int calculatePacketSize(Packet* packet);
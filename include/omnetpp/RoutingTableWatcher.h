@@ -8,6 +8,9 @@
 #include "OMNeTARAMacros.h"
 #include "RoutingTable.h"
 
+#include <string>
+#include <vector>
+
 OMNETARA_NAMESPACE_BEGIN
 
 class RoutingTableWatcher : public cStdVectorWatcherBase {
@@ -20,7 +23,18 @@ class RoutingTableWatcher : public cStdVectorWatcherBase {
         virtual std::string at(int i) const;
 
     protected:
+        /**
+         * Renders all entries of the routing table into RoutingTableWatcher::renderedEntries.
+         */
+        virtual void renderEntries() const;
+
         RoutingTable* table;
+
+        /**
+         * The inspector asks for all entries one after another so they are all rendered
+         * in a single pass over the table when the first entry is requested.
+         */
+        mutable std::vector<std::string> renderedEntries;
 };
 
 OMNETARA_NAMESPACE_END
@@ -7,8 +7,12 @@
 
 OMNETARA_NAMESPACE_BEGIN
 
-EARAPacket* EARAPacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize, AddressPtr previousHop) {
-    OMNeTEARAPacket* packet = new OMNeTEARAPacket(source, destination, sender, type, seqNr, ttl, payload, payloadSize);
+std::size_t EARAPacketFactory::getPacketSize() const {
+    return sizeof(OMNeTEARAPacket);
+}
+
+EARAPacket* EARAPacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload, AddressPtr previousHop) {
+    OMNeTEARAPacket* packet = new OMNeTEARAPacket(source, destination, sender, type, seqNr, ttl, payload);
 
     if(isPreviousHopFeatureEnabled && previousHop != nullptr) {
         packet->setPreviousHop(previousHop);
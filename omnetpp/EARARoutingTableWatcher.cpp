@@ -10,14 +10,12 @@ EARARoutingTableWatcher::EARARoutingTableWatcher(EnergyAwareRoutingTable* table)
     this->table = table;
 }
 
-string EARARoutingTableWatcher::at(int wantedPosition) const {
-    stringstream out;
-
-    EARARoutingTableEntryTupel entryTupel = table->getEntryAt(wantedPosition);
-    AddressPtr destination = entryTupel.destination;
-    EARARoutingTableEntry* entry = entryTupel.entry;
-    out << "[destination] " << destination->toString() << " " << *entry;
-    return out.str();
+void EARARoutingTableWatcher::renderEntries() const {
+    table->forEachEntry([this](const AddressPtr& destination, EARARoutingTableEntry* entry) {
+        stringstream out;
+        out << "[destination] " << destination->toString() << " " << *entry;
+        renderedEntries.push_back(out.str());
+    });
 }
 
 OMNETARA_NAMESPACE_END
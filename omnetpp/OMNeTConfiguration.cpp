@@ -8,6 +8,8 @@
 #include "EvaporationPolicy.h"
 #include "PathReinforcementPolicy.h"
 #include "ForwardingPolicy.h"
+#include "FlatRoutingTable.h"
+#include "ConcurrentRoutingTable.h"
 #include "IPvXAddressResolver.h"
 #include "IInterfaceTable.h"
 #include "ModuleAccess.h"
@@ -27,16 +29,30 @@ OMNeTConfiguration::OMNeTConfiguration(cModule* module, RoutingTable* routingTab
     maxNeighborInactivityTimeInMilliSeconds = module->par("maxNeighborInactivityTime").longValue();
     pantIntervalInMilliSeconds = module->par("pantInterval").longValue();
     previousHopFeatureIsActivated  = module->par("previousHopFeature").boolValue();
+    lazyEvaporationIsActivated = module->par("lazyEvaporation").boolValue();
+    maxNrOfBucketsPerEvaporation = module->par("maxNrOfBucketsPerEvaporation").longValue();
+    maxNrOfRoutingTableEntries = module->par("maxNrOfRoutingTableEntries").longValue();
+    pheromoneAwareEvictionIsActivated = module->par("pheromoneAwareEviction").boolValue();
+    randomNumberGeneratorSeed = module->par("randomNumberGeneratorSeed").longValue();
+    flowCacheDwellTimeInMilliSeconds = module->par("flowCacheDwellTime").longValue();
+    flowCachePheromoneShiftThreshold = module->par("flowCachePheromoneShiftThreshold").doubleValue();
 
     // load child modules
     simpleModule = module;
+
+    // by default each node uses its own stream
+    long randomNumberGeneratorStreamParameter = module->par("randomNumberGeneratorStream").longValue();
+    if (randomNumberGeneratorStreamParameter < 0) {
+        randomNumberGeneratorStreamParameter = getHostModule()->getId();
+    }
+    randomNumberGeneratorStream = randomNumberGeneratorStreamParameter;
     evaporationPolicy = ModuleAccess<EvaporationPolicy>("evaporationPolicy").get();
     reinforcementPolicy = ModuleAccess<PathReinforcementPolicy>("reinforcementPolicy").get();
 
     // configure the routingTable
     if (routingTable == nullptr) {
         //TODO why not set the evaporation policy right in the ctor?
-        routingTable = new RoutingTable();
+        routingTable = createRoutingTable(module->par("routingTable").stringValue());
     }
     this->routingTable = routingTable;
     this->routingTable->setEvaporationPolicy(evaporationPolicy);
@@ -74,6 +90,21 @@ void OMNeTConfiguration::setLogLevel(const char* logLevelParameter) {
     }
 }
 
+RoutingTable* OMNeTConfiguration::createRoutingTable(const char* routingTableParameter) {
+    if (strcmp(routingTableParameter, "RoutingTable") == 0) {
+        return new RoutingTable();
+    }
+    else if (strcmp(routingTableParameter, "FlatRoutingTable") == 0) {
+        return new FlatRoutingTable();
+    }
+    else if (strcmp(routingTableParameter, "ConcurrentRoutingTable") == 0) {
+        return new ConcurrentRoutingTable();
+    }
+    else {
+        throw cRuntimeError("Invalid routing table '%s'", routingTableParameter);
+    }
+}
+
 EvaporationPolicy* OMNeTConfiguration::getEvaporationPolicy() {
     return evaporationPolicy;
 }
@@ -142,4 +173,36 @@ bool OMNeTConfiguration::isPreviousHopFeatureActivated() {
     return previousHopFeatureIsActivated;
 }
 
+bool OMNeTConfiguration::isLazyEvaporationActivated() {
+    return lazyEvaporationIsActivated;
+}
+
+unsigned int OMNeTConfiguration::getMaxNrOfBucketsPerEvaporation() {
+    return maxNrOfBucketsPerEvaporation;
+}
+
+unsigned int OMNeTConfiguration::getMaxNrOfRoutingTableEntries() {
+    return maxNrOfRoutingTableEntries;
+}
+
+bool OMNeTConfiguration::isPheromoneAwareEvictionActivated() {
+    return pheromoneAwareEvictionIsActivated;
+}
+
+unsigned int OMNeTConfiguration::getRandomNumberGeneratorSeed() {
+    return randomNumberGeneratorSeed;
+}
+
+unsigned int OMNeTConfiguration::getRandomNumberGeneratorStream() {
+    return randomNumberGeneratorStream;
+}
+
+unsigned int OMNeTConfiguration::getFlowCacheDwellTimeInMilliSeconds() {
+    return flowCacheDwellTimeInMilliSeconds;
+}
+
+float OMNeTConfiguration::getFlowCachePheromoneShiftThreshold() {
+    return flowCachePheromoneShiftThreshold;
+}
+
 OMNETARA_NAMESPACE_END
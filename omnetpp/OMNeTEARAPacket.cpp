@@ -27,13 +27,13 @@ void doUnpacking(cCommBuffer *, T& t) {
 
 Register_Class(OMNeTEARAPacket);
 
-OMNeTEARAPacket::OMNeTEARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize)
+OMNeTEARAPacket::OMNeTEARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload)
 : cPacket(PacketType::getAsString(type).c_str(), type),
-  ARA::EARAPacket(source, destination, sender, type, seqNr, ttl, payload, payloadSize) {
+  ARA::EARAPacket(source, destination, sender, type, seqNr, ttl, payload) {
 
 }
 
-OMNeTEARAPacket::OMNeTEARAPacket(const OMNeTEARAPacket& other) : cPacket(other), ARA::EARAPacket(other.source, other.destination, other.sender, other.type, other.seqNr, other.ttl, other.payload, other.payloadSize) {
+OMNeTEARAPacket::OMNeTEARAPacket(const OMNeTEARAPacket& other) : cPacket(other), ARA::EARAPacket(other.source, other.destination, other.sender, other.type, other.seqNr, other.ttl, other.payload) {
     copy(other);
 }
 
@@ -52,7 +52,6 @@ void OMNeTEARAPacket::copy(const OMNeTEARAPacket& other) {
     this->type = other.type;
     this->seqNr = other.seqNr;
     this->payload = other.payload;
-    this->payloadSize = other.payloadSize;
     this->ttl = other.ttl;
     this->minEnergyValue = other.minEnergyValue;
     this->totalEnergyValue = other.totalEnergyValue;
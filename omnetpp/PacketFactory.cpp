@@ -7,8 +7,12 @@
 
 OMNETARA_NAMESPACE_BEGIN
 
-Packet* PacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize, AddressPtr previousHop) {
-    OMNeTPacket* packet = new OMNeTPacket(source, destination, sender, type, seqNr, ttl, payload, payloadSize);
+std::size_t PacketFactory::getPacketSize() const {
+    return sizeof(OMNeTPacket);
+}
+
+Packet* PacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload, AddressPtr previousHop) {
+    OMNeTPacket* packet = new OMNeTPacket(source, destination, sender, type, seqNr, ttl, payload);
 
     if(isPreviousHopFeatureEnabled && previousHop != nullptr) {
         packet->setPreviousHop(previousHop);
@@ -66,13 +66,11 @@ void RoutingTableDataPersistor::write(RoutingTable* routingTable) {
             int nrOfEntries = routingTable->getTotalNumberOfEntries();
             file.write((char*)&nrOfEntries, 1);
 
-            for (int i = 0; i < nrOfEntries; i++) {
-                RoutingTableEntryTupel entryTupel = routingTable->getEntryAt(i); // FIXME getEntryAt is very inefficient. This function is called very often so it better use something with better performance
-                OMNeTAddress* destination = dynamic_cast<OMNeTAddress*>(entryTupel.destination.get());
+            routingTable->forEachEntry([this](const AddressPtr& destinationAddress, RoutingTableEntry* entry) {
+                OMNeTAddress* destination = dynamic_cast<OMNeTAddress*>(destinationAddress.get());
                 if (destination) {
                     uint32 destinationInt = destination->getInt();
 
-                    RoutingTableEntry* entry = entryTupel.entry;
                     OMNeTAddress* nextHop = dynamic_cast<OMNeTAddress*>(entry->getAddress().get());
                     if (nextHop) {
                         uint32 nextHopInt = nextHop->getInt();
@@ -84,7 +82,7 @@ void RoutingTableDataPersistor::write(RoutingTable* routingTable) {
                         file.write((char*)&pheromoneValue, sizeof(pheromoneValue));
                     }
                 }
-            } 
+            });
 
             delete lastWriteTime;
             lastWriteTime = currentTime;
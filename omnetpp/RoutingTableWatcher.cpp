@@ -21,13 +21,23 @@ int RoutingTableWatcher::size() const {
 }
 
 string RoutingTableWatcher::at(int wantedPosition) const {
-    stringstream out;
+    if (wantedPosition == 0 || wantedPosition >= (int) renderedEntries.size()) {
+        renderedEntries.clear();
+        renderEntries();
+    }
+
+    if (wantedPosition < (int) renderedEntries.size()) {
+        return renderedEntries[wantedPosition];
+    }
+    return "";
+}
 
-    RoutingTableEntryTupel entryTupel = table->getEntryAt(wantedPosition);
-    AddressPtr destination = entryTupel.destination;
-    RoutingTableEntry* entry = entryTupel.entry;
-    out << "[destination] " << destination->toString() << " " << *entry;
-    return out.str();
+void RoutingTableWatcher::renderEntries() const {
+    table->forEachEntry([this](const AddressPtr& destination, RoutingTableEntry* entry) {
+        stringstream out;
+        out << "[destination] " << destination->toString() << " " << *entry;
+        renderedEntries.push_back(out.str());
+    });
 }
 
 OMNETARA_NAMESPACE_END
@@ -8,10 +8,6 @@ OMNETARA_NAMESPACE_BEGIN
 
 Define_Module(OMNeTEnergyAwareStochasticForwardingPolicy);
 
-float OMNeTEnergyAwareStochasticForwardingPolicy::getRandomNumber(){
-    return dblrand();
-}
-
 void OMNeTEnergyAwareStochasticForwardingPolicy::initialize(){
     setPheromoneWeight(par("alpha").doubleValue());
     setEnergyWeight(par("beta").doubleValue());
@@ -8,10 +8,6 @@ OMNETARA_NAMESPACE_BEGIN
 
 Define_Module(OMNeTStochasticForwardingPolicy);
 
-float OMNeTStochasticForwardingPolicy::getRandomNumber(){
-   return dblrand();
-}
-
 void OMNeTStochasticForwardingPolicy::setRoutingTable(RoutingTable* routingTable) {
     this->routingTable = routingTable;
 }
@@ -20,9 +20,15 @@ AbstractARAClient::AbstractARAClient(Configuration& configuration) {
 
 void AbstractARAClient::initialize(Configuration& configuration) {
     routingTable = configuration.getRoutingTable();
+    routingTable->setLazyEvaporation(configuration.isLazyEvaporationActivated());
+    routingTable->setMaxNrOfBucketsPerEvaporation(configuration.getMaxNrOfBucketsPerEvaporation());
+    routingTable->setMaxNrOfEntries(configuration.getMaxNrOfRoutingTableEntries());
+    routingTable->setPheromoneAwareEviction(configuration.isPheromoneAwareEvictionActivated());
+    routingTable->setEvictionListener(this);
     packetFactory = configuration.getPacketFactory();
     packetFactory->setPreviousHopFeature(isPreviousHopFeatureActivated);
     forwardingPolicy = configuration.getForwardingPolicy();
+    forwardingPolicy->initializeRandomNumberGenerator(configuration.getRandomNumberGeneratorSeed(), configuration.getRandomNumberGeneratorStream());
     pathReinforcementPolicy = configuration.getReinforcementPolicy();
     evaporationPolicy = configuration.getEvaporationPolicy();
     initialPheromoneValue = configuration.getInitialPheromoneValue();
@@ -34,8 +40,12 @@ void AbstractARAClient::initialize(Configuration& configuration) {
     pantIntervalInMilliSeconds = configuration.getPANTIntervalInMilliSeconds();
     isPreviousHopFeatureActivated = configuration.isPreviousHopFeatureActivated();
 
+    unsigned int flowCacheDwellTimeInMilliSeconds = configuration.getFlowCacheDwellTimeInMilliSeconds();
+    if (flowCacheDwellTimeInMilliSeconds > 0) {
+        flowCache = new FlowCache(flowCacheDwellTimeInMilliSeconds, configuration.getFlowCachePheromoneShiftThreshold());
+    }
+
     packetTrap = new PacketTrap(routingTable);
-    runningRouteDiscoveries = RunningRouteDiscoveriesMap();
 
     if (neighborActivityCheckIntervalInMilliSeconds > 0) {
        neighborActivityTimer = getNewTimer(TimerType::NEIGHBOR_ACTIVITY_TIMER);
@@ -45,26 +55,19 @@ void AbstractARAClient::initialize(Configuration& configuration) {
 }
 
 AbstractARAClient::~AbstractARAClient() {
-    // delete the sequence number lists of the last received packets
-    for (LastReceivedPacketsMap::iterator iterator=lastReceivedPackets.begin(); iterator!=lastReceivedPackets.end(); iterator++) {
-        // the addresses are disposed of automatically by shared_ptr
-        delete iterator->second;
-    }
-    lastReceivedPackets.clear();
-
-    // delete the running discovery timers and their context objects
-    for (RunningRouteDiscoveriesMap::iterator iterator=runningRouteDiscoveries.begin(); iterator!=runningRouteDiscoveries.end(); iterator++) {
-        Timer* timer = iterator->second;
-        delete (RouteDiscoveryInfo*) timer->getContextObject();
-        delete timer;
-    }
-    runningRouteDiscoveries.clear();
-
-    // delete the known intermediate hop addresses for all sources
-    for (KnownIntermediateHopsMap::iterator iterator=knownIntermediateHops.begin(); iterator!=knownIntermediateHops.end(); iterator++) {
-        delete iterator->second;
+    // delete the running discovery timers, pant timers and last activity times of all known nodes
+    for (PeerStateTable::iterator iterator=peerStates.begin(); iterator!=peerStates.end(); iterator++) {
+        PeerState& state = iterator->second;
+        if (state.routeDiscoveryTimer != nullptr) {
+            delete (RouteDiscoveryInfo*) state.routeDiscoveryTimer->getContextObject();
+            delete state.routeDiscoveryTimer;
+        }
+        if (state.pantTimer != nullptr) {
+            delete (TimerAddressInfo*) state.pantTimer->getContextObject();
+            delete state.pantTimer;
+        }
+        DELETE_IF_NOT_NULL(state.lastActivityTime);
     }
-    knownIntermediateHops.clear();
 
     // delete running delivery timers
     for (DeliveryTimerSet::iterator iterator=runningDeliveryTimers.begin(); iterator!=runningDeliveryTimers.end(); iterator++) {
@@ -74,25 +77,12 @@ AbstractARAClient::~AbstractARAClient() {
     }
     runningDeliveryTimers.clear();
 
-    // delete the last activity timers of all currently known neighbors
-    for (NeighborActivityMap::iterator iterator=neighborActivityTimes.begin(); iterator!=neighborActivityTimes.end(); iterator++) {
-        delete iterator->second.first;
-    }
-    neighborActivityTimes.clear();
-
-    // delete all running pant timers
-    for (ScheduledPANTsMap::iterator iterator=scheduledPANTs.begin(); iterator!=scheduledPANTs.end(); iterator++) {
-        Timer* timer = iterator->second;
-        delete (TimerAddressInfo*) timer->getContextObject();
-        delete timer;
-    }
-    scheduledPANTs.clear();
-
     /* The following members may have be deleted earlier, depending on the destructor of the implementing class */
     DELETE_IF_NOT_NULL(pathReinforcementPolicy);
     DELETE_IF_NOT_NULL(evaporationPolicy);
     DELETE_IF_NOT_NULL(forwardingPolicy);
     DELETE_IF_NOT_NULL(neighborActivityTimer);
+    DELETE_IF_NOT_NULL(flowCache);
 }
 
 void AbstractARAClient::startNeighborActivityTimer() {
@@ -104,22 +94,18 @@ void AbstractARAClient::sendPacket(Packet* packet) {
     routingTable->triggerEvaporation();
 
     if (packet->getTTL() > 0) {
-        AddressPtr destination = packet->getDestination();
+        const AddressPtr& destination = packet->getDestination();
         if (isRouteDiscoveryRunning(destination)) {
             logDebug("Route discovery for %s is already running. Trapping packet %u", destination->toString().c_str(), packet->getSequenceNumber());
             packetTrap->trapPacket(packet);
         }
         else if (routingTable->isDeliverable(packet)) {
-            NextHop* nextHop = forwardingPolicy->getNextHop(packet);
+            NextHop* nextHop = getNextHop(packet);
             NetworkInterface* interface = nextHop->getInterface();
+            // this is a copy because the route (and with it the next hop) may be removed while it is reinforced
             AddressPtr nextHopAddress = nextHop->getAddress();
-            packet->setPreviousHop(packet->getSender());
-            packet->setSender(interface->getLocalAddress());
-
             float newPheromoneValue = reinforcePheromoneValue(destination, nextHopAddress, interface);
-            logDebug("Forwarding DATA packet %u from %s to %s via %s (phi=%.2f)", packet->getSequenceNumber(), packet->getSourceString().c_str(), packet->getDestinationString().c_str(), nextHopAddress->toString().c_str(), newPheromoneValue);
-
-            sendUnicast(packet, interface, nextHopAddress);
+            forwardDataPacket(packet, nextHopAddress, interface, newPheromoneValue);
         }
         else {
             // packet is not deliverable and no route discovery is yet running
@@ -138,29 +124,56 @@ void AbstractARAClient::sendPacket(Packet* packet) {
     }
 }
 
-void AbstractARAClient::sendUnicast(Packet* packet, NetworkInterface* interface, AddressPtr receiver) {
-    interface->send(packet, receiver);
+NextHop* AbstractARAClient::getNextHop(const Packet* packet) {
+    if (flowCache != nullptr) {
+        NextHop* nextHop = flowCache->getNextHop(packet, routingTable);
+        if (nextHop != nullptr) {
+            return nextHop;
+        }
+    }
+    return forwardingPolicy->getNextHop(packet);
+}
+
+void AbstractARAClient::forwardDataPacket(Packet* packet, const AddressPtr& nextHop, NetworkInterface* interface, float newPheromoneValue) {
+    packet->setPreviousHop(packet->getSender());
+    packet->setSender(interface->getLocalAddress());
+
+    if (flowCache != nullptr) {
+        flowCache->routeHasBeenUsed(packet, nextHop, interface, newPheromoneValue);
+    }
+    logDebug("Forwarding DATA packet %u from %s to %s via %s (phi=%.2f)", packet->getSequenceNumber(), packet->getSourceString().c_str(), packet->getDestinationString().c_str(), nextHop->toString().c_str(), newPheromoneValue);
+
+    sendUnicast(packet, interface, nextHop);
+}
+
+void AbstractARAClient::sendUnicast(Packet* packet, NetworkInterface* interface, const AddressPtr& receiver) {
+    // the activity is registered first because the interface may delete the packet (and the receiver with it)
     registerActivity(receiver, interface);
+    interface->send(packet, receiver);
 }
 
-float AbstractARAClient::reinforcePheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
-    float currentPheromoneValue = routingTable->getPheromoneValue(destination, nextHop, interface);
-    float newPheromoneValue = pathReinforcementPolicy->calculateReinforcedValue(currentPheromoneValue);
-    routingTable->update(destination, nextHop, interface, newPheromoneValue);
+float AbstractARAClient::reinforcePheromoneValue(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface) {
+    RouteHandle route = routingTable->findRoute(destination, nextHop, interface);
+    return reinforcePheromoneValue(route);
+}
+
+float AbstractARAClient::reinforcePheromoneValue(RouteHandle& route) {
+    float newPheromoneValue = pathReinforcementPolicy->calculateReinforcedValue(route.getPheromoneValue());
+    route.setPheromoneValue(newPheromoneValue);
     return newPheromoneValue;
 }
 
 void AbstractARAClient::startNewRouteDiscovery(Packet* packet) {
-    AddressPtr destination = packet->getDestination();
+    const AddressPtr& destination = packet->getDestination();
     forgetKnownIntermediateHopsFor(destination);
     startRouteDiscoveryTimer(packet);
     broadcastFANT(destination);
 }
 
 void AbstractARAClient::forgetKnownIntermediateHopsFor(AddressPtr destination) {
-    if(knownIntermediateHops.find(destination) != knownIntermediateHops.end()) {
-        std::unordered_set<AddressPtr>* seenNodesForThisDestination = knownIntermediateHops[destination];
-        seenNodesForThisDestination->clear();
+    PeerState* state = peerStates.find(destination);
+    if(state != nullptr) {
+        state->knownIntermediateHops.clear();
     }
 }
 
@@ -179,12 +192,14 @@ void AbstractARAClient::startRouteDiscoveryTimer(const Packet* packet) {
     timer->addTimeoutListener(this);
     timer->run(routeDiscoveryTimeoutInMilliSeconds * 1000);
 
-    AddressPtr destination = packet->getDestination();
-    runningRouteDiscoveries[destination] = timer;
+    PeerState& state = peerStates.get(packet->getDestinationId());
+    state.isRouteDiscoveryRunning = true;
+    state.routeDiscoveryTimer = timer;
 }
 
-bool AbstractARAClient::isRouteDiscoveryRunning(AddressPtr destination) {
-    return runningRouteDiscoveries.find(destination) != runningRouteDiscoveries.end();
+bool AbstractARAClient::isRouteDiscoveryRunning(const AddressPtr& destination) {
+    PeerState* state = peerStates.find(destination);
+    return state != nullptr && state->isRouteDiscoveryRunning;
 }
 
 void AbstractARAClient::handleNonSourceRouteDiscovery(Packet* packet) {
@@ -236,9 +251,8 @@ void AbstractARAClient::updateRoutingTable(Packet* packet, NetworkInterface* int
         // trigger the evaporation first so this does not effect the new route or update
         routingTable->triggerEvaporation();
 
-        AddressPtr source = packet->getSource();
-        AddressPtr sender = packet->getSender();
-        if (routingTable->isNewRoute(source, sender, interface)) {
+        RouteHandle route = routingTable->findRoute(packet->getSource(), packet->getSender(), interface);
+        if (route.exists() == false) {
 
             if(hasPreviousNodeBeenSeenBefore(packet) == false) {
                 createNewRouteFrom(packet, interface);
@@ -248,7 +262,7 @@ void AbstractARAClient::updateRoutingTable(Packet* packet, NetworkInterface* int
             }
         }
         else {
-            reinforcePheromoneValue(source, sender, interface);
+            reinforcePheromoneValue(route);
         }
     }
 }
@@ -260,28 +274,20 @@ void AbstractARAClient::createNewRouteFrom(Packet* packet, NetworkInterface* int
 }
 
 bool AbstractARAClient::hasPreviousNodeBeenSeenBefore(const Packet* packet) {
-    AddressPtr source = packet->getSource();
+    PeerState& state = peerStates.get(packet->getSourceId());
+    IntermediateHopSet& knownNodes = state.knownIntermediateHops;
 
     if (isNewRouteDiscovery(packet)) {
         //TODO this might become a problem for overlapping route discoveries
-        delete knownIntermediateHops[source];
-        knownIntermediateHops.erase(source);
+        knownNodes.clear();
         return false;
     }
     else {
-        KnownIntermediateHopsMap::const_iterator found = knownIntermediateHops.find(source);
-        if (found == knownIntermediateHops.end()) {
-            // we have never seen any packet for this source address so we can not have seen this previous node before
-            return false;
-        }
-
-        unordered_set<AddressPtr>* listOfKnownNodes = found->second;
-
         // have we seen this sender, or the previous hop before?
-        bool senderHasBeenSeen = listOfKnownNodes->find(packet->getSender()) != listOfKnownNodes->end();
+        bool senderHasBeenSeen = knownNodes.contains(packet->getSenderId());
 
         if (isPreviousHopFeatureActivated) {
-            bool prevHopHasBeenSeen = listOfKnownNodes->find(packet->getPreviousHop()) != listOfKnownNodes->end();
+            bool prevHopHasBeenSeen = knownNodes.contains(packet->getPreviousHopId());
             return senderHasBeenSeen || prevHopHasBeenSeen;
         }
         else {
@@ -292,27 +298,18 @@ bool AbstractARAClient::hasPreviousNodeBeenSeenBefore(const Packet* packet) {
 
 bool AbstractARAClient::isNewRouteDiscovery(const Packet* packet) {
     if (packet->isAntPacket()) {
-        AddressPtr source = packet->getSource();
+        PeerState& state = peerStates.get(packet->getSourceId());
         unsigned int sequenceNumber = packet->getSequenceNumber();
 
-        LastRouteDiscoveriesMap::const_iterator foundLastRouteDiscovery = lastRouteDiscoverySeqNumbers.find(source);
-        if (foundLastRouteDiscovery == lastRouteDiscoverySeqNumbers.end()) {
-            // we have never seen any route discovery from this source so far
-            lastRouteDiscoverySeqNumbers[source] = sequenceNumber;
-            return true;
+        if (state.hasSeenRouteDiscovery && sequenceNumber == state.lastRouteDiscoverySequenceNumber) {
+            // this is the same route discovery we already saw
+            return false;
         }
         else {
-            unsigned int seqNrOfLastRouteDiscovery = foundLastRouteDiscovery->second;
-
-            if (sequenceNumber == seqNrOfLastRouteDiscovery) {
-                // this is the same route discovery we already saw
-                return false;
-            }
-            else {
-                // this seems to be a new route discovery
-                lastRouteDiscoverySeqNumbers[source] = sequenceNumber;
-                return true;
-            }
+            // this is the first or a new route discovery from this source
+            state.hasSeenRouteDiscovery = true;
+            state.lastRouteDiscoverySequenceNumber = sequenceNumber;
+            return true;
         }
     }
     else {
@@ -364,17 +361,17 @@ void AbstractARAClient::checkPantTimer(const Packet* packet) {
     // this should only be called for arrived DATA packets for this node
     if (pantIntervalInMilliSeconds > 0) {
         // only send PANTs if this feature is enabled
-        AddressPtr pantDestination = packet->getSource();
-        if (scheduledPANTs.find(pantDestination) == scheduledPANTs.end()) {
+        PeerState& state = peerStates.get(packet->getSourceId());
+        if (state.pantTimer == nullptr) {
             // only start PANT if no timer is already running
             logDebug("Scheduled PANT to be sent in %u ms", pantIntervalInMilliSeconds);
 
             Clock* clock = Environment::getClock();
-            Timer* pantTimer = clock->getNewTimer(TimerType::PANTS_TIMER, new TimerAddressInfo(pantDestination));
+            Timer* pantTimer = clock->getNewTimer(TimerType::PANTS_TIMER, new TimerAddressInfo(packet->getSource()));
             pantTimer->addTimeoutListener(this);
             pantTimer->run(pantIntervalInMilliSeconds * 1000);
 
-            scheduledPANTs[pantDestination] = pantTimer;
+            state.pantTimer = pantTimer;
         }
     }
 }
@@ -441,16 +438,16 @@ void AbstractARAClient::handleBANTForThisNode(Packet* bant) {
 }
 
 void AbstractARAClient::stopRouteDiscoveryTimer(AddressPtr destination) {
-    RunningRouteDiscoveriesMap::const_iterator discovery;
-    discovery = runningRouteDiscoveries.find(destination);
+    PeerState* state = peerStates.find(destination);
 
-    if(discovery != runningRouteDiscoveries.end()) {
-        Timer* timer = discovery->second;
+    if(state != nullptr && state->routeDiscoveryTimer != nullptr) {
+        Timer* timer = state->routeDiscoveryTimer;
         timer->interrupt();
         // the route discovery is not completely finished until the delivery timer expired.
-        // only then is runningRouteDiscoveries.erase(discovery) called!
+        // only then is isRouteDiscoveryRunning reset!
         delete (RouteDiscoveryInfo*) timer->getContextObject();
         delete timer;
+        state->routeDiscoveryTimer = nullptr;
     }
     else {
         logError("Could not stop route discovery timer (not found for destination %s)", destination->toString().c_str());
@@ -481,57 +478,26 @@ void AbstractARAClient::handleDuplicateErrorPacket(Packet* duplicateErrorPacket,
 }
 
 bool AbstractARAClient::hasBeenReceivedEarlier(const Packet* packet) {
-    AddressPtr source = packet->getSource();
-    unsigned int sequenceNumber = packet->getSequenceNumber();
-
-    LastReceivedPacketsMap::const_iterator receivedPacketSeqNumbersFromSource = lastReceivedPackets.find(source);
-    if(receivedPacketSeqNumbersFromSource != lastReceivedPackets.end()) {
-        unordered_set<unsigned int>* sequenceNumbers = receivedPacketSeqNumbersFromSource->second;
-        unordered_set<unsigned int>::const_iterator got = sequenceNumbers->find(sequenceNumber);
-        if(got != sequenceNumbers->end()) {
-            return true;
-        }
+    PeerState* state = peerStates.find(packet->getSourceId());
+    if(state != nullptr) {
+        const SequenceNumberWindow& window = state->receivedSequenceNumbers;
+        unsigned int sequenceNumber = packet->getSequenceNumber();
+        // DATA packets may arrive late (e.g. trapped packets that are sent after a route discovery), but
+        // flooded ant packets that are too old to tell are dropped like duplicates so they are not flooded again
+        return window.contains(sequenceNumber) || (packet->isDataPacket() == false && window.isOutdated(sequenceNumber));
     }
     return false;
 }
 
 void AbstractARAClient::registerReceivedPacket(const Packet* packet) {
-    AddressPtr source = packet->getSource();
-    AddressPtr sender = packet->getSender();
-
-    // first check the lastReceived sequence numbers for this source
-    LastReceivedPacketsMap::const_iterator foundPacketSeqNumbersFromSource = lastReceivedPackets.find(source);
-    unordered_set<unsigned int>* listOfSequenceNumbers;
-    if(foundPacketSeqNumbersFromSource == lastReceivedPackets.end()) {
-        // There is no record of any received packet from this source address ~> create new
-        listOfSequenceNumbers = new unordered_set<unsigned int>();
-        listOfSequenceNumbers->insert(packet->getSequenceNumber());
-        lastReceivedPackets[source] = listOfSequenceNumbers;
-    }
-    else {
-        listOfSequenceNumbers = foundPacketSeqNumbersFromSource->second;
-        listOfSequenceNumbers->insert(packet->getSequenceNumber());
-    }
+    PeerState& state = peerStates.get(packet->getSourceId());
 
-    // now check the known intermediate hops for this destination
-    KnownIntermediateHopsMap::const_iterator foundIntermediateHopsForSource = knownIntermediateHops.find(source);
-    unordered_set<AddressPtr>* listOfKnownIntermediateNodes;
-    if(foundIntermediateHopsForSource == knownIntermediateHops.end()) {
-        // There is no record of any known intermediate node for this source address ~> create new
-        listOfKnownIntermediateNodes = new unordered_set<AddressPtr>();
-        listOfKnownIntermediateNodes->insert(packet->getSender());
-        knownIntermediateHops[source] = listOfKnownIntermediateNodes;
-    }
-    else {
-        listOfKnownIntermediateNodes = foundIntermediateHopsForSource->second;
-        listOfKnownIntermediateNodes->insert(sender);
-    }
+    // first remember the sequence number and then the known intermediate hops for this source
+    state.receivedSequenceNumbers.insert(packet->getSequenceNumber());
+    state.knownIntermediateHops.insert(packet->getSender());
 
-    if(isPreviousHopFeatureActivated) {
-        AddressPtr previousHop = packet->getPreviousHop();
-        if(packet->getPreviousHop()->equals(sender) == false) {
-            listOfKnownIntermediateNodes->insert(previousHop);
-        }
+    if(isPreviousHopFeatureActivated && packet->getPreviousHopId() != packet->getSenderId()) {
+        state.knownIntermediateHops.insert(packet->getPreviousHop());
     }
 }
 
@@ -582,7 +548,9 @@ void AbstractARAClient::handleExpiredRouteDiscoveryTimer(Timer* routeDiscoveryTi
     }
     else {
         // delete the route discovery timer
-        runningRouteDiscoveries.erase(destination);
+        PeerState& state = peerStates.get(destination);
+        state.isRouteDiscoveryRunning = false;
+        state.routeDiscoveryTimer = nullptr;
         delete discoveryInfo;
         delete routeDiscoveryTimer;
 
@@ -592,6 +560,7 @@ void AbstractARAClient::handleExpiredRouteDiscoveryTimer(Timer* routeDiscoveryTi
         for(auto& packet: undeliverablePackets) {
             packetNotDeliverable(packet);
         }
+        forgetPeerIfUnused(destination);
     }
 }
 
@@ -599,12 +568,11 @@ void AbstractARAClient::handleExpiredDeliveryTimer(Timer* deliveryTimer) {
     TimerAddressInfo* timerInfo = (TimerAddressInfo*) deliveryTimer->getContextObject();
     AddressPtr destination = timerInfo->destination;
 
-    RunningRouteDiscoveriesMap::const_iterator discovery;
-    discovery = runningRouteDiscoveries.find(destination);
+    PeerState* state = peerStates.find(destination);
 
-    if(discovery != runningRouteDiscoveries.end()) {
-        // its important to delete the discovery info first or else the client will always think the route discovery is still running and never send any packets
-        runningRouteDiscoveries.erase(discovery);
+    if(state != nullptr && state->isRouteDiscoveryRunning) {
+        // its important to finish the route discovery first or else the client will always think the route discovery is still running and never send any packets
+        state->isRouteDiscoveryRunning = false;
         runningDeliveryTimers.erase(deliveryTimer);
         delete timerInfo;
         delete deliveryTimer;
@@ -618,7 +586,7 @@ void AbstractARAClient::handleExpiredDeliveryTimer(Timer* deliveryTimer) {
 
 void AbstractARAClient::handleExpiredPANTTimer(Timer* pantTimer) {
     TimerAddressInfo* timerInfo = (TimerAddressInfo*)pantTimer->getContextObject();
-    scheduledPANTs.erase(timerInfo->destination);
+    peerStates.get(timerInfo->destination).pantTimer = nullptr;
     broadcastPANT(timerInfo->destination);
     delete pantTimer;
     delete timerInfo;
@@ -629,15 +597,23 @@ bool AbstractARAClient::handleBrokenLink(Packet* packet, AddressPtr nextHop, Net
 
     // delete all known routes via this next hop
     std::deque<RoutingTableEntryTupel> allRoutesOverNextHop = routingTable->getAllRoutesThatLeadOver(nextHop);
+
+    // we need to remember the interfaces first because the routing table may move or delete the entries while we remove the routes
+    std::deque<std::pair<AddressPtr, NetworkInterface*>> routesToDelete;
     for (auto& route: allRoutesOverNextHop) {
-        deleteRoutingTableEntry(route.destination, nextHop, route.entry->getNetworkInterface());
+        routesToDelete.push_back(std::make_pair(route.destination, route.entry->getNetworkInterface()));
+    }
+
+    for (auto& route: routesToDelete) {
+        deleteRoutingTableEntry(route.first, nextHop, route.second);
     }
 
-    NeighborActivityMap::const_iterator foundNeighbor = neighborActivityTimes.find(nextHop);
-    if(foundNeighbor != neighborActivityTimes.end()) {
-        // delete the associated Time object first
-        delete foundNeighbor->second.first;
-        neighborActivityTimes.erase(nextHop);
+    PeerState* neighborState = peerStates.find(nextHop);
+    if(neighborState != nullptr) {
+        // delete the associated Time object so this is no longer a known neighbor
+        delete neighborState->lastActivityTime;
+        neighborState->lastActivityTime = nullptr;
+        forgetPeerIfUnused(nextHop);
     }
 
     // Try to deliver the packet on an alternative route
@@ -665,18 +641,18 @@ bool AbstractARAClient::handleBrokenLink(Packet* packet, AddressPtr nextHop, Net
     }
 }
 
-void AbstractARAClient::registerActivity(AddressPtr neighbor, NetworkInterface* interface) {
-    NeighborActivityMap::const_iterator foundNeighbor = neighborActivityTimes.find(neighbor);
-    if(foundNeighbor == neighborActivityTimes.end()) {
-        // we have never heard from this neighbor before
+void AbstractARAClient::registerActivity(const AddressPtr& neighbor, NetworkInterface* interface) {
+    PeerState& state = peerStates.get(neighbor);
+    if(state.lastActivityTime == nullptr) {
+        // we have never heard from this neighbor before (or it has been forgotten)
         Clock* clock = Environment::getClock();
-        Time* currentTime = clock->makeTime();
-        currentTime->setToCurrentTime();
-        neighborActivityTimes[neighbor] = std::pair<Time*, NetworkInterface*>(currentTime, interface);
+        state.lastActivityTime = clock->makeTime();
+        state.lastActivityTime->setToCurrentTime();
+        state.lastActivityInterface = interface;
     }
     else {
         // just update the activity time for one of the currently known neighbors
-        foundNeighbor->second.first->setToCurrentTime();
+        state.lastActivityTime->setToCurrentTime();
     }
 }
 
@@ -685,14 +661,22 @@ void AbstractARAClient::checkInactiveNeighbors() {
     Time* currentTime = clock->makeTime();
     currentTime->setToCurrentTime();
 
-    NeighborActivityMap::iterator iterator;
-    for (iterator=neighborActivityTimes.begin(); iterator!=neighborActivityTimes.end(); iterator++) {
-        std::pair<AddressPtr, std::pair<Time*, NetworkInterface*>> entryPair = *iterator;
-        Time* lastActiveTime = entryPair.second.first;
+    // the states can not be erased while iterating over the table
+    std::deque<AddressId> peersWithoutActivity;
+
+    PeerStateTable::iterator iterator;
+    for (iterator=peerStates.begin(); iterator!=peerStates.end(); iterator++) {
+        Time* lastActiveTime = iterator->second.lastActivityTime;
+        if (lastActiveTime == nullptr) {
+            // this is no known neighbor
+            peersWithoutActivity.push_back(iterator->first);
+            continue;
+        }
+
         long timeDifference = currentTime->getDifferenceInMilliSeconds(lastActiveTime);
         if (timeDifference >= maxNeighborInactivityTimeInMilliSeconds) {
-            AddressPtr addressofNeighbor = entryPair.first;
-            NetworkInterface* interface = entryPair.second.second;
+            AddressPtr addressofNeighbor = AddressTable::getAddress(iterator->first);
+            NetworkInterface* interface = iterator->second.lastActivityInterface;
             unsigned int sequenceNumber = getNextSequenceNumber();
             Packet* helloPacket = packetFactory->makeHelloPacket(interface->getLocalAddress(), addressofNeighbor, sequenceNumber);
             logDebug("Sending HELLO packet to inactive neighbor %s", addressofNeighbor->toString().c_str());
@@ -700,9 +684,23 @@ void AbstractARAClient::checkInactiveNeighbors() {
         }
     }
 
+    for (auto& peer: peersWithoutActivity) {
+        forgetPeerIfUnused(AddressTable::getAddress(peer));
+    }
     delete currentTime;
 }
 
+void AbstractARAClient::forgetPeerIfUnused(const AddressPtr& peer) {
+    PeerState* state = peerStates.find(peer);
+    if (state == nullptr || state->lastActivityTime != nullptr || state->isRouteDiscoveryRunning || state->pantTimer != nullptr) {
+        return;
+    }
+
+    if (routingTable->isDeliverable(peer) == false) {
+        peerStates.erase(peer);
+    }
+}
+
 void AbstractARAClient::handleRouteFailurePacket(Packet* packet, NetworkInterface* interface) {
     AddressPtr destination = packet->getDestination();
     AddressPtr nextHop = packet->getSource();
@@ -716,23 +714,31 @@ void AbstractARAClient::handleRouteFailurePacket(Packet* packet, NetworkInterfac
 }
 
 void AbstractARAClient::deleteRoutingTableEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
-    if(routingTable->exists(destination, nextHop, interface)) {
-        routingTable->removeEntry(destination, nextHop, interface);
-
-        deque<RoutingTableEntry*> possibleNextHops = routingTable->getPossibleNextHops(destination);
-        if (possibleNextHops.size() == 1) {
-            RoutingTableEntry* lastRemainingRoute = possibleNextHops.front();
-            AddressPtr remainingNextHop = lastRemainingRoute->getAddress();
-            logDebug("Only one last route is known to %s. Notifying %s with ROUTE_FAILURE packet", destination->toString().c_str(), remainingNextHop->toString().c_str());
-            AddressPtr source = interface->getLocalAddress();
-            unsigned int sequenceNr = getNextSequenceNumber();
-            Packet* routeFailurePacket = packetFactory->makeRouteFailurePacket(source, destination, sequenceNr);
-            lastRemainingRoute->getNetworkInterface()->send(routeFailurePacket, remainingNextHop);
-        }
-        else if (possibleNextHops.empty()) {
-            logInfo("All known routes to %s have collapsed. Sending ROUTE_FAILURE packet", destination->toString().c_str());
-            broadcastRouteFailure(destination);
-        }
+    if(routingTable->removeEntry(destination, nextHop, interface)) {
+        handleRemovedRoute(destination, interface);
+    }
+}
+
+void AbstractARAClient::routeHasBeenEvicted(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    logDebug("Routing table is full. Evicted route to %s via %s", destination->toString().c_str(), nextHop->toString().c_str());
+    handleRemovedRoute(destination, interface);
+}
+
+void AbstractARAClient::handleRemovedRoute(AddressPtr destination, NetworkInterface* interface) {
+    deque<RoutingTableEntry*> possibleNextHops = routingTable->getPossibleNextHops(destination);
+    if (possibleNextHops.size() == 1) {
+        RoutingTableEntry* lastRemainingRoute = possibleNextHops.front();
+        AddressPtr remainingNextHop = lastRemainingRoute->getAddress();
+        logDebug("Only one last route is known to %s. Notifying %s with ROUTE_FAILURE packet", destination->toString().c_str(), remainingNextHop->toString().c_str());
+        AddressPtr source = interface->getLocalAddress();
+        unsigned int sequenceNr = getNextSequenceNumber();
+        Packet* routeFailurePacket = packetFactory->makeRouteFailurePacket(source, destination, sequenceNr);
+        lastRemainingRoute->getNetworkInterface()->send(routeFailurePacket, remainingNextHop);
+    }
+    else if (possibleNextHops.empty()) {
+        logInfo("All known routes to %s have collapsed. Sending ROUTE_FAILURE packet", destination->toString().c_str());
+        broadcastRouteFailure(destination);
+        forgetPeerIfUnused(destination);
     }
 }
 
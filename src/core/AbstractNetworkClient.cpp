@@ -108,7 +108,7 @@ bool AbstractNetworkClient::hasBeenSentByThisNode(const Packet* packet) const {
     return isLocalAddress(packet->getSource());
 }
 
-bool AbstractNetworkClient::isLocalAddress(AddressPtr address) const {
+bool AbstractNetworkClient::isLocalAddress(const AddressPtr& address) const {
     for(auto& interface: interfaces) {
         if(interface->getLocalAddress()->equals(address)) {
             return true;
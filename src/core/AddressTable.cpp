@@ -0,0 +1,211 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Address.h"
+#include "Exception.h"
+#include "NoSuchElementException.h"
+
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace ARA {
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+struct InternedAddress {
+    AddressId id;
+
+    /**
+     * The first address object that has been interned with this id. It is kept to compare new
+     * addresses with and to hand it out via AddressTable::getAddress(..).
+     */
+    AddressPtr address;
+
+    /**
+     * The number of address objects that cache this id (including the kept one) plus the
+     * number of calls to AddressTable::retain(..).
+     */
+    std::atomic<unsigned long> nrOfReferences;
+
+    /**
+     * The position of this entry in InternedAddresses::entries.
+     */
+    unsigned int position;
+
+    /**
+     * The kept address object must not drop its reference when it is deleted together with this entry.
+     */
+    void detachAddress() {
+        address->id.store(UNKNOWN_ADDRESS_ID, std::memory_order_relaxed);
+        address->internedAddress = nullptr;
+    }
+};
+
+namespace {
+
+    /**
+     * The table compares the addresses by their content (their ids are not known yet).
+     */
+    struct AddressValueHash {
+        size_t operator()(const Address* address) const {
+            return address->getHashValue();
+        }
+    };
+
+    struct AddressValuePredicate {
+        bool operator()(const Address* address1, const Address* address2) const {
+            return address1->equals(address2);
+        }
+    };
+
+    /**
+     * The number of entries that are checked for unused addresses whenever a new entry is created.
+     * This is more than one so the unused entries are collected faster than new ones are created.
+     */
+    const unsigned int NR_OF_ENTRIES_TO_COLLECT = 2;
+
+    struct InternedAddresses {
+        std::mutex lock;
+        std::unordered_map<const Address*, InternedAddress*, AddressValueHash, AddressValuePredicate> entriesByAddress;
+        std::unordered_map<AddressId, InternedAddress*> entriesById;
+
+        /**
+         * All entries in no particular order, so they can be collected round robin.
+         */
+        std::vector<InternedAddress*> entries;
+        unsigned int collectionPosition = 0;
+        AddressId nextId = 0;
+
+        InternedAddress* get(AddressId id) {
+            auto found = entriesById.find(id);
+            if (found == entriesById.end()) {
+                throw NoSuchElementException("There is no address with this id in the AddressTable");
+            }
+            return found->second;
+        }
+
+        bool isUnused(InternedAddress* entry) const {
+            // only the kept address object refers to the id and nobody else holds that object
+            return entry->nrOfReferences.load(std::memory_order_acquire) == 1 && entry->address.use_count() == 1;
+        }
+
+        void remove(InternedAddress* entry) {
+            entriesByAddress.erase(entry->address.get());
+            entriesById.erase(entry->id);
+            entries[entry->position] = entries.back();
+            entries[entry->position]->position = entry->position;
+            entries.pop_back();
+
+            entry->detachAddress();
+            delete entry;
+        }
+
+        /**
+         * Removes the entry at the given position if it is unused.
+         * @return the position of the next entry to check (the last entry is moved into the gap)
+         */
+        unsigned int collectAt(unsigned int position) {
+            InternedAddress* entry = entries[position];
+            if (isUnused(entry)) {
+                remove(entry);
+                return position;
+            }
+            return position + 1;
+        }
+
+        void collect(unsigned int nrOfEntries) {
+            for (unsigned int i = 0; i < nrOfEntries && entries.empty() == false; i++) {
+                if (collectionPosition >= entries.size()) {
+                    collectionPosition = 0;
+                }
+                collectionPosition = collectAt(collectionPosition);
+            }
+        }
+    };
+
+    InternedAddresses& getInternedAddresses() {
+        // the table is never deleted because addresses may still be deleted after the static objects
+        static InternedAddresses* internedAddresses = new InternedAddresses();
+        return *internedAddresses;
+    }
+
+}
+
+AddressId AddressTable::intern(const AddressPtr& address) {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+
+    AddressId id = address->id.load(std::memory_order_relaxed);
+    if (id != UNKNOWN_ADDRESS_ID) {
+        // another thread has interned the same address object in the meantime
+        return id;
+    }
+
+    InternedAddress* entry;
+    auto found = table.entriesByAddress.find(address.get());
+    if (found == table.entriesByAddress.end()) {
+        if (table.nextId == UNKNOWN_ADDRESS_ID) {
+            throw Exception("AddressTable: All address ids have been used");
+        }
+        table.collect(NR_OF_ENTRIES_TO_COLLECT);
+
+        entry = new InternedAddress();
+        entry->id = table.nextId++;
+        entry->address = address;
+        entry->nrOfReferences.store(0, std::memory_order_relaxed);
+        entry->position = table.entries.size();
+        table.entries.push_back(entry);
+        table.entriesByAddress[address.get()] = entry;
+        table.entriesById[entry->id] = entry;
+    }
+    else {
+        entry = found->second;
+    }
+
+    entry->nrOfReferences.fetch_add(1, std::memory_order_relaxed);
+    address->internedAddress = entry;
+    address->id.store(entry->id, std::memory_order_relaxed);
+    return entry->id;
+}
+
+void AddressTable::forget(InternedAddress* internedAddress) {
+    // this needs no lock, because the entry is only removed if the kept address holds the last reference
+    internedAddress->nrOfReferences.fetch_sub(1, std::memory_order_release);
+}
+
+AddressPtr AddressTable::getAddress(AddressId id) {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+    return table.get(id)->address;
+}
+
+void AddressTable::retain(AddressId id) {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+    table.get(id)->nrOfReferences.fetch_add(1, std::memory_order_relaxed);
+}
+
+void AddressTable::release(AddressId id) {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+    forget(table.get(id));
+}
+
+void AddressTable::releaseUnusedAddresses() {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+    unsigned int position = 0;
+    while (position < table.entries.size()) {
+        position = table.collectAt(position);
+    }
+}
+
+unsigned int AddressTable::size() {
+    InternedAddresses& table = getInternedAddresses();
+    std::lock_guard<std::mutex> guard(table.lock);
+    return table.entries.size();
+}
+
+} /* namespace ARA */
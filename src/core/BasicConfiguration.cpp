@@ -27,6 +27,24 @@ BasicConfiguration::BasicConfiguration(RoutingTable* routingTable, PacketFactory
 
     // previousHop feature
     this->previousHopFeatureIsActivated = true; // enabled by default
+
+    // lazy evaporation of the routing table
+    this->lazyEvaporationIsActivated = false; // disabled by default
+
+    // incremental evaporation of the routing table
+    this->maxNrOfBucketsPerEvaporation = 0; // disabled by default
+
+    // capacity of the routing table
+    this->maxNrOfRoutingTableEntries = 0; // unlimited by default
+    this->pheromoneAwareEvictionIsActivated = true; // enabled by default
+
+    // random number generator of the stochastic forwarding policies (clients that share the seed should use different streams)
+    this->randomNumberGeneratorSeed = 0;
+    this->randomNumberGeneratorStream = 0;
+
+    // flow cache (next hop of a flow is kept for the dwell time)
+    this->flowCacheDwellTimeInMilliSeconds = 0; // disabled by default
+    this->flowCachePheromoneShiftThreshold = 0.5;
 }
 
 RoutingTable* BasicConfiguration::getRoutingTable() {
@@ -101,6 +119,78 @@ void BasicConfiguration::deactivatePreviousHopFeature() {
     previousHopFeatureIsActivated = false;
 }
 
+bool BasicConfiguration::isLazyEvaporationActivated() {
+    return lazyEvaporationIsActivated;
+}
+
+void BasicConfiguration::activateLazyEvaporation() {
+    lazyEvaporationIsActivated = true;
+}
+
+void BasicConfiguration::deactivateLazyEvaporation() {
+    lazyEvaporationIsActivated = false;
+}
+
+unsigned int BasicConfiguration::getMaxNrOfBucketsPerEvaporation() {
+    return maxNrOfBucketsPerEvaporation;
+}
+
+void BasicConfiguration::setMaxNrOfBucketsPerEvaporation(unsigned int maxNrOfBuckets) {
+    maxNrOfBucketsPerEvaporation = maxNrOfBuckets;
+}
+
+unsigned int BasicConfiguration::getMaxNrOfRoutingTableEntries() {
+    return maxNrOfRoutingTableEntries;
+}
+
+void BasicConfiguration::setMaxNrOfRoutingTableEntries(unsigned int maxNrOfEntries) {
+    maxNrOfRoutingTableEntries = maxNrOfEntries;
+}
+
+bool BasicConfiguration::isPheromoneAwareEvictionActivated() {
+    return pheromoneAwareEvictionIsActivated;
+}
+
+void BasicConfiguration::activatePheromoneAwareEviction() {
+    pheromoneAwareEvictionIsActivated = true;
+}
+
+void BasicConfiguration::deactivatePheromoneAwareEviction() {
+    pheromoneAwareEvictionIsActivated = false;
+}
+
+unsigned int BasicConfiguration::getRandomNumberGeneratorSeed() {
+    return randomNumberGeneratorSeed;
+}
+
+void BasicConfiguration::setRandomNumberGeneratorSeed(unsigned int seed) {
+    randomNumberGeneratorSeed = seed;
+}
+
+unsigned int BasicConfiguration::getRandomNumberGeneratorStream() {
+    return randomNumberGeneratorStream;
+}
+
+void BasicConfiguration::setRandomNumberGeneratorStream(unsigned int stream) {
+    randomNumberGeneratorStream = stream;
+}
+
+unsigned int BasicConfiguration::getFlowCacheDwellTimeInMilliSeconds() {
+    return flowCacheDwellTimeInMilliSeconds;
+}
+
+void BasicConfiguration::setFlowCacheDwellTime(unsigned int dwellTimeInMilliSeconds) {
+    flowCacheDwellTimeInMilliSeconds = dwellTimeInMilliSeconds;
+}
+
+float BasicConfiguration::getFlowCachePheromoneShiftThreshold() {
+    return flowCachePheromoneShiftThreshold;
+}
+
+void BasicConfiguration::setFlowCachePheromoneShiftThreshold(float threshold) {
+    flowCachePheromoneShiftThreshold = threshold;
+}
+
 void BasicConfiguration::setMaximumHopCount(int maxTTL) {
     packetFactory->setMaxHopCount(maxTTL);
 }
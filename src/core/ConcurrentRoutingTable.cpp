@@ -0,0 +1,578 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "ConcurrentRoutingTable.h"
+#include "EpochGuard.h"
+#include "Exception.h"
+
+#include <stdint.h>
+
+ARA_NAMESPACE_BEGIN
+
+const size_t ConcurrentRoutingTable::MIN_CAPACITY;
+
+ConcurrentRoutingTable::Directory::Directory(size_t capacity) {
+    this->capacity = capacity;
+    mask = capacity - 1;
+    slots = new std::atomic<Destination*>[capacity];
+    for (size_t i = 0; i < capacity; i++) {
+        slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+ConcurrentRoutingTable::Directory::~Directory() {
+    // the destinations are owned by the table
+    delete[] slots;
+}
+
+ConcurrentRoutingTable::ConcurrentRoutingTable() : RoutingTable(false) {
+    directory.store(new Directory(MIN_CAPACITY));
+    nrOfUsedSlots = 0;
+    nrOfEntries.store(0);
+}
+
+ConcurrentRoutingTable::~ConcurrentRoutingTable() {
+    // all retired routes, destinations and directories are deleted by the epochManager
+    Directory* currentDirectory = directory.load();
+    for (size_t i = 0; i < currentDirectory->capacity; i++) {
+        Destination* destination = currentDirectory->slots[i].load();
+        if (destination != nullptr) {
+            delete destination->routes.load();
+            delete destination;
+        }
+    }
+    delete currentDirectory;
+}
+
+size_t ConcurrentRoutingTable::hashOf(const AddressPtr& destination) const {
+    // scramble the consecutive address id because only the lower bits of the hash are used to find the home slot
+    uint64_t hash = AddressTable::getId(destination);
+    hash *= 0x9e3779b97f4a7c15ULL;
+    return (size_t) (hash ^ (hash >> 32));
+}
+
+ConcurrentRoutingTable::Destination* ConcurrentRoutingTable::findDestination(const AddressPtr& destination) const {
+    Directory* currentDirectory = directory.load(std::memory_order_acquire);
+    size_t position = hashOf(destination) & currentDirectory->mask;
+    Destination* candidate = currentDirectory->slots[position].load(std::memory_order_acquire);
+    AddressId destinationId = AddressTable::getId(destination);
+    while (candidate != nullptr) {
+        if (AddressTable::getId(candidate->address) == destinationId) {
+            return candidate;
+        }
+        position = (position + 1) & currentDirectory->mask;
+        candidate = currentDirectory->slots[position].load(std::memory_order_acquire);
+    }
+    return nullptr;
+}
+
+ConcurrentRoutingTable::RouteArray* ConcurrentRoutingTable::findRoutes(const AddressPtr& destination) const {
+    Destination* foundDestination = findDestination(destination);
+    if (foundDestination == nullptr) {
+        return nullptr;
+    }
+    return foundDestination->routes.load(std::memory_order_acquire);
+}
+
+ConcurrentRoutingTable::RouteArray* ConcurrentRoutingTable::getRoutesAt(size_t slot) const {
+    Destination* destination = directory.load(std::memory_order_acquire)->slots[slot].load(std::memory_order_acquire);
+    if (destination == nullptr) {
+        return nullptr;
+    }
+    return destination->routes.load(std::memory_order_acquire);
+}
+
+ConcurrentRoutingTable::Destination* ConcurrentRoutingTable::findOrCreateDestination(AddressPtr destination) {
+    Destination* foundDestination = findDestination(destination);
+    if (foundDestination != nullptr) {
+        return foundDestination;
+    }
+
+    // we keep the load factor below 3/4 to keep the probe sequences short
+    if ((nrOfUsedSlots + 1) * 4 > directory.load(std::memory_order_relaxed)->capacity * 3) {
+        rebuildDirectory();
+    }
+
+    Directory* currentDirectory = directory.load(std::memory_order_relaxed);
+    size_t position = hashOf(destination) & currentDirectory->mask;
+    while (currentDirectory->slots[position].load(std::memory_order_relaxed) != nullptr) {
+        position = (position + 1) & currentDirectory->mask;
+    }
+
+    Destination* newDestination = new Destination(destination);
+    currentDirectory->slots[position].store(newDestination, std::memory_order_release);
+    nrOfUsedSlots++;
+    return newDestination;
+}
+
+void ConcurrentRoutingTable::rebuildDirectory() {
+    Directory* oldDirectory = directory.load(std::memory_order_relaxed);
+    unsigned int nrOfDestinations = 0;
+    for (size_t i = 0; i < oldDirectory->capacity; i++) {
+        Destination* destination = oldDirectory->slots[i].load(std::memory_order_relaxed);
+        if (destination != nullptr && destination->routes.load(std::memory_order_relaxed) != nullptr) {
+            nrOfDestinations++;
+        }
+    }
+
+    // the new directory is at most half full so a few destinations can be added before the next rebuild
+    size_t capacity = MIN_CAPACITY;
+    while ((nrOfDestinations + 1) * 2 > capacity) {
+        capacity *= 2;
+    }
+
+    Directory* newDirectory = new Directory(capacity);
+    for (size_t i = 0; i < oldDirectory->capacity; i++) {
+        Destination* destination = oldDirectory->slots[i].load(std::memory_order_relaxed);
+        if (destination == nullptr) {
+            continue;
+        }
+
+        if (destination->routes.load(std::memory_order_relaxed) == nullptr) {
+            // readers of the old directory may still look at this destination
+            epochManager.retire(destination);
+        }
+        else {
+            size_t position = hashOf(destination->address) & newDirectory->mask;
+            while (newDirectory->slots[position].load(std::memory_order_relaxed) != nullptr) {
+                position = (position + 1) & newDirectory->mask;
+            }
+            newDirectory->slots[position].store(destination, std::memory_order_relaxed);
+        }
+    }
+
+    directory.store(newDirectory, std::memory_order_release);
+    epochManager.retire(oldDirectory);
+    nrOfUsedSlots = nrOfDestinations;
+    evaporationCursor = 0;
+}
+
+ConcurrentRoutingTable::RouteArray* ConcurrentRoutingTable::copyRoutes(Destination* destination) const {
+    RouteArray* routes = destination->routes.load(std::memory_order_relaxed);
+    RouteArray* copy = new RouteArray();
+    if (routes != nullptr) {
+        copy->reserve(routes->size() + 1);
+        copy->assign(routes->begin(), routes->end());
+    }
+    return copy;
+}
+
+void ConcurrentRoutingTable::publish(Destination* destination, RouteArray* routes) {
+    if (routes->empty()) {
+        delete routes;
+        routes = nullptr;
+    }
+
+    RouteArray* oldRoutes = destination->routes.load(std::memory_order_relaxed);
+    destination->routes.store(routes, std::memory_order_release);
+    if (oldRoutes != nullptr) {
+        epochManager.retire(oldRoutes);
+    }
+}
+
+unsigned int ConcurrentRoutingTable::find(RouteArray* routes, AddressPtr nextHop, NetworkInterface* interface) {
+    for (unsigned int i = 0; i < routes->size(); i++) {
+        RoutingTableEntry& entry = (*routes)[i];
+        if (entry.getAddress()->equals(nextHop) && entry.getNetworkInterface()->equals(interface)) {
+            return i;
+        }
+    }
+    return routes->size();
+}
+
+RoutingTableEntry* ConcurrentRoutingTable::findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface) {
+    RouteArray* routes = findRoutes(destination);
+    if (routes != nullptr) {
+        unsigned int position = find(routes, nextHop, interface);
+        if (position < routes->size()) {
+            return &(*routes)[position];
+        }
+    }
+    return nullptr;
+}
+
+RoutingTableEntry* ConcurrentRoutingTable::updateRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    RoutingTableEntry* entry = findStoredEntry(destination, nextHop, interface);
+    if (entry != nullptr) {
+        updateInPlace(entry, pheromoneValue);
+        return entry;
+    }
+
+    // the eviction may publish new routes for any destination (including this one)
+    makeRoomForNewEntry();
+
+    // only a new route changes the array, so it is copied
+    Destination* foundDestination = findOrCreateDestination(destination);
+    RouteArray* routes = copyRoutes(foundDestination);
+    routes->push_back(RoutingTableEntry(nextHop, interface, pheromoneValue));
+    addToNextHopIndex(destination, nextHop);
+    nrOfEntries++;
+
+    entry = &routes->back();
+    entry->setTimestamp(currentTimestamp);
+    eviction.track(destination, entry);
+    publish(foundDestination, routes);
+    return entry;
+}
+
+void ConcurrentRoutingTable::updateInPlace(RoutingTableEntry* entry, float pheromoneValue) {
+    entry->setPheromoneValue(pheromoneValue);
+    entry->setTimestamp(currentTimestamp);
+    eviction.touch(entry);
+}
+
+bool ConcurrentRoutingTable::isPublished(Destination* destination, RoutingTableEntry* entry) const {
+    RouteArray* routes = destination->routes.load(std::memory_order_relaxed);
+    return routes != nullptr && entry >= routes->data() && entry < routes->data() + routes->size();
+}
+
+void ConcurrentRoutingTable::update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    std::vector<RouteEviction::Route> evictedRoutes;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        updateRoute(destination, nextHop, interface, pheromoneValue);
+        evictedRoutes = eviction.takeEvictedRoutes();
+        epochManager.reclaim();
+    }
+
+    // the listener may modify this table, so it is notified after the lock has been released
+    eviction.notifyListener(evictedRoutes);
+}
+
+void ConcurrentRoutingTable::update(AddressPtr destination, RoutingTableEntry* newEntry) {
+    std::vector<RouteEviction::Route> evictedRoutes;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        updateRoute(destination, newEntry->getAddress(), newEntry->getNetworkInterface(), newEntry->getPheromoneValue());
+        evictedRoutes = eviction.takeEvictedRoutes();
+        epochManager.reclaim();
+    }
+    delete newEntry;
+    eviction.notifyListener(evictedRoutes);
+}
+
+RouteHandle ConcurrentRoutingTable::findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    RouteHandle route = RouteHandle(this, destination, nextHop, interface);
+    EpochGuard guard(&epochManager);
+    Destination* foundDestination = findDestination(destination);
+    if (foundDestination != nullptr) {
+        RouteArray* routes = foundDestination->routes.load(std::memory_order_acquire);
+        RoutingTableEntry* entry = nullptr;
+        if (routes != nullptr) {
+            unsigned int position = find(routes, nextHop, interface);
+            if (position < routes->size()) {
+                entry = &(*routes)[position];
+            }
+        }
+        route.bind(entry, foundDestination, guard);
+    }
+    return route;
+}
+
+void ConcurrentRoutingTable::update(RouteHandle& route, float pheromoneValue) {
+    std::vector<RouteEviction::Route> evictedRoutes;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        RoutingTableEntry* boundEntry = route.getEntry();
+        Destination* boundDestination = (Destination*) route.getRoutes();
+        if (boundEntry != nullptr && isPublished(boundDestination, boundEntry)) {
+            // the handle has been bound to the current routes, so we can skip the lookup
+            updateInPlace(boundEntry, pheromoneValue);
+            return;
+        }
+
+        RoutingTableEntry* entry = updateRoute(route.getDestination(), route.getNextHop(), route.getInterface(), pheromoneValue);
+
+        // the new entry is protected by a new guard because the handle may not have had one before
+        route.bind(entry, findDestination(route.getDestination()), EpochGuard(&epochManager));
+        evictedRoutes = eviction.takeEvictedRoutes();
+        epochManager.reclaim();
+    }
+    eviction.notifyListener(evictedRoutes);
+}
+
+bool ConcurrentRoutingTable::removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    std::lock_guard<std::mutex> guard(lock);
+    bool entryHasBeenRemoved = removeRoute(destination, nextHop, interface);
+    epochManager.reclaim();
+    return entryHasBeenRemoved;
+}
+
+void ConcurrentRoutingTable::removeEvictedRoute(const RouteEviction::Route& route) {
+    // the lock is already held by the update that makes room for a new route
+    removeRoute(route.destination, route.nextHop, route.interface);
+}
+
+bool ConcurrentRoutingTable::removeRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    bool entryHasBeenRemoved = false;
+    Destination* foundDestination = findDestination(destination);
+    if (foundDestination != nullptr) {
+        RouteArray* routes = foundDestination->routes.load(std::memory_order_relaxed);
+        if (routes != nullptr) {
+            unsigned int position = find(routes, nextHop, interface);
+            if (position < routes->size()) {
+                eviction.forget(&(*routes)[position]);
+                RouteArray* remainingRoutes = new RouteArray(*routes);
+                remainingRoutes->erase(remainingRoutes->begin() + position);
+                removeFromNextHopIndex(destination, nextHop);
+                nrOfEntries--;
+                publish(foundDestination, remainingRoutes);
+                entryHasBeenRemoved = true;
+            }
+        }
+    }
+    return entryHasBeenRemoved;
+}
+
+RoutingTableEntryList ConcurrentRoutingTable::getPossibleNextHops(const Packet* packet) {
+    RoutingTableEntryList result;
+    for (auto entry: getNextHopCandidates(packet)) {
+        result.push_back(entry);
+    }
+    return result;
+}
+
+NextHopCandidates ConcurrentRoutingTable::getNextHopCandidates(const Packet* packet) {
+    EpochGuard guard(&epochManager);
+    RouteArray* routes = findRoutes(packet->getDestination());
+    if (routes != nullptr) {
+        return NextHopCandidates(routes->data(), routes->size(), packet, guard);
+    }
+    return NextHopCandidates();
+}
+
+RoutingTableEntryList ConcurrentRoutingTable::getPossibleNextHops(AddressPtr destination) {
+    RoutingTableEntryList result;
+    EpochGuard guard(&epochManager);
+    RouteArray* routes = findRoutes(destination);
+    if (routes != nullptr) {
+        for (auto& entry: *routes) {
+            result.push_back(&entry);
+        }
+    }
+    return result;
+}
+
+bool ConcurrentRoutingTable::isDeliverable(const Packet* packet) {
+    return getNextHopCandidates(packet).empty() == false;
+}
+
+bool ConcurrentRoutingTable::isDeliverable(AddressPtr destination) {
+    EpochGuard guard(&epochManager);
+    return findRoutes(destination) != nullptr;
+}
+
+float ConcurrentRoutingTable::getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    EpochGuard guard(&epochManager);
+    RouteArray* routes = findRoutes(destination);
+    if (routes != nullptr) {
+        unsigned int position = find(routes, nextHop, interface);
+        if (position < routes->size()) {
+            return (*routes)[position].getPheromoneValue();
+        }
+    }
+    return 0;
+}
+
+bool ConcurrentRoutingTable::exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    EpochGuard guard(&epochManager);
+    RouteArray* routes = findRoutes(destination);
+    return routes != nullptr && find(routes, nextHop, interface) < routes->size();
+}
+
+unsigned int ConcurrentRoutingTable::getTotalNumberOfEntries() const {
+    return nrOfEntries.load();
+}
+
+RoutingTableEntryTupel ConcurrentRoutingTable::findEntryAt(int wantedPosition) const {
+    if (wantedPosition >= 0) {
+        unsigned int remaining = wantedPosition;
+        Directory* currentDirectory = directory.load(std::memory_order_acquire);
+        for (size_t i = 0; i < currentDirectory->capacity; i++) {
+            RouteArray* routes = getRoutesAt(i);
+            if (routes != nullptr) {
+                if (remaining < routes->size()) {
+                    RoutingTableEntryTupel tupel;
+                    tupel.destination = currentDirectory->slots[i].load()->address;
+                    tupel.entry = &(*routes)[remaining];
+                    return tupel;
+                }
+                remaining -= routes->size();
+            }
+        }
+    }
+
+    throw Exception("ConcurrentRoutingTable::getEntryAt: Index out of bounds");
+}
+
+void ConcurrentRoutingTable::forEachEntry(const RoutingTableVisitor& visitor) const {
+    EpochGuard guard(&epochManager);
+    Directory* currentDirectory = directory.load(std::memory_order_acquire);
+    for (size_t i = 0; i < currentDirectory->capacity; i++) {
+        Destination* destination = currentDirectory->slots[i].load(std::memory_order_acquire);
+        if (destination != nullptr) {
+            RouteArray* routes = destination->routes.load(std::memory_order_acquire);
+            if (routes != nullptr) {
+                for (auto& entry: *routes) {
+                    visitor(destination->address, &entry);
+                }
+            }
+        }
+    }
+}
+
+bool ConcurrentRoutingTable::moveToFirstEntry(IteratorPosition& position) const {
+    position.slot = 0;
+    position.route = 0;
+    size_t capacity = directory.load(std::memory_order_acquire)->capacity;
+    while (position.slot < capacity && getRoutesAt(position.slot) == nullptr) {
+        position.slot++;
+    }
+    return position.slot < capacity;
+}
+
+bool ConcurrentRoutingTable::moveToNextEntry(IteratorPosition& position) const {
+    size_t capacity = directory.load(std::memory_order_acquire)->capacity;
+    position.route++;
+    if (position.route >= getRoutesAt(position.slot)->size()) {
+        position.route = 0;
+        do {
+            position.slot++;
+        } while (position.slot < capacity && getRoutesAt(position.slot) == nullptr);
+    }
+    return position.slot < capacity;
+}
+
+RoutingTableEntryTupel ConcurrentRoutingTable::getEntryAtPosition(const IteratorPosition& position) const {
+    RoutingTableEntryTupel tupel;
+    tupel.destination = directory.load(std::memory_order_acquire)->slots[position.slot].load()->address;
+    tupel.entry = &(*getRoutesAt(position.slot))[position.route];
+    return tupel;
+}
+
+std::deque<RoutingTableEntryTupel> ConcurrentRoutingTable::getAllRoutesThatLeadOver(AddressPtr nextHop) const {
+    std::lock_guard<std::mutex> guard(lock);
+    std::deque<RoutingTableEntryTupel> result = std::deque<RoutingTableEntryTupel>();
+
+    NextHopIndex::const_iterator foundNextHop = nextHopIndex.find(nextHop);
+    if (foundNextHop != nextHopIndex.end()) {
+        for (auto& destinationCounter: foundNextHop->second) {
+            RouteArray* routes = findRoutes(destinationCounter.first);
+            for (auto& entry: *routes) {
+                if (entry.getAddress()->equals(nextHop)) {
+                    RoutingTableEntryTupel tupel;
+                    tupel.destination = destinationCounter.first;
+                    tupel.entry = &entry;
+                    result.push_back(tupel);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void ConcurrentRoutingTable::triggerEvaporation() {
+    std::lock_guard<std::mutex> guard(lock);
+    RoutingTable::triggerEvaporation();
+    epochManager.reclaim();
+}
+
+void ConcurrentRoutingTable::evaporateEntries(long timeDifference) {
+    Directory* currentDirectory = directory.load(std::memory_order_relaxed);
+    pheromoneValues.clear();
+    for (size_t i = 0; i < currentDirectory->capacity; i++) {
+        RouteArray* routes = getRoutesAt(i);
+        if (routes != nullptr) {
+            for (auto& entry: *routes) {
+                pheromoneValues.push_back(entry.getPheromoneValue());
+            }
+        }
+    }
+    evaporationPolicy->evaporate(pheromoneValues.data(), pheromoneValues.size(), timeDifference);
+
+    // the directory is not rebuilt during the sweep, so the slots are visited in the same order as above
+    size_t nextPheromoneValue = 0;
+    for (size_t i = 0; i < currentDirectory->capacity; i++) {
+        Destination* destination = currentDirectory->slots[i].load(std::memory_order_relaxed);
+        if (destination == nullptr || destination->routes.load(std::memory_order_relaxed) == nullptr) {
+            continue;
+        }
+
+        RouteArray* routes = destination->routes.load(std::memory_order_relaxed);
+        RouteArray* remainingRoutes = nullptr;
+        for (unsigned int position = 0; position < routes->size(); position++) {
+            RoutingTableEntry& entry = (*routes)[position];
+            float newPheromoneValue = pheromoneValues[nextPheromoneValue++];
+            if (newPheromoneValue > 0) {
+                entry.setPheromoneValue(newPheromoneValue);
+                if (remainingRoutes != nullptr) {
+                    remainingRoutes->push_back(entry);
+                }
+            }
+            else {
+                remainingRoutes = removeEvaporatedRoute(destination, routes, position, remainingRoutes);
+            }
+        }
+
+        if (remainingRoutes != nullptr) {
+            publish(destination, remainingRoutes);
+        }
+    }
+}
+
+ConcurrentRoutingTable::RouteArray* ConcurrentRoutingTable::removeEvaporatedRoute(Destination* destination, RouteArray* routes, unsigned int position, RouteArray* remainingRoutes) {
+    if (remainingRoutes == nullptr) {
+        // this is the first route that is removed, so all routes before it remain
+        remainingRoutes = new RouteArray(routes->begin(), routes->begin() + position);
+        remainingRoutes->reserve(routes->size() - 1);
+    }
+
+    removeFromNextHopIndex(destination->address, (*routes)[position].getAddress());
+    eviction.forget(&(*routes)[position]);
+    nrOfEntries--;
+    return remainingRoutes;
+}
+
+void ConcurrentRoutingTable::evaporateDestination(Destination* destination) {
+    RouteArray* routes = destination->routes.load(std::memory_order_relaxed);
+    if (routes == nullptr) {
+        return;
+    }
+
+    // the routes are evaporated in place and only copied if one of them has to be removed
+    RouteArray* remainingRoutes = nullptr;
+    for (unsigned int position = 0; position < routes->size(); position++) {
+        RoutingTableEntry& entry = (*routes)[position];
+        if (evaporateEntry(&entry)) {
+            if (remainingRoutes != nullptr) {
+                remainingRoutes->push_back(entry);
+            }
+        }
+        else {
+            remainingRoutes = removeEvaporatedRoute(destination, routes, position, remainingRoutes);
+        }
+    }
+
+    if (remainingRoutes != nullptr) {
+        publish(destination, remainingRoutes);
+    }
+}
+
+void ConcurrentRoutingTable::evaporateBuckets(unsigned int nrOfBuckets) {
+    Directory* currentDirectory = directory.load(std::memory_order_relaxed);
+    for (unsigned int i = 0; i < nrOfBuckets && nrOfEntries.load() > 0; i++) {
+        // start over at the first slot after the last one has been visited
+        if (evaporationCursor >= currentDirectory->capacity) {
+            evaporationCursor = 0;
+        }
+
+        Destination* destination = currentDirectory->slots[evaporationCursor].load(std::memory_order_relaxed);
+        if (destination != nullptr) {
+            evaporateDestination(destination);
+        }
+        evaporationCursor++;
+    }
+}
+
+ARA_NAMESPACE_END
@@ -0,0 +1,70 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "EpochGuard.h"
+
+ARA_NAMESPACE_BEGIN
+
+EpochGuard::EpochGuard() {
+    epochManager = nullptr;
+    epoch = 0;
+}
+
+EpochGuard::EpochGuard(EpochManager* epochManager) {
+    this->epochManager = epochManager;
+    epoch = epochManager->enter();
+}
+
+EpochGuard::EpochGuard(const EpochGuard& other) {
+    epochManager = other.epochManager;
+    epoch = other.epoch;
+    if (epochManager != nullptr) {
+        epochManager->join(epoch);
+    }
+}
+
+EpochGuard::EpochGuard(EpochGuard&& other) {
+    epochManager = other.epochManager;
+    epoch = other.epoch;
+    other.epochManager = nullptr;
+}
+
+EpochGuard::~EpochGuard() {
+    release();
+}
+
+EpochGuard& EpochGuard::operator=(const EpochGuard& other) {
+    if (this != &other) {
+        if (other.epochManager != nullptr) {
+            other.epochManager->join(other.epoch);
+        }
+        release();
+        epochManager = other.epochManager;
+        epoch = other.epoch;
+    }
+    return *this;
+}
+
+EpochGuard& EpochGuard::operator=(EpochGuard&& other) {
+    if (this != &other) {
+        release();
+        epochManager = other.epochManager;
+        epoch = other.epoch;
+        other.epochManager = nullptr;
+    }
+    return *this;
+}
+
+bool EpochGuard::isActive() const {
+    return epochManager != nullptr;
+}
+
+void EpochGuard::release() {
+    if (epochManager != nullptr) {
+        epochManager->leave(epoch);
+        epochManager = nullptr;
+    }
+}
+
+ARA_NAMESPACE_END
@@ -0,0 +1,80 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "EpochManager.h"
+
+ARA_NAMESPACE_BEGIN
+
+EpochManager::EpochManager() {
+    epoch.store(0);
+    nrOfReaders[0].store(0);
+    nrOfReaders[1].store(0);
+}
+
+EpochManager::~EpochManager() {
+    deleteRetiredObjects(retiredObjects[0]);
+    deleteRetiredObjects(retiredObjects[1]);
+}
+
+unsigned long EpochManager::enter() {
+    while (true) {
+        unsigned long currentEpoch = epoch.load();
+        nrOfReaders[currentEpoch & 1]++;
+
+        /*
+         * If the epoch has been advanced in the meantime, the writer may not have seen our
+         * counter and could already delete objects we are about to load. So we try again.
+         */
+        if (epoch.load() == currentEpoch) {
+            return currentEpoch;
+        }
+        nrOfReaders[currentEpoch & 1]--;
+    }
+}
+
+void EpochManager::join(unsigned long epoch) {
+    // the epoch can not be advanced past epoch+1 while the caller is still inside so this is safe
+    nrOfReaders[epoch & 1]++;
+}
+
+void EpochManager::leave(unsigned long epoch) {
+    nrOfReaders[epoch & 1]--;
+}
+
+void EpochManager::retire(void* object, void (*deleter)(void*)) {
+    RetiredObject retiredObject;
+    retiredObject.object = object;
+    retiredObject.deleter = deleter;
+    retiredObjects[epoch.load() & 1].push_back(retiredObject);
+}
+
+bool EpochManager::reclaim() {
+    unsigned long currentEpoch = epoch.load();
+    unsigned int previousEpoch = (currentEpoch + 1) & 1;
+    if (nrOfReaders[previousEpoch].load() > 0) {
+        return false;
+    }
+
+    // all objects in this list have been retired in the epoch before the previous one
+    deleteRetiredObjects(retiredObjects[previousEpoch]);
+    epoch.store(currentEpoch + 1);
+    return true;
+}
+
+unsigned long EpochManager::getCurrentEpoch() const {
+    return epoch.load();
+}
+
+unsigned int EpochManager::getNrOfRetiredObjects() const {
+    return retiredObjects[0].size() + retiredObjects[1].size();
+}
+
+void EpochManager::deleteRetiredObjects(std::vector<RetiredObject>& objects) {
+    for (auto& retiredObject: objects) {
+        retiredObject.deleter(retiredObject.object);
+    }
+    objects.clear();
+}
+
+ARA_NAMESPACE_END
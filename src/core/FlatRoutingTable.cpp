@@ -0,0 +1,646 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "FlatRoutingTable.h"
+#include "Exception.h"
+
+#include <new>
+#include <stdint.h>
+#include <utility>
+
+ARA_NAMESPACE_BEGIN
+
+const unsigned int FlatRoutingTable::INLINE_ROUTES;
+const size_t FlatRoutingTable::EMPTY_SLOT;
+const size_t FlatRoutingTable::NOT_FOUND;
+
+FlatRoutingTable::RouteList::RouteList() {
+    entries = reinterpret_cast<RoutingTableEntry*>(inlineEntries);
+    nrOfEntries = 0;
+    capacity = INLINE_ROUTES;
+}
+
+FlatRoutingTable::RouteList::RouteList(RouteList&& other) : RouteList() {
+    moveEntriesFrom(other);
+}
+
+FlatRoutingTable::RouteList& FlatRoutingTable::RouteList::operator=(RouteList&& other) {
+    if (this != &other) {
+        clear();
+        moveEntriesFrom(other);
+    }
+    return *this;
+}
+
+FlatRoutingTable::RouteList::~RouteList() {
+    clear();
+}
+
+bool FlatRoutingTable::RouteList::isInline() const {
+    return entries == reinterpret_cast<const RoutingTableEntry*>(inlineEntries);
+}
+
+void FlatRoutingTable::RouteList::moveEntriesFrom(RouteList& other) {
+    // this list is always empty and inline at this point
+    if (other.isInline()) {
+        for (unsigned int i = 0; i < other.nrOfEntries; i++) {
+            new (entries + i) RoutingTableEntry(other.entries[i]);
+            other.entries[i].~RoutingTableEntry();
+        }
+        nrOfEntries = other.nrOfEntries;
+    }
+    else {
+        // just steal the heap memory
+        entries = other.entries;
+        nrOfEntries = other.nrOfEntries;
+        capacity = other.capacity;
+        other.entries = reinterpret_cast<RoutingTableEntry*>(other.inlineEntries);
+        other.capacity = INLINE_ROUTES;
+    }
+    other.nrOfEntries = 0;
+}
+
+RoutingTableEntry* FlatRoutingTable::RouteList::add(AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    if (nrOfEntries == capacity) {
+        unsigned int newCapacity = capacity * 2;
+        RoutingTableEntry* newEntries = static_cast<RoutingTableEntry*>(::operator new(newCapacity * sizeof(RoutingTableEntry)));
+        for (unsigned int i = 0; i < nrOfEntries; i++) {
+            new (newEntries + i) RoutingTableEntry(entries[i]);
+            entries[i].~RoutingTableEntry();
+        }
+
+        if (isInline() == false) {
+            ::operator delete(entries);
+        }
+        entries = newEntries;
+        capacity = newCapacity;
+    }
+
+    RoutingTableEntry* entry = new (entries + nrOfEntries) RoutingTableEntry(nextHop, interface, pheromoneValue);
+    nrOfEntries++;
+    return entry;
+}
+
+void FlatRoutingTable::RouteList::erase(unsigned int position) {
+    // we move all following entries one position to the front to keep the order of the routes
+    for (unsigned int i = position; i+1 < nrOfEntries; i++) {
+        entries[i] = entries[i+1];
+    }
+    nrOfEntries--;
+    entries[nrOfEntries].~RoutingTableEntry();
+}
+
+void FlatRoutingTable::RouteList::clear() {
+    for (unsigned int i = 0; i < nrOfEntries; i++) {
+        entries[i].~RoutingTableEntry();
+    }
+    nrOfEntries = 0;
+
+    if (isInline() == false) {
+        ::operator delete(entries);
+        entries = reinterpret_cast<RoutingTableEntry*>(inlineEntries);
+        capacity = INLINE_ROUTES;
+    }
+}
+
+unsigned int FlatRoutingTable::RouteList::find(AddressPtr nextHop, NetworkInterface* interface) const {
+    for (unsigned int i = 0; i < nrOfEntries; i++) {
+        if (entries[i].getAddress()->equals(nextHop) && entries[i].getNetworkInterface()->equals(interface)) {
+            return i;
+        }
+    }
+    return nrOfEntries;
+}
+
+FlatRoutingTable::FlatRoutingTable() : RoutingTable(false), hashes(16, EMPTY_SLOT), slots(16) {
+    mask = hashes.size() - 1;
+    nrOfDestinations = 0;
+    nrOfEntries = 0;
+}
+
+FlatRoutingTable::~FlatRoutingTable() {
+    // all entries are deleted together with the slots
+}
+
+size_t FlatRoutingTable::hashOf(const AddressPtr& destination) const {
+    /*
+     * The ids of the addresses are consecutive, so they are scrambled with the finalizer of MurmurHash3
+     * to spread neighboring ids over the table (only the lower bits are used to find the home slot)
+     */
+    uint64_t hash = AddressTable::getId(destination);
+    hash ^= hash >> 33;
+    hash *= 0xff51afd7ed558ccdULL;
+    hash ^= hash >> 33;
+    hash *= 0xc4ceb9fe1a85ec53ULL;
+    hash ^= hash >> 33;
+
+    // the value EMPTY_SLOT is reserved to mark unused slots
+    return hash == EMPTY_SLOT ? 1 : (size_t) hash;
+}
+
+size_t FlatRoutingTable::getHomeSlot(const AddressPtr& destination) const {
+    return hashOf(destination) & mask;
+}
+
+size_t FlatRoutingTable::findSlot(const AddressPtr& destination) const {
+    size_t hash = hashOf(destination);
+    size_t position = hash & mask;
+    while (hashes[position] != EMPTY_SLOT) {
+        if (hashes[position] == hash && AddressTable::getId(slots[position].destination) == AddressTable::getId(destination)) {
+            return position;
+        }
+        position = (position + 1) & mask;
+    }
+    return NOT_FOUND;
+}
+
+size_t FlatRoutingTable::findEvaporatedSlot(const AddressPtr& destination) {
+    size_t position = findSlot(destination);
+    if (position != NOT_FOUND && isLazyEvaporationUsed() && evaporateSlot(position)) {
+        // all routes have evaporated in the meantime
+        removeSlot(position);
+        return NOT_FOUND;
+    }
+    return position;
+}
+
+size_t FlatRoutingTable::findOrCreateSlot(AddressPtr destination) {
+    size_t position = findSlot(destination);
+    if (position != NOT_FOUND) {
+        return position;
+    }
+
+    // we keep the load factor below 3/4 to keep the probe sequences short
+    if ((nrOfDestinations + 1) * 4 > hashes.size() * 3) {
+        grow();
+    }
+
+    size_t hash = hashOf(destination);
+    position = hash & mask;
+    while (hashes[position] != EMPTY_SLOT) {
+        position = (position + 1) & mask;
+    }
+
+    hashes[position] = hash;
+    slots[position].destination = destination;
+    nrOfDestinations++;
+    return position;
+}
+
+void FlatRoutingTable::grow() {
+    std::vector<size_t> oldHashes(hashes.size() * 2, EMPTY_SLOT);
+    std::vector<Slot> oldSlots(slots.size() * 2);
+    oldHashes.swap(hashes);
+    oldSlots.swap(slots);
+    mask = hashes.size() - 1;
+    invalidateRouteHandles();
+
+    for (size_t i = 0; i < oldHashes.size(); i++) {
+        if (oldHashes[i] != EMPTY_SLOT) {
+            size_t position = oldHashes[i] & mask;
+            while (hashes[position] != EMPTY_SLOT) {
+                position = (position + 1) & mask;
+            }
+            hashes[position] = oldHashes[i];
+            moveSlot(slots[position], oldSlots[i]);
+        }
+    }
+}
+
+void FlatRoutingTable::moveSlot(Slot& target, Slot& source) {
+    // inline routes change their address when they are moved, so the best entry is remembered by its position
+    RoutingTableEntry* bestEntry = source.aggregates.bestEntry;
+    unsigned int bestPosition = bestEntry != nullptr ? bestEntry - source.routes.at(0) : 0;
+
+    target.destination = std::move(source.destination);
+    target.routes = std::move(source.routes);
+    target.aggregates.sumOfPheromoneValues = source.aggregates.sumOfPheromoneValues;
+    target.aggregates.bestEntry = bestEntry != nullptr ? target.routes.at(bestPosition) : nullptr;
+    target.aggregates.cumulativeSelectionWeights.swap(source.aggregates.cumulativeSelectionWeights);
+    resetAggregates(source.aggregates);
+}
+
+void FlatRoutingTable::removeSlot(size_t position) {
+    nrOfEntries -= slots[position].routes.size();
+    slots[position].routes.clear();
+    slots[position].destination.reset();
+    resetAggregates(slots[position].aggregates);
+    hashes[position] = EMPTY_SLOT;
+    nrOfDestinations--;
+
+    /*
+     * We use backward shift deletion instead of tombstones: All following slots of the
+     * same probe sequence are moved into the hole if the hole lies between their home
+     * position and their current position.
+     */
+    size_t hole = position;
+    size_t current = position;
+    while (true) {
+        current = (current + 1) & mask;
+        if (hashes[current] == EMPTY_SLOT) {
+            break;
+        }
+
+        size_t home = hashes[current] & mask;
+        if (((current - home) & mask) >= ((current - hole) & mask)) {
+            hashes[hole] = hashes[current];
+            moveSlot(slots[hole], slots[current]);
+            hashes[current] = EMPTY_SLOT;
+            hole = current;
+        }
+    }
+}
+
+RoutingTableEntry* FlatRoutingTable::findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface) {
+    Slot* slot;
+    return findStoredEntry(destination, nextHop, interface, slot);
+}
+
+RoutingTableEntry* FlatRoutingTable::findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface, Slot*& slot) {
+    size_t slotPosition = findSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        slot = &slots[slotPosition];
+        unsigned int position = slot->routes.find(nextHop, interface);
+        if (position < slot->routes.size()) {
+            return slot->routes.at(position);
+        }
+    }
+    slot = nullptr;
+    return nullptr;
+}
+
+void FlatRoutingTable::routeHasBeenUpdated(Slot& slot, RoutingTableEntry* entry, float oldPheromoneValue) {
+    entry->setTimestamp(currentTimestamp);
+    eviction.touch(entry);
+    if (updateAggregates(slot.aggregates, entry, oldPheromoneValue) == false) {
+        recomputeAggregates(slot);
+    }
+}
+
+void FlatRoutingTable::recomputeAggregates(Slot& slot) {
+    resetAggregates(slot.aggregates);
+    for (unsigned int i = 0; i < slot.routes.size(); i++) {
+        addToAggregates(slot.aggregates, slot.routes.at(i));
+    }
+}
+
+RoutingTableEntry* FlatRoutingTable::addRoute(Slot& slot, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    RoutingTableEntry* firstEntry = slot.routes.at(0);
+    RoutingTableEntry* entry = slot.routes.add(nextHop, interface, pheromoneValue);
+    if (slot.routes.at(0) == firstEntry) {
+        addToAggregates(slot.aggregates, entry);
+    }
+    else {
+        // the routes have spilled to the heap
+        recomputeAggregates(slot);
+    }
+    entry->setTimestamp(currentTimestamp);
+    addToNextHopIndex(slot.destination, nextHop);
+    eviction.track(slot.destination, entry);
+    nrOfEntries++;
+    return entry;
+}
+
+RoutingTableEntry* FlatRoutingTable::addRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    // the eviction may move the slots around, so the slot of the destination is looked up afterwards
+    makeRoomForNewEntry();
+    return addRoute(slots[findOrCreateSlot(destination)], nextHop, interface, pheromoneValue);
+}
+
+void FlatRoutingTable::update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
+    Slot* slot;
+    RoutingTableEntry* entry = findStoredEntry(destination, nextHop, interface, slot);
+    if (entry != nullptr) {
+        float oldPheromoneValue = entry->getPheromoneValue();
+        entry->setPheromoneValue(pheromoneValue);
+        routeHasBeenUpdated(*slot, entry, oldPheromoneValue);
+    }
+    else {
+        addRoute(destination, nextHop, interface, pheromoneValue);
+    }
+    notifyEvictionListener();
+}
+
+void FlatRoutingTable::update(AddressPtr destination, RoutingTableEntry* newEntry) {
+    Slot* slot;
+    RoutingTableEntry* entry = findStoredEntry(destination, newEntry->getAddress(), newEntry->getNetworkInterface(), slot);
+    if (entry != nullptr) {
+        float oldPheromoneValue = entry->getPheromoneValue();
+        updateExistingEntry(entry, newEntry);
+        routeHasBeenUpdated(*slot, entry, oldPheromoneValue);
+    }
+    else {
+        addRoute(destination, newEntry->getAddress(), newEntry->getNetworkInterface(), newEntry->getPheromoneValue());
+    }
+    delete newEntry;
+    notifyEvictionListener();
+}
+
+RouteHandle FlatRoutingTable::findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    RouteHandle route = RouteHandle(this, destination, nextHop, interface);
+    size_t slotPosition = findEvaporatedSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        Slot* slot = &slots[slotPosition];
+        unsigned int position = slot->routes.find(nextHop, interface);
+        route.bind(position < slot->routes.size() ? slot->routes.at(position) : nullptr, slot);
+    }
+    return route;
+}
+
+void FlatRoutingTable::update(RouteHandle& route, float pheromoneValue) {
+    RoutingTableEntry* entry = route.getEntry();
+    Slot* slot = (Slot*) route.getRoutes();
+    if (entry != nullptr) {
+        float oldPheromoneValue = entry->getPheromoneValue();
+        entry->setPheromoneValue(pheromoneValue);
+        routeHasBeenUpdated(*slot, entry, oldPheromoneValue);
+        return;
+    }
+
+    if (eviction.isSizeLimited()) {
+        // the eviction may move or delete the slot the handle refers to
+        makeRoomForNewEntry();
+        slot = nullptr;
+    }
+
+    if (slot == nullptr) {
+        slot = &slots[findOrCreateSlot(route.getDestination())];
+    }
+
+    entry = addRoute(*slot, route.getNextHop(), route.getInterface(), pheromoneValue);
+    route.bind(entry, slot);
+    notifyEvictionListener();
+}
+
+void FlatRoutingTable::removeEvictedRoute(const RouteEviction::Route& route) {
+    FlatRoutingTable::removeEntry(route.destination, route.nextHop, route.interface);
+}
+
+bool FlatRoutingTable::removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    bool entryHasBeenRemoved = false;
+    size_t slotPosition = findSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        RouteList& routes = slots[slotPosition].routes;
+        unsigned int position = routes.find(nextHop, interface);
+        if (position < routes.size()) {
+            eviction.forget(routes.at(position));
+            routes.erase(position);
+            removeFromNextHopIndex(destination, nextHop);
+            nrOfEntries--;
+            // the following routes have been moved to the front
+            recomputeAggregates(slots[slotPosition]);
+            entryHasBeenRemoved = true;
+        }
+
+        if (routes.empty()) {
+            // this was the last entry so we can delete the whole slot
+            removeSlot(slotPosition);
+        }
+    }
+    return entryHasBeenRemoved;
+}
+
+RoutingTableEntryList FlatRoutingTable::getPossibleNextHops(const Packet* packet) {
+    RoutingTableEntryList result;
+    for (auto entry: getNextHopCandidates(packet)) {
+        result.push_back(entry);
+    }
+    return result;
+}
+
+NextHopCandidates FlatRoutingTable::getNextHopCandidates(const Packet* packet) {
+    size_t slotPosition = findEvaporatedSlot(packet->getDestination());
+    if (slotPosition != NOT_FOUND) {
+        const Slot& slot = slots[slotPosition];
+        return NextHopCandidates(slot.routes.at(0), slot.routes.size(), packet, &slot.aggregates, this);
+    }
+    return NextHopCandidates();
+}
+
+RoutingTableEntryList FlatRoutingTable::getPossibleNextHops(AddressPtr destination) {
+    RoutingTableEntryList result;
+    size_t slotPosition = findEvaporatedSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        const RouteList& routes = slots[slotPosition].routes;
+        for (unsigned int i = 0; i < routes.size(); i++) {
+            result.push_back(routes.at(i));
+        }
+    }
+    return result;
+}
+
+bool FlatRoutingTable::isDeliverable(const Packet* packet) {
+    return getNextHopCandidates(packet).empty() == false;
+}
+
+bool FlatRoutingTable::isDeliverable(AddressPtr destination) {
+    return findEvaporatedSlot(destination) != NOT_FOUND;
+}
+
+float FlatRoutingTable::getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    size_t slotPosition = findEvaporatedSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        const RouteList& routes = slots[slotPosition].routes;
+        unsigned int position = routes.find(nextHop, interface);
+        if (position < routes.size()) {
+            return routes.at(position)->getPheromoneValue();
+        }
+    }
+    return 0;
+}
+
+bool FlatRoutingTable::exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    size_t slotPosition = findEvaporatedSlot(destination);
+    if (slotPosition != NOT_FOUND) {
+        const RouteList& routes = slots[slotPosition].routes;
+        return routes.find(nextHop, interface) < routes.size();
+    }
+    return false;
+}
+
+unsigned int FlatRoutingTable::getTotalNumberOfEntries() const {
+    return nrOfEntries;
+}
+
+RoutingTableEntryTupel FlatRoutingTable::findEntryAt(int wantedPosition) const {
+    if (wantedPosition >= 0) {
+        unsigned int remaining = wantedPosition;
+        for (size_t i = 0; i < hashes.size(); i++) {
+            if (hashes[i] != EMPTY_SLOT) {
+                const RouteList& routes = slots[i].routes;
+                if (remaining < routes.size()) {
+                    RoutingTableEntryTupel tupel;
+                    tupel.destination = slots[i].destination;
+                    tupel.entry = routes.at(remaining);
+                    return tupel;
+                }
+                remaining -= routes.size();
+            }
+        }
+    }
+
+    throw Exception("FlatRoutingTable::getEntryAt: Index out of bounds");
+}
+
+void FlatRoutingTable::forEachEntry(const RoutingTableVisitor& visitor) const {
+    for (size_t i = 0; i < hashes.size(); i++) {
+        if (hashes[i] != EMPTY_SLOT) {
+            const RouteList& routes = slots[i].routes;
+            for (unsigned int j = 0; j < routes.size(); j++) {
+                visitor(slots[i].destination, routes.at(j));
+            }
+        }
+    }
+}
+
+bool FlatRoutingTable::moveToFirstEntry(IteratorPosition& position) const {
+    position.slot = 0;
+    position.route = 0;
+    while (position.slot < hashes.size() && hashes[position.slot] == EMPTY_SLOT) {
+        position.slot++;
+    }
+    return position.slot < hashes.size();
+}
+
+bool FlatRoutingTable::moveToNextEntry(IteratorPosition& position) const {
+    position.route++;
+    if (position.route >= slots[position.slot].routes.size()) {
+        position.route = 0;
+        do {
+            position.slot++;
+        } while (position.slot < hashes.size() && hashes[position.slot] == EMPTY_SLOT);
+    }
+    return position.slot < hashes.size();
+}
+
+RoutingTableEntryTupel FlatRoutingTable::getEntryAtPosition(const IteratorPosition& position) const {
+    RoutingTableEntryTupel tupel;
+    tupel.destination = slots[position.slot].destination;
+    tupel.entry = slots[position.slot].routes.at(position.route);
+    return tupel;
+}
+
+std::deque<RoutingTableEntryTupel> FlatRoutingTable::getAllRoutesThatLeadOver(AddressPtr nextHop) const {
+    std::deque<RoutingTableEntryTupel> result = std::deque<RoutingTableEntryTupel>();
+
+    NextHopIndex::const_iterator foundNextHop = nextHopIndex.find(nextHop);
+    if (foundNextHop != nextHopIndex.end()) {
+        for (auto& destinationCounter: foundNextHop->second) {
+            size_t slotPosition = findSlot(destinationCounter.first);
+            const RouteList& routes = slots[slotPosition].routes;
+            for (unsigned int i = 0; i < routes.size(); i++) {
+                RoutingTableEntry* entry = routes.at(i);
+                if (entry->getAddress()->equals(nextHop)) {
+                    RoutingTableEntryTupel tupel;
+                    tupel.destination = slots[slotPosition].destination;
+                    tupel.entry = entry;
+                    result.push_back(tupel);
+                }
+            }
+        }
+    }
+    return result;
+}
+
+void FlatRoutingTable::evaporateEntries(long timeDifference) {
+    // all pheromone values are gathered in one contiguous array so the policy can evaporate them in a single batch
+    pheromoneValues.clear();
+    for (size_t i = 0; i < hashes.size(); i++) {
+        if (hashes[i] != EMPTY_SLOT) {
+            RouteList& routes = slots[i].routes;
+            for (unsigned int j = 0; j < routes.size(); j++) {
+                pheromoneValues.push_back(routes.at(j)->getPheromoneValue());
+            }
+        }
+    }
+    evaporationPolicy->evaporate(pheromoneValues.data(), pheromoneValues.size(), timeDifference);
+
+    // the routes are visited in the same order again, so the next value always belongs to the current entry
+    size_t nextPheromoneValue = 0;
+    bool someDestinationHasNoRoutesLeft = false;
+    for (size_t i = 0; i < hashes.size(); i++) {
+        if (hashes[i] != EMPTY_SLOT) {
+            RouteList& routes = slots[i].routes;
+            unsigned int j = 0;
+            while (j < routes.size()) {
+                RoutingTableEntry* entry = routes.at(j);
+                float newPheromoneValue = pheromoneValues[nextPheromoneValue++];
+                if (newPheromoneValue > 0) {
+                    entry->setPheromoneValue(newPheromoneValue);
+                    j++;
+                }
+                else {
+                    removeFromNextHopIndex(slots[i].destination, entry->getAddress());
+                    eviction.forget(entry);
+                    routes.erase(j);
+                    nrOfEntries--;
+                }
+            }
+            recomputeAggregates(slots[i]);
+            someDestinationHasNoRoutesLeft |= routes.empty();
+        }
+    }
+
+    if (someDestinationHasNoRoutesLeft) {
+        /*
+         * The slots are removed in a second pass because removeSlot() moves other slots around.
+         * We need to check the current position again after a removal because another slot
+         * may have been shifted into it.
+         */
+        size_t i = 0;
+        while (i < hashes.size()) {
+            if (hashes[i] != EMPTY_SLOT && slots[i].routes.empty()) {
+                removeSlot(i);
+            }
+            else {
+                i++;
+            }
+        }
+    }
+}
+
+bool FlatRoutingTable::evaporateSlot(size_t position) {
+    RouteList& routes = slots[position].routes;
+    bool someEntryHasChanged = false;
+    unsigned int i = 0;
+    while (i < routes.size()) {
+        RoutingTableEntry* entry = routes.at(i);
+        long timestamp = entry->getTimestamp();
+        if (evaporateEntry(entry)) {
+            someEntryHasChanged |= entry->getTimestamp() != timestamp;
+            i++;
+        }
+        else {
+            removeFromNextHopIndex(slots[position].destination, entry->getAddress());
+            eviction.forget(entry);
+            routes.erase(i);
+            nrOfEntries--;
+            someEntryHasChanged = true;
+        }
+    }
+
+    if (someEntryHasChanged) {
+        recomputeAggregates(slots[position]);
+    }
+    return routes.empty();
+}
+
+void FlatRoutingTable::evaporateBuckets(unsigned int nrOfBuckets) {
+    for (unsigned int i = 0; i < nrOfBuckets && nrOfDestinations > 0; i++) {
+        // start over at the first slot after the last one has been visited
+        if (evaporationCursor >= hashes.size()) {
+            evaporationCursor = 0;
+        }
+
+        if (hashes[evaporationCursor] != EMPTY_SLOT && evaporateSlot(evaporationCursor)) {
+            // another slot may be shifted into this position so the cursor stays where it is
+            removeSlot(evaporationCursor);
+        }
+        else {
+            evaporationCursor++;
+        }
+    }
+}
+
+ARA_NAMESPACE_END
@@ -0,0 +1,120 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "FlowCache.h"
+#include "Environment.h"
+
+#include <cmath>
+
+ARA_NAMESPACE_BEGIN
+
+const unsigned int MIN_NR_OF_FLOWS_BEFORE_PURGE = 64;
+
+FlowCache::FlowCache(unsigned int dwellTimeInMilliSeconds, float maxPheromoneShift) {
+    this->dwellTimeInMilliSeconds = dwellTimeInMilliSeconds;
+    this->maxPheromoneShift = maxPheromoneShift;
+    nextPurgeSize = MIN_NR_OF_FLOWS_BEFORE_PURGE;
+    currentTime = Environment::getClock()->makeTime();
+}
+
+FlowCache::~FlowCache() {
+    for (auto& flow: flows) {
+        delete flow.second.selectionTime;
+        releaseFlowId(flow.first);
+    }
+    delete currentTime;
+}
+
+NextHop* FlowCache::getNextHop(const Packet* packet, RoutingTable* routingTable) {
+    FlowMap::iterator foundFlow = flows.find(FlowId(packet->getSourceId(), packet->getDestinationId()));
+    if (foundFlow == flows.end()) {
+        return nullptr;
+    }
+
+    Flow& flow = foundFlow->second;
+    if (isUsable(flow, packet, routingTable) == false) {
+        // the next route which is used by the flow is a new decision, even if it is the same route
+        flow.isDecisionPending = true;
+        return nullptr;
+    }
+    return &flow.nextHop;
+}
+
+bool FlowCache::isUsable(Flow& flow, const Packet* packet, RoutingTable* routingTable) {
+    currentTime->setToCurrentTime();
+    if (hasExpired(flow)) {
+        return false;
+    }
+
+    const AddressPtr& nextHopAddress = flow.nextHop.getAddress();
+    AddressId nextHopId = AddressTable::getId(nextHopAddress);
+    if (nextHopId == packet->getSenderId() || nextHopId == packet->getSourceId()) {
+        return false;
+    }
+
+    // this is zero if the route does no longer exist
+    float pheromoneValue = routingTable->getPheromoneValue(packet->getDestination(), nextHopAddress, flow.nextHop.getInterface());
+    return pheromoneValue > 0 && std::fabs(pheromoneValue - flow.pheromoneValue) <= maxPheromoneShift * flow.pheromoneValue;
+}
+
+void FlowCache::routeHasBeenUsed(const Packet* packet, const AddressPtr& nextHop, NetworkInterface* interface, float pheromoneValue) {
+    FlowId flowId = FlowId(packet->getSourceId(), packet->getDestinationId());
+    FlowMap::iterator foundFlow = flows.find(flowId);
+    if (foundFlow != flows.end()) {
+        Flow& flow = foundFlow->second;
+        flow.pheromoneValue = pheromoneValue;
+        if (flow.isDecisionPending || flow.nextHop.getAddress()->equals(nextHop) == false || flow.nextHop.getInterface() != interface) {
+            // this is a new forwarding decision
+            flow.nextHop = NextHop(nextHop, interface);
+            flow.selectionTime->setToCurrentTime();
+            flow.isDecisionPending = false;
+        }
+        return;
+    }
+
+    if (flows.size() >= nextPurgeSize) {
+        purgeExpiredFlows();
+    }
+
+    Flow flow = {NextHop(nextHop, interface), pheromoneValue, Environment::getClock()->makeTime(), false};
+    flow.selectionTime->setToCurrentTime();
+    flows.insert(std::make_pair(flowId, flow));
+    AddressTable::retain(flowId.first);
+    AddressTable::retain(flowId.second);
+}
+
+void FlowCache::releaseFlowId(const FlowId& flowId) {
+    AddressTable::release(flowId.first);
+    AddressTable::release(flowId.second);
+}
+
+bool FlowCache::hasExpired(const Flow& flow) const {
+    return currentTime->getDifferenceInMilliSeconds(flow.selectionTime) >= dwellTimeInMilliSeconds;
+}
+
+void FlowCache::purgeExpiredFlows() {
+    currentTime->setToCurrentTime();
+    FlowMap::iterator iterator = flows.begin();
+    while (iterator != flows.end()) {
+        if (hasExpired(iterator->second)) {
+            delete iterator->second.selectionTime;
+            releaseFlowId(iterator->first);
+            iterator = flows.erase(iterator);
+        }
+        else {
+            iterator++;
+        }
+    }
+
+    nextPurgeSize = flows.size() * 2;
+    if (nextPurgeSize < MIN_NR_OF_FLOWS_BEFORE_PURGE) {
+        nextPurgeSize = MIN_NR_OF_FLOWS_BEFORE_PURGE;
+    }
+}
+
+unsigned int FlowCache::size() const {
+    return flows.size();
+}
+
+ARA_NAMESPACE_END
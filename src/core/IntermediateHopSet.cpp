@@ -0,0 +1,96 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "IntermediateHopSet.h"
+
+#include <cstring>
+
+ARA_NAMESPACE_BEGIN
+
+IntermediateHopSet::IntermediateHopSet() {
+    nrOfHops = 0;
+    hasSpilled = false;
+}
+
+bool IntermediateHopSet::contains(AddressId hop) const {
+    return containsInline(hop) || (hasSpilled && bloomFilterContains(hop));
+}
+
+void IntermediateHopSet::insert(const AddressPtr& hopAddress) {
+    AddressId hop = AddressTable::getId(hopAddress);
+    if (containsInline(hop)) {
+        return;
+    }
+
+    if (nrOfHops < INLINE_CAPACITY) {
+        hops[nrOfHops] = hop;
+        hopAddresses[nrOfHops] = hopAddress;
+        nrOfHops++;
+    }
+    else {
+        if (hasSpilled == false) {
+            // the filter may still contain the hops from before the last clear()
+            std::memset(bloomFilter, 0, sizeof(bloomFilter));
+            hasSpilled = true;
+        }
+        else if (bloomFilterContains(hop) && containsSpilled(hop)) {
+            return;
+        }
+        addToBloomFilter(hop);
+        spilledHops.push_back(hopAddress);
+    }
+}
+
+bool IntermediateHopSet::containsSpilled(AddressId hop) const {
+    for (auto& spilledHop: spilledHops) {
+        if (AddressTable::getId(spilledHop) == hop) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void IntermediateHopSet::clear() {
+    for (unsigned int i = 0; i < nrOfHops; i++) {
+        hopAddresses[i].reset();
+    }
+    spilledHops.clear();
+    nrOfHops = 0;
+    hasSpilled = false;
+}
+
+bool IntermediateHopSet::isEmpty() const {
+    return nrOfHops == 0;
+}
+
+bool IntermediateHopSet::containsInline(AddressId hop) const {
+    for (unsigned int i = 0; i < nrOfHops; i++) {
+        if (hops[i] == hop) {
+            return true;
+        }
+    }
+    return false;
+}
+
+uint64_t IntermediateHopSet::hash(AddressId hop) {
+    // Fibonacci hashing spreads the consecutive address ids over all bits
+    return (uint64_t) hop * 0x9E3779B97F4A7C15ull;
+}
+
+bool IntermediateHopSet::bloomFilterContains(AddressId hop) const {
+    uint64_t hashValue = hash(hop);
+    unsigned int first = (hashValue >> 56) % BLOOM_FILTER_SIZE;
+    unsigned int second = (hashValue >> 48) % BLOOM_FILTER_SIZE;
+    return ((bloomFilter[first / 64] >> (first % 64)) & 1) && ((bloomFilter[second / 64] >> (second % 64)) & 1);
+}
+
+void IntermediateHopSet::addToBloomFilter(AddressId hop) {
+    uint64_t hashValue = hash(hop);
+    unsigned int first = (hashValue >> 56) % BLOOM_FILTER_SIZE;
+    unsigned int second = (hashValue >> 48) % BLOOM_FILTER_SIZE;
+    bloomFilter[first / 64] |= (uint64_t) 1 << (first % 64);
+    bloomFilter[second / 64] |= (uint64_t) 1 << (second % 64);
+}
+
+ARA_NAMESPACE_END
@@ -13,7 +13,7 @@ NextHop::NextHop(shared_ptr<Address> address, NetworkInterface* interface) {
     this->interface = interface;
 }
 
-shared_ptr<Address> NextHop::getAddress() {
+const shared_ptr<Address>& NextHop::getAddress() {
     return address;
 }
 
@@ -0,0 +1,227 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "NextHopCandidates.h"
+#include "RoutingTable.h"
+
+#include <algorithm>
+
+ARA_NAMESPACE_BEGIN
+
+NextHopCandidates::NextHopCandidates() {
+    packet = nullptr;
+    sourceId = UNKNOWN_ADDRESS_ID;
+    senderId = UNKNOWN_ADDRESS_ID;
+    entryList = nullptr;
+    entryArray = nullptr;
+    nrOfEntries = 0;
+    aggregates = nullptr;
+    routingTable = nullptr;
+    isExclusionKnown = false;
+    hasExcludedRoute = false;
+}
+
+NextHopCandidates::NextHopCandidates(const std::deque<RoutingTableEntry*>* entries, const Packet* packet) : packet(packet), sourceId(packet->getSourceId()), senderId(packet->getSenderId()) {
+    entryList = entries;
+    entryArray = nullptr;
+    nrOfEntries = entries->size();
+    aggregates = nullptr;
+    routingTable = nullptr;
+    isExclusionKnown = false;
+    hasExcludedRoute = false;
+}
+
+NextHopCandidates::NextHopCandidates(const std::deque<RoutingTableEntry*>* entries, const Packet* packet, const PheromoneAggregates* aggregates, const RoutingTable* routingTable) : NextHopCandidates(entries, packet) {
+    this->aggregates = aggregates;
+    this->routingTable = routingTable;
+}
+
+NextHopCandidates::NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet) : packet(packet), sourceId(packet->getSourceId()), senderId(packet->getSenderId()) {
+    entryList = nullptr;
+    entryArray = entries;
+    this->nrOfEntries = nrOfEntries;
+    aggregates = nullptr;
+    routingTable = nullptr;
+    isExclusionKnown = false;
+    hasExcludedRoute = false;
+}
+
+NextHopCandidates::NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet, const PheromoneAggregates* aggregates, const RoutingTable* routingTable) : NextHopCandidates(entries, nrOfEntries, packet) {
+    this->aggregates = aggregates;
+    this->routingTable = routingTable;
+}
+
+NextHopCandidates::NextHopCandidates(RoutingTableEntry* entries, unsigned int nrOfEntries, const Packet* packet, const EpochGuard& guard) : NextHopCandidates(entries, nrOfEntries, packet) {
+    this->guard = guard;
+}
+
+RoutingTableEntry* NextHopCandidates::getEntryAt(unsigned int position) const {
+    if (entryList != nullptr) {
+        return (*entryList)[position];
+    }
+    else {
+        return entryArray + position;
+    }
+}
+
+bool NextHopCandidates::isCandidate(unsigned int position) const {
+    return isCandidate(getEntryAt(position));
+}
+
+bool NextHopCandidates::isCandidate(RoutingTableEntry* entry) const {
+    AddressId possibleNextHop = AddressTable::getId(entry->getAddress());
+    return possibleNextHop != sourceId && possibleNextHop != senderId;
+}
+
+unsigned int NextHopCandidates::skipToCandidate(unsigned int position) const {
+    while (position < nrOfEntries && isCandidate(position) == false) {
+        position++;
+    }
+    return position;
+}
+
+NextHopCandidates::Iterator NextHopCandidates::begin() const {
+    return Iterator(this, skipToCandidate(0));
+}
+
+NextHopCandidates::Iterator NextHopCandidates::end() const {
+    return Iterator(this, nrOfEntries);
+}
+
+bool NextHopCandidates::empty() const {
+    return skipToCandidate(0) == nrOfEntries;
+}
+
+unsigned int NextHopCandidates::size() const {
+    unsigned int nrOfCandidates = 0;
+    for (unsigned int i = 0; i < nrOfEntries; i++) {
+        if (isCandidate(i)) {
+            nrOfCandidates++;
+        }
+    }
+    return nrOfCandidates;
+}
+
+RoutingTableEntry* NextHopCandidates::getBestCandidate() const {
+    if (aggregates != nullptr && aggregates->bestEntry != nullptr && isCandidate(aggregates->bestEntry)) {
+        return aggregates->bestEntry;
+    }
+
+    RoutingTableEntry* bestEntry = nullptr;
+    for (auto candidate: *this) {
+        if (bestEntry == nullptr || candidate->getPheromoneValue() > bestEntry->getPheromoneValue()) {
+            bestEntry = candidate;
+        }
+    }
+    return bestEntry;
+}
+
+float NextHopCandidates::getSumOfPheromoneValues() const {
+    if (isAggregationComplete()) {
+        return aggregates->sumOfPheromoneValues;
+    }
+
+    float sumOfPheromoneValues = 0;
+    for (auto candidate: *this) {
+        sumOfPheromoneValues += candidate->getPheromoneValue();
+    }
+    return sumOfPheromoneValues;
+}
+
+RoutingTableEntry* NextHopCandidates::sample(float randomNumber) const {
+    if (isAggregationComplete()) {
+        std::vector<float>& cumulativeSelectionWeights = aggregates->cumulativeSelectionWeights;
+        if (cumulativeSelectionWeights.empty()) {
+            float cumulativeSum = 0;
+            for (unsigned int i = 0; i < nrOfEntries; i++) {
+                cumulativeSum += routingTable->getSelectionWeight(getEntryAt(i));
+                cumulativeSelectionWeights.push_back(cumulativeSum);
+            }
+        }
+
+        // find the first route whose cumulative sum reaches the random number
+        float threshold = randomNumber * cumulativeSelectionWeights.back();
+        unsigned int position = std::lower_bound(cumulativeSelectionWeights.begin(), cumulativeSelectionWeights.end(), threshold) - cumulativeSelectionWeights.begin();
+        if (position == nrOfEntries) {
+            // the random number exceeds the sum due to rounding errors
+            position--;
+        }
+        return getEntryAt(position);
+    }
+
+    float sumOfSelectionWeights = 0;
+    unsigned int nrOfCandidates = 0;
+    for (auto candidate: *this) {
+        sumOfSelectionWeights += getSelectionWeight(candidate);
+        nrOfCandidates++;
+    }
+
+    if (sumOfSelectionWeights <= 0) {
+        // no candidate has any weight, so each of them is equally likely
+        unsigned int selectedCandidate = std::min((unsigned int) (randomNumber * nrOfCandidates), nrOfCandidates - 1);
+        for (auto candidate: *this) {
+            if (selectedCandidate-- == 0) {
+                return candidate;
+            }
+        }
+        return nullptr;
+    }
+
+    float cumulativeSum = 0;
+    RoutingTableEntry* selectedEntry = nullptr;
+    for (auto candidate: *this) {
+        selectedEntry = candidate;
+        cumulativeSum += getSelectionWeight(candidate) / sumOfSelectionWeights;
+        if (randomNumber <= cumulativeSum) {
+            break;
+        }
+    }
+
+    // if the cumulative sum falls short of 1 due to rounding errors this is the last candidate
+    return selectedEntry;
+}
+
+float NextHopCandidates::getSelectionWeight(RoutingTableEntry* entry) const {
+    if (routingTable != nullptr) {
+        return routingTable->getSelectionWeight(entry);
+    }
+    return entry->getPheromoneValue();
+}
+
+bool NextHopCandidates::isAggregationComplete() const {
+    if (aggregates == nullptr || nrOfEntries == 0) {
+        return false;
+    }
+
+    // the aggregates can only be used directly if no route needs to be skipped
+    if (isExclusionKnown == false) {
+        hasExcludedRoute = size() != nrOfEntries;
+        isExclusionKnown = true;
+    }
+    return hasExcludedRoute == false;
+}
+
+NextHopCandidates::Iterator::Iterator(const NextHopCandidates* candidates, unsigned int position) {
+    this->candidates = candidates;
+    this->position = position;
+}
+
+RoutingTableEntry* NextHopCandidates::Iterator::operator*() const {
+    return candidates->getEntryAt(position);
+}
+
+NextHopCandidates::Iterator& NextHopCandidates::Iterator::operator++() {
+    position = candidates->skipToCandidate(position + 1);
+    return *this;
+}
+
+bool NextHopCandidates::Iterator::operator==(const Iterator& other) const {
+    return position == other.position;
+}
+
+bool NextHopCandidates::Iterator::operator!=(const Iterator& other) const {
+    return position != other.position;
+}
+
+ARA_NAMESPACE_END
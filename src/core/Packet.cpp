@@ -4,56 +4,49 @@
 
 #include "Packet.h"
 #include "PacketType.h"
-#include <cstring>
+#include "PacketPool.h"
 
 typedef std::shared_ptr<ARA::Address> AddressPtr;
 
 namespace ARA {
 
-Packet::Packet(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize) {
+Packet::Packet(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize)
+    : Packet(source, destination, sender, type, seqNr, ttl, PayloadBuffer(payload, payloadSize)) {
+}
+
+Packet::Packet(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload) : payload(payload) {
     this->source = source;
     this->destination = destination;
     this->sender = sender;
     this->previousHop = sender;
     this->type = type;
     this->seqNr = seqNr;
+    this->ttl = ttl;
+}
 
-    if(payload != nullptr) {
-        if(payloadSize == 0) {
-            // assume this is a string and calculate the size
-            payloadSize = std::strlen(payload)+1;
-        }
-        char* tmpPayload = new char[payloadSize];
-        memcpy(tmpPayload, payload, payloadSize);
-        this->payload = tmpPayload;
-    }
-    else {
-        this->payload = nullptr;
-    }
+Packet::~Packet() {}
 
-    this->payloadSize = payloadSize;
-    this->ttl = ttl;
+void* Packet::operator new(std::size_t size) {
+    return PacketPool::allocate(size);
 }
 
-Packet::~Packet() {
-   if(payload != nullptr) {
-        delete[] payload;
-   }
+void Packet::operator delete(void* packet, std::size_t size) {
+    PacketPool::release(packet, size);
 }
 
-AddressPtr Packet::getSource() const {
+const AddressPtr& Packet::getSource() const {
     return source;
 }
 
-AddressPtr Packet::getDestination() const {
+const AddressPtr& Packet::getDestination() const {
     return destination;
 }
 
-AddressPtr Packet::getSender() const {
+const AddressPtr& Packet::getSender() const {
     return sender;
 }
 
-AddressPtr Packet::getPreviousHop() const {
+const AddressPtr& Packet::getPreviousHop() const {
     return previousHop;
 }
 
@@ -70,11 +63,15 @@ unsigned int Packet::getTTL() const {
 }
 
 const char* Packet::getPayload() const {
-    return payload;
+    return payload.getData();
 }
 
 unsigned int Packet::getPayloadLength() const {
-    return payloadSize;
+    return payload.getSize();
+}
+
+const PayloadBuffer& Packet::getPayloadBuffer() const {
+    return payload;
 }
 
 Packet* Packet::setSender(AddressPtr newSender) {
@@ -101,13 +98,12 @@ void Packet::decreaseTTL(int times) {
 }
 
 bool Packet::equals(const Packet* otherPacket) const {
-    return this->seqNr == otherPacket->getSequenceNumber() && this->source->equals(otherPacket->getSource());
+    return this->seqNr == otherPacket->getSequenceNumber() && getSourceId() == otherPacket->getSourceId();
 }
 
 size_t Packet::getHashValue() const {
-    // TODO Review and tweak this hash value generation (naiv implementation)
-    size_t sourceHash = source->getHashValue();
-    return sourceHash + seqNr;
+    // the source ids are consecutive, so they are spread out to not collide with the sequence numbers of other sources
+    return (size_t) getSourceId() * 0x9e3779b1u + seqNr;
 }
 
 } /* namespace ARA */
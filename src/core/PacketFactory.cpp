@@ -16,11 +16,15 @@ void PacketFactory::setPreviousHopFeature(bool isActivated) {
 }
 
 Packet* PacketFactory::makeClone(const Packet* originalPacket) {
-    return makePacket(originalPacket->getSource(), originalPacket->getDestination(), originalPacket->getSender(), originalPacket->getType(), originalPacket->getSequenceNumber(), originalPacket->getTTL(), originalPacket->getPayload(), originalPacket->getPayloadLength(), originalPacket->getPreviousHop());
+    return makePacket(originalPacket->getSource(), originalPacket->getDestination(), originalPacket->getSender(), originalPacket->getType(), originalPacket->getSequenceNumber(), originalPacket->getTTL(), originalPacket->getPayloadBuffer(), originalPacket->getPreviousHop());
 }
 
 Packet* PacketFactory::makeDataPacket(AddressPtr source, AddressPtr destination, unsigned int sequenceNumber, const char* payload, unsigned int payloadSize) {
-    return makePacket(source, destination, source, PacketType::DATA, sequenceNumber, maxHopCount, payload, payloadSize);
+    return makePacket(source, destination, source, PacketType::DATA, sequenceNumber, maxHopCount, PayloadBuffer(payload, payloadSize));
+}
+
+Packet* PacketFactory::makeDataPacket(AddressPtr source, AddressPtr destination, unsigned int sequenceNumber, const PayloadBuffer& payload) {
+    return makePacket(source, destination, source, PacketType::DATA, sequenceNumber, maxHopCount, payload);
 }
 
 Packet* PacketFactory::makeFANT(AddressPtr source, AddressPtr destination, unsigned int sequenceNumber) {
@@ -51,14 +55,26 @@ Packet* PacketFactory::makePANT(AddressPtr source, AddressPtr destination, unsig
     return makePacket(source, destination, source, PacketType::PANT, sequenceNumber, maxHopCount);
 }
 
-Packet* PacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize, AddressPtr previousHop) {
-    Packet* packet = new Packet(source, destination, sender, type, seqNr, ttl, payload, payloadSize);
+Packet* PacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload, AddressPtr previousHop) {
+    Packet* packet = new Packet(source, destination, sender, type, seqNr, ttl, payload);
     if(previousHop != nullptr) {
         packet->setPreviousHop(previousHop);
     }
     return packet;
 }
 
+void PacketFactory::release(Packet* packet) {
+    delete packet;
+}
+
+void PacketFactory::reservePackets(unsigned int nrOfPackets) {
+    PacketPool::reserve(getPacketSize(), nrOfPackets);
+}
+
+std::size_t PacketFactory::getPacketSize() const {
+    return sizeof(Packet);
+}
+
 void PacketFactory::setMaxHopCount(int n) {
     maxHopCount = n;
 }
@@ -0,0 +1,252 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "PacketPool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+
+ARA_NAMESPACE_BEGIN
+
+namespace {
+
+    const unsigned int NR_OF_SIZE_CLASSES = PacketPool::MAX_POOLED_PACKET_SIZE / PacketPool::SIZE_CLASS_GRANULARITY;
+
+    struct FreePacket {
+        FreePacket* next;
+    };
+
+    struct FreeList {
+        FreePacket* first;
+        unsigned int length;
+    };
+
+    /**
+     * This is set when the pool of the thread has been destroyed. Packets that are deleted afterwards
+     * (e.g. by static objects) are freed directly.
+     */
+    thread_local bool threadPoolIsDestroyed = false;
+
+    /**
+     * The counters of the statistics of one thread. They are only written by their thread, so they
+     * are incremented without any read-modify-write operation. They are atomic anyway, because
+     * PacketPool::getStatistics reads the counters of all threads. All accesses are relaxed.
+     */
+    struct Counters {
+        std::atomic<unsigned long> nrOfAllocations;
+        std::atomic<unsigned long> nrOfReusedPackets;
+        std::atomic<unsigned long> nrOfReleases;
+
+        /** The packets allocated by this thread minus the packets released by this thread */
+        std::atomic<long> nrOfPacketsInUse;
+        std::atomic<long> maxNrOfPacketsInUse;
+    };
+
+    template<typename T> inline void add(std::atomic<T>& counter, T value) {
+        counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    struct ThreadPool;
+
+    /**
+     * The registry of the pools of all running threads. The counters of a thread are added to the
+     * retired counters when it ends. The registry is only used by the statistics and when a thread
+     * starts or ends, so the lock is never taken while allocating or releasing packets.
+     */
+    std::mutex registryLock;
+    ThreadPool* firstThreadPool = nullptr;
+    Counters retiredCounters = {};
+
+    /**
+     * The free lists and counters of one thread. The free packets are freed when the thread ends.
+     */
+    struct ThreadPool {
+        FreeList freeLists[NR_OF_SIZE_CLASSES];
+        unsigned int maxNrOfFreePackets;
+        unsigned long nrOfFreePackets;
+        Counters counters;
+        ThreadPool* previous;
+        ThreadPool* next;
+
+        ThreadPool() : freeLists(), maxNrOfFreePackets(4096), nrOfFreePackets(0), counters(), previous(nullptr) {
+            std::lock_guard<std::mutex> guard(registryLock);
+            next = firstThreadPool;
+            if (next != nullptr) {
+                next->previous = this;
+            }
+            firstThreadPool = this;
+        }
+
+        ~ThreadPool() {
+            clear();
+            threadPoolIsDestroyed = true;
+
+            std::lock_guard<std::mutex> guard(registryLock);
+            add(retiredCounters.nrOfAllocations, counters.nrOfAllocations.load(std::memory_order_relaxed));
+            add(retiredCounters.nrOfReusedPackets, counters.nrOfReusedPackets.load(std::memory_order_relaxed));
+            add(retiredCounters.nrOfReleases, counters.nrOfReleases.load(std::memory_order_relaxed));
+            add(retiredCounters.nrOfPacketsInUse, counters.nrOfPacketsInUse.load(std::memory_order_relaxed));
+            add(retiredCounters.maxNrOfPacketsInUse, counters.maxNrOfPacketsInUse.load(std::memory_order_relaxed));
+            if (previous != nullptr) {
+                previous->next = next;
+            }
+            else {
+                firstThreadPool = next;
+            }
+            if (next != nullptr) {
+                next->previous = previous;
+            }
+        }
+
+        void clear() {
+            for (auto& freeList: freeLists) {
+                while (freeList.first != nullptr) {
+                    FreePacket* packet = freeList.first;
+                    freeList.first = packet->next;
+                    ::operator delete(packet);
+                }
+                freeList.length = 0;
+            }
+            nrOfFreePackets = 0;
+        }
+    };
+
+    thread_local ThreadPool threadPool;
+
+    inline bool isPooled(std::size_t size) {
+        return size <= PacketPool::MAX_POOLED_PACKET_SIZE;
+    }
+
+    inline unsigned int getSizeClass(std::size_t size) {
+        return size == 0 ? 0 : (size - 1) / PacketPool::SIZE_CLASS_GRANULARITY;
+    }
+
+    inline std::size_t getBlockSize(unsigned int sizeClass) {
+        return (sizeClass + 1) * PacketPool::SIZE_CLASS_GRANULARITY;
+    }
+}
+
+void* PacketPool::allocate(std::size_t size) {
+    if (threadPoolIsDestroyed) {
+        return ::operator new(size);
+    }
+
+    Counters& counters = threadPool.counters;
+    add(counters.nrOfAllocations, 1ul);
+    long nrOfPacketsInUse = counters.nrOfPacketsInUse.load(std::memory_order_relaxed) + 1;
+    counters.nrOfPacketsInUse.store(nrOfPacketsInUse, std::memory_order_relaxed);
+    if (nrOfPacketsInUse > counters.maxNrOfPacketsInUse.load(std::memory_order_relaxed)) {
+        counters.maxNrOfPacketsInUse.store(nrOfPacketsInUse, std::memory_order_relaxed);
+    }
+
+    if (isPooled(size) == false) {
+        return ::operator new(size);
+    }
+
+    unsigned int sizeClass = getSizeClass(size);
+    FreeList& freeList = threadPool.freeLists[sizeClass];
+    if (freeList.first != nullptr) {
+        FreePacket* packet = freeList.first;
+        freeList.first = packet->next;
+        freeList.length--;
+        threadPool.nrOfFreePackets--;
+        add(counters.nrOfReusedPackets, 1ul);
+        return packet;
+    }
+
+    return ::operator new(getBlockSize(sizeClass));
+}
+
+void PacketPool::release(void* packet, std::size_t size) {
+    if (packet == nullptr) {
+        return;
+    }
+    if (threadPoolIsDestroyed) {
+        ::operator delete(packet);
+        return;
+    }
+
+    add(threadPool.counters.nrOfReleases, 1ul);
+    add(threadPool.counters.nrOfPacketsInUse, -1l);
+
+    if (isPooled(size)) {
+        FreeList& freeList = threadPool.freeLists[getSizeClass(size)];
+        if (freeList.length < threadPool.maxNrOfFreePackets) {
+            FreePacket* freePacket = static_cast<FreePacket*>(packet);
+            freePacket->next = freeList.first;
+            freeList.first = freePacket;
+            freeList.length++;
+            threadPool.nrOfFreePackets++;
+            return;
+        }
+    }
+
+    ::operator delete(packet);
+}
+
+void PacketPool::reserve(std::size_t size, unsigned int nrOfPackets) {
+    if (isPooled(size) == false) {
+        return;
+    }
+
+    unsigned int sizeClass = getSizeClass(size);
+    FreeList& freeList = threadPool.freeLists[sizeClass];
+    while (freeList.length < nrOfPackets && freeList.length < threadPool.maxNrOfFreePackets) {
+        FreePacket* packet = static_cast<FreePacket*>(::operator new(getBlockSize(sizeClass)));
+        packet->next = freeList.first;
+        freeList.first = packet;
+        freeList.length++;
+        threadPool.nrOfFreePackets++;
+    }
+}
+
+void PacketPool::clear() {
+    threadPool.clear();
+}
+
+void PacketPool::setMaxNrOfFreePackets(unsigned int maxNrOfFreePackets) {
+    threadPool.maxNrOfFreePackets = maxNrOfFreePackets;
+}
+
+namespace {
+
+    void addCounters(PacketPoolStatistics& statistics, const Counters& counters) {
+        statistics.nrOfAllocations += counters.nrOfAllocations.load(std::memory_order_relaxed);
+        statistics.nrOfReusedPackets += counters.nrOfReusedPackets.load(std::memory_order_relaxed);
+        statistics.nrOfReleases += counters.nrOfReleases.load(std::memory_order_relaxed);
+        statistics.nrOfPacketsInUse += counters.nrOfPacketsInUse.load(std::memory_order_relaxed);
+        statistics.maxNrOfPacketsInUse += counters.maxNrOfPacketsInUse.load(std::memory_order_relaxed);
+    }
+
+    void resetCounters(Counters& counters) {
+        counters.nrOfAllocations.store(0, std::memory_order_relaxed);
+        counters.nrOfReusedPackets.store(0, std::memory_order_relaxed);
+        counters.nrOfReleases.store(0, std::memory_order_relaxed);
+        counters.maxNrOfPacketsInUse.store(counters.nrOfPacketsInUse.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+PacketPoolStatistics PacketPool::getStatistics() {
+    PacketPoolStatistics statistics = {};
+    // the pool of the calling thread must be registered before the lock is taken
+    statistics.nrOfFreePackets = threadPool.nrOfFreePackets;
+
+    std::lock_guard<std::mutex> guard(registryLock);
+    addCounters(statistics, retiredCounters);
+    for (ThreadPool* pool = firstThreadPool; pool != nullptr; pool = pool->next) {
+        addCounters(statistics, pool->counters);
+    }
+    return statistics;
+}
+
+void PacketPool::resetStatistics() {
+    std::lock_guard<std::mutex> guard(registryLock);
+    resetCounters(retiredCounters);
+    for (ThreadPool* pool = firstThreadPool; pool != nullptr; pool = pool->next) {
+        resetCounters(pool->counters);
+    }
+}
+
+ARA_NAMESPACE_END
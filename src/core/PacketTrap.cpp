@@ -14,10 +14,7 @@ PacketTrap::~PacketTrap() {
     // delete all packets that might still be trapped
     TrappedPacketsMap::iterator iterator;
     for (iterator=trappedPackets.begin(); iterator!=trappedPackets.end(); iterator++) {
-        std::pair<AddressPtr, PacketQueue> entryPair = *iterator;
-        PacketQueue packetQueue = entryPair.second;
-
-        for(auto& packet: packetQueue) {
+        for(auto& packet: iterator->second) {
             delete packet;
         }
     }
@@ -25,21 +22,14 @@ PacketTrap::~PacketTrap() {
 }
 
 void PacketTrap::trapPacket(Packet* packet) {
-    AddressPtr destination = packet->getDestination();
-    if(trappedPackets.find(destination) == trappedPackets.end()) {
-        PacketQueue newList = PacketQueue();
-        trappedPackets[destination] = newList;
-    }
-
-    trappedPackets[destination].push_back(packet);
+    // the queue is created if this is the first packet for its destination
+    trappedPackets[packet->getDestinationId()].push_back(packet);
 }
 
 bool PacketTrap::contains(Packet* packet) {
-    AddressPtr packetDestination = packet->getDestination();
-    TrappedPacketsMap::const_iterator found = trappedPackets.find(packetDestination);
+    TrappedPacketsMap::const_iterator found = trappedPackets.find(packet->getDestinationId());
     if(found != trappedPackets.end()) {
-        PacketQueue packetQueue = found->second;
-        for(auto& trappedPacket: packetQueue) {
+        for(auto& trappedPacket: found->second) {
             if(trappedPacket->equals(packet)) {
                 return true;
             }
@@ -53,12 +43,13 @@ bool PacketTrap::isEmpty() {
     return trappedPackets.size() == 0;
 }
 
-PacketQueue PacketTrap::untrapDeliverablePackets(AddressPtr destination) {
-    TrappedPacketsMap::const_iterator packetsForDestination = trappedPackets.find(destination);
+PacketQueue PacketTrap::untrapDeliverablePackets(const AddressPtr& destination) {
+    TrappedPacketsMap::iterator packetsForDestination = trappedPackets.find(AddressTable::getId(destination));
     if(packetsForDestination != trappedPackets.end()) {
         if(routingTable->isDeliverable(destination)) {
-            PacketQueue deliverablePackets = packetsForDestination->second;
-            trappedPackets.erase(destination);
+            PacketQueue deliverablePackets;
+            deliverablePackets.swap(packetsForDestination->second);
+            trappedPackets.erase(packetsForDestination);
             return deliverablePackets;
         }
     }
@@ -67,26 +58,27 @@ PacketQueue PacketTrap::untrapDeliverablePackets(AddressPtr destination) {
     return PacketQueue();
 }
 
-PacketQueue PacketTrap::removePacketsForDestination(AddressPtr destination) {
+PacketQueue PacketTrap::removePacketsForDestination(const AddressPtr& destination) {
     PacketQueue removedPackets = PacketQueue();
-    TrappedPacketsMap::const_iterator packetsForDestination = trappedPackets.find(destination);
+    TrappedPacketsMap::iterator packetsForDestination = trappedPackets.find(AddressTable::getId(destination));
 
     if(packetsForDestination != trappedPackets.end()) {
-        removedPackets = packetsForDestination->second;
+        removedPackets.swap(packetsForDestination->second);
         trappedPackets.erase(packetsForDestination);
     }
 
     return removedPackets;
 }
 
-unsigned int PacketTrap::getNumberOfTrappedPackets(AddressPtr destination) {
-    unsigned int result = 0;
+unsigned int PacketTrap::getNumberOfTrappedPackets(const AddressPtr& destination) {
+    if (destination != nullptr) {
+        TrappedPacketsMap::const_iterator packetsForDestination = trappedPackets.find(AddressTable::getId(destination));
+        return packetsForDestination == trappedPackets.end() ? 0 : packetsForDestination->second.size();
+    }
 
+    unsigned int result = 0;
     for (TrappedPacketsMap::iterator entryPair=trappedPackets.begin(); entryPair!=trappedPackets.end(); entryPair++) {
-        if(destination == nullptr || destination->equals(entryPair->first)) {
-            PacketQueue packetQueue = entryPair->second;
-            result += packetQueue.size();
-        }
+        result += entryPair->second.size();
     }
 
     return result;
@@ -0,0 +1,136 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "PayloadBuffer.h"
+
+#include <cstring>
+#include <new>
+
+ARA_NAMESPACE_BEGIN
+
+PayloadBuffer::PayloadBuffer(const char* data, unsigned int size) : buffer(nullptr), inlineSize(0) {
+    if (data == nullptr) {
+        return;
+    }
+
+    if (size == 0) {
+        size = std::strlen(data) + 1;
+    }
+
+    if (size <= INLINE_CAPACITY) {
+        std::memcpy(inlineData, data, size);
+        inlineSize = size;
+    }
+    else {
+        buffer = makeBuffer(nullptr, size, false);
+        char* copiedData = reinterpret_cast<char*>(buffer + 1);
+        std::memcpy(copiedData, data, size);
+        buffer->data = copiedData;
+    }
+}
+
+PayloadBuffer::PayloadBuffer(const PayloadBuffer& other) : buffer(nullptr), inlineSize(0) {
+    copyFrom(other);
+}
+
+PayloadBuffer::PayloadBuffer(PayloadBuffer&& other) : buffer(nullptr), inlineSize(0) {
+    moveFrom(other);
+}
+
+PayloadBuffer& PayloadBuffer::operator=(const PayloadBuffer& other) {
+    if (this != &other) {
+        // retain the other buffer first in case both share the same data
+        PayloadBuffer copy = PayloadBuffer(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+PayloadBuffer& PayloadBuffer::operator=(PayloadBuffer&& other) {
+    if (this != &other) {
+        release();
+        moveFrom(other);
+    }
+    return *this;
+}
+
+PayloadBuffer::~PayloadBuffer() {
+    release();
+}
+
+PayloadBuffer PayloadBuffer::adopt(char* data, unsigned int size) {
+    if (data == nullptr) {
+        return PayloadBuffer();
+    }
+    return PayloadBuffer(makeBuffer(data, size, true));
+}
+
+unsigned int PayloadBuffer::getNrOfReferences() const {
+    if (isInline()) {
+        return 1;
+    }
+    return buffer == nullptr ? 0 : buffer->nrOfReferences.load(std::memory_order_relaxed);
+}
+
+PayloadBuffer::Buffer* PayloadBuffer::makeBuffer(const char* data, unsigned int size, bool isAdopted) {
+    // adopted data lives in its own allocation, copied data right behind the header
+    std::size_t allocationSize = sizeof(Buffer) + (isAdopted ? 0 : size);
+    Buffer* buffer = new (::operator new(allocationSize)) Buffer();
+    buffer->nrOfReferences.store(1, std::memory_order_relaxed);
+    buffer->data = data;
+    buffer->size = size;
+    buffer->isAdopted = isAdopted;
+    return buffer;
+}
+
+/**
+ * Makes this (empty) buffer a copy of the other buffer, which shares its data if it is not inline.
+ */
+void PayloadBuffer::copyFrom(const PayloadBuffer& other) {
+    if (other.isInline()) {
+        std::memcpy(inlineData, other.inlineData, other.inlineSize);
+        inlineSize = other.inlineSize;
+    }
+    else {
+        buffer = other.buffer;
+        retain();
+    }
+}
+
+/**
+ * Makes this (empty) buffer take over the data of the other buffer, which is empty afterwards.
+ */
+void PayloadBuffer::moveFrom(PayloadBuffer& other) {
+    if (other.isInline()) {
+        std::memcpy(inlineData, other.inlineData, other.inlineSize);
+        inlineSize = other.inlineSize;
+        other.inlineSize = 0;
+    }
+    else {
+        buffer = other.buffer;
+    }
+    other.buffer = nullptr;
+}
+
+void PayloadBuffer::retain() {
+    if (isInline() == false && buffer != nullptr) {
+        buffer->nrOfReferences.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+void PayloadBuffer::release() {
+    if (isInline()) {
+        inlineSize = 0;
+    }
+    else if (buffer != nullptr && buffer->nrOfReferences.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        if (buffer->isAdopted) {
+            delete[] buffer->data;
+        }
+        buffer->~Buffer();
+        ::operator delete(buffer);
+    }
+    buffer = nullptr;
+}
+
+ARA_NAMESPACE_END
@@ -0,0 +1,73 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "PeerStateTable.h"
+
+#include <tuple>
+
+ARA_NAMESPACE_BEGIN
+
+PeerState::PeerState() {
+    lastRouteDiscoverySequenceNumber = 0;
+    hasSeenRouteDiscovery = false;
+    lastActivityTime = nullptr;
+    lastActivityInterface = nullptr;
+    isRouteDiscoveryRunning = false;
+    routeDiscoveryTimer = nullptr;
+    pantTimer = nullptr;
+}
+
+PeerStateTable::~PeerStateTable() {
+    for (auto& state: states) {
+        AddressTable::release(state.first);
+    }
+}
+
+PeerState* PeerStateTable::lookup(AddressId id, bool create) {
+    PeerState* state;
+    std::unordered_map<AddressId, PeerState>::iterator found = states.find(id);
+    if (found != states.end()) {
+        state = &found->second;
+    }
+    else if (create) {
+        // the new state is constructed in place, because the sequence number window is rather large
+        state = &states.emplace(std::piecewise_construct, std::forward_as_tuple(id), std::forward_as_tuple()).first->second;
+        AddressTable::retain(id);
+    }
+    else {
+        return nullptr;
+    }
+
+    lastId = id;
+    lastState = state;
+    return state;
+}
+
+void PeerStateTable::erase(AddressId id) {
+    std::unordered_map<AddressId, PeerState>::iterator found = states.find(id);
+    if (found == states.end()) {
+        return;
+    }
+
+    if (id == lastId) {
+        lastId = UNKNOWN_ADDRESS_ID;
+        lastState = nullptr;
+    }
+    states.erase(found);
+    AddressTable::release(id);
+}
+
+PeerStateTable::iterator PeerStateTable::begin() {
+    return states.begin();
+}
+
+PeerStateTable::iterator PeerStateTable::end() {
+    return states.end();
+}
+
+unsigned int PeerStateTable::size() const {
+    return states.size();
+}
+
+ARA_NAMESPACE_END
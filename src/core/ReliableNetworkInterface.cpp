@@ -98,12 +98,10 @@ void ReliableNetworkInterface::receive(Packet* packet) {
 }
 
 void ReliableNetworkInterface::handleNonAckPacket(Packet* packet) {
-    AddressPtr destination = packet->getDestination();
-
     if(packet->isAntPacket() == false) { // TODO actually we want to test if the packet has been sent via a broadcast but this is currently not possible with the API
         Packet* ackPacket = packetFactory->makeAcknowledgmentPacket(packet, getLocalAddress());
         doSend(ackPacket, packet->getSender());
-        delete ackPacket;
+        packetFactory->release(ackPacket);
     }
 
     client->receivePacket(packet, this);
@@ -144,7 +142,7 @@ void ReliableNetworkInterface::handleAckPacket(Packet* ackPacket) {
         }
     }
 
-    delete ackPacket;
+    packetFactory->release(ackPacket);
 }
 
 std::deque<const Packet*> ReliableNetworkInterface::getUnacknowledgedPackets() const {
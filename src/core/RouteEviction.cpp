@@ -0,0 +1,162 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "RouteEviction.h"
+
+ARA_NAMESPACE_BEGIN
+
+const unsigned int RouteEviction::NR_OF_CANDIDATES;
+const unsigned int RouteEviction::NONE;
+
+RouteEviction::RouteEviction() {
+    first = NONE;
+    last = NONE;
+    firstFree = NONE;
+    nrOfRoutes = 0;
+    maxNrOfEntries = 0;
+    pheromoneAware = true;
+    listener = nullptr;
+}
+
+void RouteEviction::setMaxNrOfEntries(unsigned int maxNrOfEntries) {
+    this->maxNrOfEntries = maxNrOfEntries;
+}
+
+unsigned int RouteEviction::getMaxNrOfEntries() const {
+    return maxNrOfEntries;
+}
+
+void RouteEviction::setPheromoneAware(bool isActivated) {
+    this->pheromoneAware = isActivated;
+}
+
+bool RouteEviction::isPheromoneAware() const {
+    return pheromoneAware;
+}
+
+void RouteEviction::setListener(RouteEvictionListener* listener) {
+    this->listener = listener;
+}
+
+void RouteEviction::track(const AddressPtr& destination, RoutingTableEntry* entry) {
+    if (isSizeLimited() == false) {
+        return;
+    }
+
+    unsigned int position;
+    if (firstFree != NONE) {
+        position = firstFree;
+        firstFree = nodes[position].next;
+    }
+    else {
+        position = nodes.size();
+        nodes.push_back(Node());
+    }
+
+    Node& node = nodes[position];
+    node.route.destination = destination;
+    node.route.nextHop = entry->getAddress();
+    node.route.interface = entry->getNetworkInterface();
+    append(position);
+    entry->setEvictionQueuePosition(position);
+    nrOfRoutes++;
+}
+
+void RouteEviction::forget(RoutingTableEntry* entry) {
+    unsigned int position = entry->getEvictionQueuePosition();
+    if (position == RoutingTableEntry::NOT_TRACKED) {
+        return;
+    }
+
+    unlink(position);
+    Node& node = nodes[position];
+    // the addresses are released right away, the node itself is kept for the next route
+    node.route.destination.reset();
+    node.route.nextHop.reset();
+    node.next = firstFree;
+    firstFree = position;
+    entry->setEvictionQueuePosition(RoutingTableEntry::NOT_TRACKED);
+    nrOfRoutes--;
+}
+
+void RouteEviction::unlink(unsigned int position) {
+    Node& node = nodes[position];
+    if (node.previous != NONE) {
+        nodes[node.previous].next = node.next;
+    }
+    else {
+        first = node.next;
+    }
+
+    if (node.next != NONE) {
+        nodes[node.next].previous = node.previous;
+    }
+    else {
+        last = node.previous;
+    }
+}
+
+void RouteEviction::append(unsigned int position) {
+    Node& node = nodes[position];
+    node.previous = last;
+    node.next = NONE;
+    if (last != NONE) {
+        nodes[last].next = position;
+    }
+    else {
+        first = position;
+    }
+    last = position;
+}
+
+void RouteEviction::moveToEnd(unsigned int position) {
+    if (position != last) {
+        unlink(position);
+        append(position);
+    }
+}
+
+RouteEviction::Route RouteEviction::chooseRoute(const PheromoneLookup& getPheromoneValue) const {
+    unsigned int weakestRoute = first;
+    if (pheromoneAware) {
+        float lowestPheromoneValue = getPheromoneValue(nodes[first].route);
+        unsigned int candidate = nodes[first].next;
+        for (unsigned int i = 1; i < NR_OF_CANDIDATES && candidate != NONE; i++) {
+            float pheromoneValue = getPheromoneValue(nodes[candidate].route);
+            if (pheromoneValue < lowestPheromoneValue) {
+                weakestRoute = candidate;
+                lowestPheromoneValue = pheromoneValue;
+            }
+            candidate = nodes[candidate].next;
+        }
+    }
+    return nodes[weakestRoute].route;
+}
+
+void RouteEviction::routeHasBeenEvicted(const Route& route) {
+    if (listener != nullptr) {
+        evictedRoutes.push_back(route);
+    }
+}
+
+std::vector<RouteEviction::Route> RouteEviction::takeEvictedRoutes() {
+    std::vector<Route> routes;
+    routes.swap(evictedRoutes);
+    return routes;
+}
+
+void RouteEviction::notifyListener(const std::vector<Route>& routes) {
+    for (auto& route: routes) {
+        listener->routeHasBeenEvicted(route.destination, route.nextHop, route.interface);
+    }
+}
+
+void RouteEviction::notifyListener() {
+    if (evictedRoutes.empty() == false) {
+        // the listener may modify the table and thereby evict further routes
+        notifyListener(takeEvictedRoutes());
+    }
+}
+
+ARA_NAMESPACE_END
@@ -0,0 +1,78 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "RouteHandle.h"
+#include "RoutingTable.h"
+
+ARA_NAMESPACE_BEGIN
+
+RouteHandle::RouteHandle(RoutingTable* routingTable, AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) : destination(destination), nextHop(nextHop) {
+    this->routingTable = routingTable;
+    this->interface = interface;
+    this->entry = nullptr;
+    this->routes = nullptr;
+    this->generation = routingTable->getRouteGeneration();
+}
+
+void RouteHandle::refresh() const {
+    if (generation != routingTable->getRouteGeneration()) {
+        RouteHandle current = routingTable->findRoute(destination, nextHop, interface);
+        entry = current.entry;
+        routes = current.routes;
+        guard = current.guard;
+        generation = current.generation;
+    }
+}
+
+bool RouteHandle::exists() const {
+    refresh();
+    return entry != nullptr;
+}
+
+float RouteHandle::getPheromoneValue() const {
+    refresh();
+    if (entry == nullptr) {
+        return 0;
+    }
+    return entry->getPheromoneValue();
+}
+
+void RouteHandle::setPheromoneValue(float newPheromoneValue) {
+    routingTable->update(*this, newPheromoneValue);
+}
+
+AddressPtr RouteHandle::getDestination() const {
+    return destination;
+}
+
+AddressPtr RouteHandle::getNextHop() const {
+    return nextHop;
+}
+
+NetworkInterface* RouteHandle::getInterface() const {
+    return interface;
+}
+
+RoutingTableEntry* RouteHandle::getEntry() const {
+    refresh();
+    return entry;
+}
+
+void* RouteHandle::getRoutes() const {
+    refresh();
+    return routes;
+}
+
+void RouteHandle::bind(RoutingTableEntry* entry, void* routes) {
+    this->entry = entry;
+    this->routes = routes;
+    this->generation = routingTable->getRouteGeneration();
+}
+
+void RouteHandle::bind(RoutingTableEntry* entry, void* routes, const EpochGuard& guard) {
+    bind(entry, routes);
+    this->guard = guard;
+}
+
+ARA_NAMESPACE_END
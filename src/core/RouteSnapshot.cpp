@@ -0,0 +1,216 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "RouteSnapshot.h"
+#include "RoutingTable.h"
+#include "Exception.h"
+
+#include <chrono>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+#include <vector>
+#include <fcntl.h>
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+ARA_NAMESPACE_BEGIN
+
+namespace {
+    const char SNAPSHOT_MAGIC[4] = {'A', 'R', 'A', 'T'};
+    const uint32_t SNAPSHOT_VERSION = 1;
+
+    struct SnapshotHeader {
+        char magic[4];
+        uint32_t version;
+        uint32_t nrOfRoutes;
+        uint32_t nrOfAddresses;
+        /// the wall clock time at which the snapshot has been taken in milliseconds since the epoch
+        uint64_t creationTime;
+    };
+
+    /**
+     * The addresses are stored as indices into the address list at the end of the snapshot.
+     * The interface is referenced by its local address.
+     */
+    struct SnapshotRoute {
+        uint32_t destination;
+        uint32_t nextHop;
+        uint32_t interface;
+        float pheromoneValue;
+        /// the number of milliseconds since the pheromone value has been evaporated the last time
+        uint32_t age;
+    };
+
+    static_assert(sizeof(SnapshotHeader) == 24, "The snapshot header must not contain padding");
+    static_assert(sizeof(SnapshotRoute) == 20, "The snapshot routes must not contain padding");
+
+    uint64_t getWallClockTime() {
+        auto timeSinceEpoch = std::chrono::system_clock::now().time_since_epoch();
+        return std::chrono::duration_cast<std::chrono::milliseconds>(timeSinceEpoch).count();
+    }
+}
+
+void RouteSnapshot::write(const RoutingTable& table, long currentTimestamp, const std::string& path) {
+    std::vector<SnapshotRoute> routes;
+    std::vector<std::string> addresses;
+    std::unordered_map<std::string, uint32_t> addressIndices;
+    auto getAddressIndex = [&addresses, &addressIndices](const AddressPtr& address) {
+        std::string textualAddress = address->toString();
+        auto foundAddress = addressIndices.find(textualAddress);
+        if (foundAddress != addressIndices.end()) {
+            return foundAddress->second;
+        }
+        uint32_t index = addresses.size();
+        addresses.push_back(textualAddress);
+        addressIndices[textualAddress] = index;
+        return index;
+    };
+
+    table.forEachEntry([&](const AddressPtr& destination, RoutingTableEntry* entry) {
+        SnapshotRoute route;
+        route.destination = getAddressIndex(destination);
+        route.nextHop = getAddressIndex(entry->getAddress());
+        route.interface = getAddressIndex(entry->getNetworkInterface()->getLocalAddress());
+        route.pheromoneValue = entry->getPheromoneValue();
+        long age = currentTimestamp - entry->getTimestamp();
+        route.age = age > 0 ? age : 0;
+        routes.push_back(route);
+    });
+
+    SnapshotHeader header;
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.nrOfRoutes = routes.size();
+    header.nrOfAddresses = addresses.size();
+    header.creationTime = getWallClockTime();
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write((const char*) &header, sizeof(header));
+    if (routes.empty() == false) {
+        file.write((const char*) routes.data(), routes.size() * sizeof(SnapshotRoute));
+    }
+    for (auto& address: addresses) {
+        uint16_t length = address.size() < UINT16_MAX ? address.size() : UINT16_MAX;
+        file.write((const char*) &length, sizeof(length));
+        file.write(address.data(), length);
+    }
+
+    file.close();
+    if (file.fail()) {
+        throw Exception("RouteSnapshot::write: Could not write the snapshot file");
+    }
+}
+
+unsigned int RouteSnapshot::restore(RoutingTable& table, const std::string& path, RouteSnapshotResolver* resolver) {
+    int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw Exception("RouteSnapshot::restore: Could not open the snapshot file");
+    }
+
+    struct stat fileStatus;
+    if (fstat(file, &fileStatus) != 0 || fileStatus.st_size < (off_t) sizeof(SnapshotHeader)) {
+        close(file);
+        throw Exception("RouteSnapshot::restore: The file is not a valid routing table snapshot");
+    }
+
+    size_t snapshotSize = fileStatus.st_size;
+    void* snapshot = mmap(nullptr, snapshotSize, PROT_READ, MAP_PRIVATE, file, 0);
+    // the mapping stays valid after the file has been closed
+    close(file);
+    if (snapshot == MAP_FAILED) {
+        throw Exception("RouteSnapshot::restore: Could not map the snapshot file");
+    }
+
+    unsigned int nrOfRestoredRoutes;
+    try {
+        nrOfRestoredRoutes = restoreRoutes(table, (const char*) snapshot, snapshotSize, resolver);
+    } catch (...) {
+        munmap(snapshot, snapshotSize);
+        throw;
+    }
+    munmap(snapshot, snapshotSize);
+    return nrOfRestoredRoutes;
+}
+
+unsigned int RouteSnapshot::restoreRoutes(RoutingTable& table, const char* snapshot, size_t snapshotSize, RouteSnapshotResolver* resolver) {
+    EvaporationPolicy* evaporationPolicy = table.getEvaporationPolicy();
+    const SnapshotHeader* header = (const SnapshotHeader*) snapshot;
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0 || header->version != SNAPSHOT_VERSION) {
+        throw Exception("RouteSnapshot::restore: The file is not a valid routing table snapshot");
+    }
+
+    size_t position = sizeof(SnapshotHeader);
+    if (header->nrOfRoutes > (snapshotSize - position) / sizeof(SnapshotRoute)) {
+        throw Exception("RouteSnapshot::restore: The routing table snapshot is truncated");
+    }
+    // the header has a size of 24 bytes, so the routes are properly aligned and can be read in place
+    const SnapshotRoute* routes = (const SnapshotRoute*) (snapshot + position);
+    position += header->nrOfRoutes * sizeof(SnapshotRoute);
+
+    std::vector<AddressPtr> addresses;
+    addresses.reserve(header->nrOfAddresses);
+    for (uint32_t i = 0; i < header->nrOfAddresses; i++) {
+        uint16_t length;
+        if (snapshotSize - position < sizeof(length)) {
+            throw Exception("RouteSnapshot::restore: The routing table snapshot is truncated");
+        }
+        std::memcpy(&length, snapshot + position, sizeof(length));
+        position += sizeof(length);
+
+        if (snapshotSize - position < length) {
+            throw Exception("RouteSnapshot::restore: The routing table snapshot is truncated");
+        }
+        addresses.push_back(resolver->resolveAddress(std::string(snapshot + position, length)));
+        position += length;
+    }
+
+    // the routes are evaporated by the time the node has been down in addition to their age
+    uint64_t currentTime = getWallClockTime();
+    uint64_t downTime = currentTime > header->creationTime ? currentTime - header->creationTime : 0;
+
+    std::unordered_map<uint32_t, NetworkInterface*> interfaces;
+    unsigned int nrOfRestoredRoutes = 0;
+    for (uint32_t i = 0; i < header->nrOfRoutes; i++) {
+        const SnapshotRoute& route = routes[i];
+        if (route.destination >= addresses.size() || route.nextHop >= addresses.size() || route.interface >= addresses.size()) {
+            throw Exception("RouteSnapshot::restore: The routing table snapshot refers to an unknown address");
+        }
+
+        auto foundInterface = interfaces.find(route.interface);
+        if (foundInterface == interfaces.end()) {
+            NetworkInterface* interface = nullptr;
+            if (addresses[route.interface] != nullptr) {
+                interface = resolver->resolveInterface(addresses[route.interface]);
+            }
+            foundInterface = interfaces.insert(std::make_pair(route.interface, interface)).first;
+        }
+
+        AddressPtr destination = addresses[route.destination];
+        AddressPtr nextHop = addresses[route.nextHop];
+        NetworkInterface* interface = foundInterface->second;
+        if (destination == nullptr || nextHop == nullptr || interface == nullptr) {
+            continue;
+        }
+
+        float pheromoneValue = route.pheromoneValue;
+        uint64_t age = route.age + downTime;
+        int evaporationTime = age < INT_MAX ? age : INT_MAX;
+        if (evaporationPolicy != nullptr && evaporationTime > 0 && evaporationPolicy->isEvaporationNecessary(evaporationTime)) {
+            pheromoneValue = evaporationPolicy->evaporate(pheromoneValue, evaporationTime);
+        }
+
+        if (pheromoneValue > 0) {
+            table.update(destination, nextHop, interface, pheromoneValue);
+            nrOfRestoredRoutes++;
+        }
+    }
+
+    return nrOfRestoredRoutes;
+}
+
+ARA_NAMESPACE_END
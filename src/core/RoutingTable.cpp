@@ -5,28 +5,40 @@
 #include "RoutingTable.h"
 #include "Environment.h"
 #include "Exception.h"
+#include "RouteSnapshot.h"
 
 ARA_NAMESPACE_BEGIN
 
-RoutingTable::RoutingTable() {
+const unsigned int RoutingTable::NR_OF_BUCKETS_PER_LAZY_EVAPORATION;
+
+RoutingTable::RoutingTable() : RoutingTable(true) {}
+
+RoutingTable::RoutingTable(bool usesStandardLayout) : routeGeneration(0) {
+    table = usesStandardLayout ? new RoutingTableMap() : nullptr;
     lastAccessTime = nullptr;
     evaporationPolicy = nullptr;
+    currentTimestamp = 0;
+    evaporationCursor = 0;
+    lazyEvaporation = false;
+    maxNrOfBucketsPerEvaporation = 0;
 }
 
 RoutingTable::~RoutingTable() {
-    RoutingTableMap::iterator iterator;
-    for (iterator=table.begin(); iterator!=table.end(); iterator++) {
-        RoutingTableEntryList* entryList = iterator->second;
-
-        // delete all RoutingTableEntries in the List
-        while (entryList->empty() == false) {
-            RoutingTableEntry* entry = entryList->back();
-            entryList->pop_back();
-            delete entry;
+    if (table != nullptr) {
+        RoutingTableMap::iterator iterator;
+        for (iterator=table->begin(); iterator!=table->end(); iterator++) {
+            DestinationRoutes* routes = iterator->second;
+
+            // delete all RoutingTableEntries in the List
+            while (routes->entries.empty() == false) {
+                RoutingTableEntry* entry = routes->entries.back();
+                routes->entries.pop_back();
+                delete entry;
+            }
+            delete routes;
         }
-        delete entryList;
+        delete table;
     }
-    table.clear();
 
     if(hasTableBeenAccessedEarlier()) {
         delete lastAccessTime;
@@ -40,93 +52,174 @@ void RoutingTable::update(AddressPtr destination, AddressPtr nextHop, NetworkInt
 
 
 void RoutingTable::update(AddressPtr destination, RoutingTableEntry* newEntry) {
-    if (table.find(destination) == table.end()) {
+    if (table == nullptr) {
+        // the table is responsible for the entry even if it can not store it
+        delete newEntry;
+    }
+    requireStandardLayout("RoutingTable::update: This table layout does not implement this method");
+    newEntry->setTimestamp(currentTimestamp);
+    if (eviction.isSizeLimited() && isNewRoute(destination, newEntry->getAddress(), newEntry->getNetworkInterface())) {
+        makeRoomForNewEntry();
+    }
+
+    RoutingTableMap::iterator foundDestination = table->find(destination);
+    if (foundDestination == table->end()) {
         // this is a new entry
-        RoutingTableEntryList* entryList = new RoutingTableEntryList();
-        entryList->push_back(newEntry);
-        table[destination] = entryList;
+        DestinationRoutes* routes = new DestinationRoutes();
+        routes->entries.push_back(newEntry);
+        addToAggregates(routes, newEntry);
+        (*table)[destination] = routes;
+        addToNextHopIndex(destination, newEntry->getAddress());
+        eviction.track(destination, newEntry);
     }
     else {
         // there is at least one registered route for this destination
-        RoutingTableEntryList* entryList = table[destination];
+        DestinationRoutes* routes = foundDestination->second;
         bool entryHasBeenUpdated = false;
-        for (auto& entry: *entryList) {
+        for (auto& entry: routes->entries) {
             if (entry->getAddress()->equals(newEntry->getAddress()) && entry->getNetworkInterface()->equals(newEntry->getNetworkInterface())) {
+                float oldPheromoneValue = entry->getPheromoneValue();
                 updateExistingEntry(entry, newEntry);
+                entry->setTimestamp(currentTimestamp);
+                eviction.touch(entry);
+                updateAggregates(routes, entry, oldPheromoneValue);
                 entryHasBeenUpdated = true;
             }
         }
 
         if (entryHasBeenUpdated == false) {
-            entryList->push_back(newEntry);
+            routes->entries.push_back(newEntry);
+            addToAggregates(routes, newEntry);
+            addToNextHopIndex(destination, newEntry->getAddress());
+            eviction.track(destination, newEntry);
         }
         else{
             delete newEntry;
         }
     }
+    notifyEvictionListener();
+}
+
+RouteHandle RoutingTable::findRoute(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    RouteHandle route = RouteHandle(this, destination, nextHop, interface);
+    DestinationRoutes* routes = findRoutes(destination);
+    if (routes != nullptr) {
+        RoutingTableEntry* foundEntry = nullptr;
+        for (auto& entry: routes->entries) {
+            if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)) {
+                foundEntry = entry;
+                break;
+            }
+        }
+        route.bind(foundEntry, routes);
+    }
+    return route;
+}
+
+void RoutingTable::update(RouteHandle& route, float pheromoneValue) {
+    requireStandardLayout("RoutingTable::update: This table layout does not implement this method");
+    RoutingTableEntry* entry = route.getEntry();
+    DestinationRoutes* routes = (DestinationRoutes*) route.getRoutes();
+    if (entry != nullptr) {
+        float oldPheromoneValue = entry->getPheromoneValue();
+        entry->setPheromoneValue(pheromoneValue);
+        entry->setTimestamp(currentTimestamp);
+        eviction.touch(entry);
+        updateAggregates(routes, entry, oldPheromoneValue);
+        return;
+    }
+
+    if (eviction.isSizeLimited()) {
+        // the eviction may delete the routes the handle refers to
+        makeRoomForNewEntry();
+        routes = findRoutes(route.getDestination());
+    }
+
+    if (routes == nullptr) {
+        // this is a new destination
+        routes = new DestinationRoutes();
+        (*table)[route.getDestination()] = routes;
+    }
+
+    entry = new RoutingTableEntry(route.getNextHop(), route.getInterface(), pheromoneValue);
+    entry->setTimestamp(currentTimestamp);
+    routes->entries.push_back(entry);
+    addToAggregates(routes, entry);
+    addToNextHopIndex(route.getDestination(), route.getNextHop());
+    eviction.track(route.getDestination(), entry);
+    route.bind(entry, routes);
+    notifyEvictionListener();
 }
 
 void RoutingTable::updateExistingEntry(RoutingTableEntry* oldEntry, RoutingTableEntry* newEntry){
     oldEntry->setPheromoneValue(newEntry->getPheromoneValue());
 }
 
-void RoutingTable::removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
-    if (table.find(destination) != table.end()) {
-        RoutingTableEntryList* entryList = table[destination];
-        RoutingTableEntryList::iterator iterator = entryList->begin();
+bool RoutingTable::removeEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+    requireStandardLayout("RoutingTable::removeEntry: This table layout does not implement this method");
+    bool entryHasBeenRemoved = false;
+    RoutingTableMap::iterator foundDestination = table->find(destination);
+    if (foundDestination != table->end()) {
+        DestinationRoutes* routes = foundDestination->second;
+        RoutingTableEntryList::iterator iterator = routes->entries.begin();
 
-        if (iterator != entryList->end()) {
-            while (iterator != entryList->end()) {
+        if (iterator != routes->entries.end()) {
+            while (iterator != routes->entries.end()) {
                 RoutingTableEntry* entry = *iterator;
                 if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)) {
-                    entryList->erase(iterator);
+                    routes->entries.erase(iterator);
+                    removeFromAggregates(routes, entry);
+                    removeFromNextHopIndex(destination, nextHop);
+                    eviction.forget(entry);
                     delete entry;
+                    entryHasBeenRemoved = true;
                     break;
                 }
                 iterator++;
             }
 
-            if (entryList->empty()) {
+            if (routes->entries.empty()) {
                 // this was the last entry so we can delete the whole list
-                table.erase(destination);
-                delete entryList;
+                table->erase(destination);
+                delete routes;
             }
         }
     }
+
+    return entryHasBeenRemoved;
 }
 
 RoutingTableEntryList RoutingTable::getPossibleNextHops(const Packet* packet) {
-    if (isDeliverable(packet->getDestination())) {
-        AddressPtr source = packet->getSource();
-        AddressPtr sender = packet->getSender();
-
-        RoutingTableEntryList* availableHops = table[packet->getDestination()];
-        RoutingTableEntryList returnedList = RoutingTableEntryList(*availableHops);
-
-        // remove all entries that would route the packet back over the source or sender of the packet (would create a loop)
-        RoutingTableEntryList::iterator iterator = returnedList.begin();
-        while (iterator != returnedList.end()) {
-            RoutingTableEntry* entry = *iterator;
-            AddressPtr possibleNextHop = entry->getAddress();
-            if (possibleNextHop->equals(source) || possibleNextHop->equals(sender) ) {
-                iterator = returnedList.erase(iterator);
-            }
-            else {
-                iterator++;
-            }
-        }
+    RoutingTableEntryList possibleNextHops = RoutingTableEntryList();
+    for (auto entry: getNextHopCandidates(packet)) {
+        possibleNextHops.push_back(entry);
+    }
+    return possibleNextHops;
+}
 
-        return returnedList;
+NextHopCandidates RoutingTable::getNextHopCandidates(const Packet* packet) {
+    DestinationRoutes* routes = findRoutes(packet->getDestination());
+    if (routes != nullptr) {
+        return NextHopCandidates(&routes->entries, packet, &routes->aggregates, this);
     }
     else {
-        // return empty list
-        return RoutingTableEntryList();
+        return NextHopCandidates();
     }
 }
 
+bool RoutingTable::hasRouteOver(const AddressPtr& destination, const AddressPtr& nextHop) const {
+    NextHopIndex::const_iterator foundNextHop = nextHopIndex.find(nextHop);
+    return foundNextHop != nextHopIndex.end() && foundNextHop->second.find(destination) != foundNextHop->second.end();
+}
+
+float RoutingTable::getSelectionWeight(RoutingTableEntry* entry) const {
+    return entry->getPheromoneValue();
+}
+
 RoutingTableEntryList RoutingTable::getPossibleNextHops(AddressPtr destination) {
-    if (isDeliverable(destination)) {
-        return *(table[destination]);
+    RoutingTableEntryList* entryList = findEntries(destination);
+    if (entryList != nullptr) {
+        return *entryList;
     }
     else {
         // return empty list
@@ -135,17 +228,16 @@ RoutingTableEntryList RoutingTable::getPossibleNextHops(AddressPtr destination)
 }
 
 bool RoutingTable::isDeliverable(AddressPtr destination) {
-    return table.find(destination) != table.end();
+    return findEntries(destination) != nullptr;
 }
 
 bool RoutingTable::isDeliverable(const Packet* packet) {
-    RoutingTableEntryList possibleNextHops = getPossibleNextHops(packet);
-    return possibleNextHops.empty() == false;
+    return getNextHopCandidates(packet).empty() == false;
 }
 
 float RoutingTable::getPheromoneValue(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
-    if (isDeliverable(destination)) {
-        RoutingTableEntryList* entryList = table[destination];
+    RoutingTableEntryList* entryList = findEntries(destination);
+    if (entryList != nullptr) {
         for (auto& entry: *entryList) {
             if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)) {
                 return entry->getPheromoneValue();
@@ -157,8 +249,8 @@ float RoutingTable::getPheromoneValue(AddressPtr destination, AddressPtr nextHop
 }
 
 bool RoutingTable::exists(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface){
-    if (isDeliverable(destination)) {
-        RoutingTableEntryList* entries = table[destination];
+    RoutingTableEntryList* entries = findEntries(destination);
+    if (entries != nullptr) {
         for (auto& entry: *entries) {
             if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)){
                 return true;
@@ -180,6 +272,18 @@ void RoutingTable::triggerEvaporation() {
     if (hasTableBeenAccessedEarlier() == false) {
         lastAccessTime = currentTime;
     }
+    else if (isLazyEvaporationUsed() || maxNrOfBucketsPerEvaporation > 0) {
+        // the lastAccessTime is never reset in these modes so it is the time base of all timestamps
+        currentTimestamp = currentTime->getDifferenceInMilliSeconds(lastAccessTime);
+        delete currentTime;
+
+        if (maxNrOfBucketsPerEvaporation > 0) {
+            evaporateBuckets(maxNrOfBucketsPerEvaporation);
+        }
+        else {
+            evaporateBuckets(NR_OF_BUCKETS_PER_LAZY_EVAPORATION);
+        }
+    }
     else {
         applyEvaporation(currentTime);
     }
@@ -191,36 +295,239 @@ void RoutingTable::applyEvaporation(Time* currentTime) {
 
     if (evaporationPolicy->isEvaporationNecessary(timeDifference)) {
         lastAccessTime->setToCurrentTime();
+        evaporateEntries(timeDifference);
+    }
+}
 
-        RoutingTableMap::iterator i = table.begin();
-        while (i!=table.end()) {
-            std::pair<AddressPtr const, RoutingTableEntryList*> entryPair = *i;
-            AddressPtr destination = entryPair.first;
-            RoutingTableEntryList* nextHopsForDestination = entryPair.second;
-
-            // apply evaporation to all next hops for that destination
-            RoutingTableEntryList::iterator j = nextHopsForDestination->begin();
-            while (j != nextHopsForDestination->end()) {
-                RoutingTableEntry* entry = *j;
-                float newPheromoneValue = evaporationPolicy->evaporate(entry->getPheromoneValue(), timeDifference);
-                if (newPheromoneValue > 0) {
-                    entry->setPheromoneValue(newPheromoneValue);
-                    j++;
-                }
-                else {
-                    delete entry;
-                    j = nextHopsForDestination->erase(j); // this does not invalidate the iterator, because j is set to the valid return value of erase (will point to end() if empty)
-                }
-            }
-
-            if (nextHopsForDestination->empty()) {
-                delete nextHopsForDestination;
-                i = table.erase(i); // this does not invalidate the iterator, because i is set to the valid return value of erase (will point to end() if empty)
+void RoutingTable::evaporateEntries(long timeDifference) {
+    requireStandardLayout("RoutingTable::evaporateEntries: This table layout does not implement this method");
+    pheromoneValues.clear();
+    for (auto& destinationRoutes: *table) {
+        for (auto& entry: destinationRoutes.second->entries) {
+            pheromoneValues.push_back(entry->getPheromoneValue());
+        }
+    }
+    evaporationPolicy->evaporate(pheromoneValues.data(), pheromoneValues.size(), timeDifference);
+
+    // erasing from the map does not change the order of the remaining destinations, so the values are consumed in order
+    size_t nextPheromoneValue = 0;
+    RoutingTableMap::iterator i = table->begin();
+    while (i!=table->end()) {
+        AddressPtr destination = i->first;
+        DestinationRoutes* routes = i->second;
+        RoutingTableEntryList* nextHopsForDestination = &routes->entries;
+
+        // apply evaporation to all next hops for that destination
+        RoutingTableEntryList::iterator j = nextHopsForDestination->begin();
+        while (j != nextHopsForDestination->end()) {
+            RoutingTableEntry* entry = *j;
+            float newPheromoneValue = pheromoneValues[nextPheromoneValue++];
+            if (newPheromoneValue > 0) {
+                entry->setPheromoneValue(newPheromoneValue);
+                j++;
             }
             else {
-                i++;
+                removeFromNextHopIndex(destination, entry->getAddress());
+                eviction.forget(entry);
+                delete entry;
+                j = nextHopsForDestination->erase(j); // this does not invalidate the iterator, because j is set to the valid return value of erase (will point to end() if empty)
+            }
+        }
+
+        if (nextHopsForDestination->empty()) {
+            delete routes;
+            i = table->erase(i); // this does not invalidate the iterator, because i is set to the valid return value of erase (will point to end() if empty)
+        }
+        else {
+            recomputeAggregates(routes);
+            i++;
+        }
+    }
+}
+
+RoutingTableEntryList* RoutingTable::findEntries(const AddressPtr& destination) {
+    DestinationRoutes* routes = findRoutes(destination);
+    if (routes == nullptr) {
+        return nullptr;
+    }
+    return &routes->entries;
+}
+
+DestinationRoutes* RoutingTable::findRoutes(const AddressPtr& destination) {
+    requireStandardLayout("RoutingTable::findRoutes: This table layout does not implement this method");
+    RoutingTableMap::iterator foundDestination = table->find(destination);
+    if (foundDestination == table->end()) {
+        return nullptr;
+    }
+
+    DestinationRoutes* routes = foundDestination->second;
+    if (isLazyEvaporationUsed() && evaporateRoutes(destination, routes)) {
+        // all routes have evaporated in the meantime
+        table->erase(foundDestination);
+        delete routes;
+        return nullptr;
+    }
+
+    return routes;
+}
+
+bool RoutingTable::evaporateEntry(RoutingTableEntry* entry) {
+    long timeDifference = currentTimestamp - entry->getTimestamp();
+    if (evaporationPolicy->isEvaporationNecessary(timeDifference)) {
+        float newPheromoneValue = evaporationPolicy->evaporate(entry->getPheromoneValue(), timeDifference);
+        if (newPheromoneValue <= 0) {
+            return false;
+        }
+        entry->setPheromoneValue(newPheromoneValue);
+        entry->setTimestamp(currentTimestamp);
+    }
+    return true;
+}
+
+bool RoutingTable::evaporateRoutes(AddressPtr destination, DestinationRoutes* routes) {
+    RoutingTableEntryList* entries = &routes->entries;
+    bool someEntryHasChanged = false;
+    RoutingTableEntryList::iterator iterator = entries->begin();
+    while (iterator != entries->end()) {
+        RoutingTableEntry* entry = *iterator;
+        // the timestamp is only moved forward if the entry has actually been evaporated
+        long timestamp = entry->getTimestamp();
+        if (evaporateEntry(entry)) {
+            someEntryHasChanged |= entry->getTimestamp() != timestamp;
+            iterator++;
+        }
+        else {
+            removeFromNextHopIndex(destination, entry->getAddress());
+            eviction.forget(entry);
+            delete entry;
+            iterator = entries->erase(iterator);
+            someEntryHasChanged = true;
+        }
+    }
+
+    if (someEntryHasChanged) {
+        recomputeAggregates(routes);
+    }
+    return entries->empty();
+}
+
+void RoutingTable::addToAggregates(DestinationRoutes* routes, RoutingTableEntry* entry) {
+    addToAggregates(routes->aggregates, entry);
+}
+
+void RoutingTable::addToAggregates(PheromoneAggregates& aggregates, RoutingTableEntry* entry) {
+    aggregates.cumulativeSelectionWeights.clear();
+    aggregates.sumOfPheromoneValues += entry->getPheromoneValue();
+    // new entries are always appended, so they only become the best entry if they are strictly better
+    if (aggregates.bestEntry == nullptr || entry->getPheromoneValue() > aggregates.bestEntry->getPheromoneValue()) {
+        aggregates.bestEntry = entry;
+    }
+}
+
+void RoutingTable::updateAggregates(DestinationRoutes* routes, RoutingTableEntry* entry, float oldPheromoneValue) {
+    if (updateAggregates(routes->aggregates, entry, oldPheromoneValue) == false) {
+        recomputeAggregates(routes);
+    }
+}
+
+bool RoutingTable::updateAggregates(PheromoneAggregates& aggregates, RoutingTableEntry* entry, float oldPheromoneValue) {
+    aggregates.cumulativeSelectionWeights.clear();
+    float newPheromoneValue = entry->getPheromoneValue();
+    aggregates.sumOfPheromoneValues += newPheromoneValue - oldPheromoneValue;
+
+    if (entry == aggregates.bestEntry) {
+        // another entry may be better now
+        return newPheromoneValue >= oldPheromoneValue;
+    }
+    else if (newPheromoneValue > aggregates.bestEntry->getPheromoneValue()) {
+        aggregates.bestEntry = entry;
+    }
+    else if (newPheromoneValue == aggregates.bestEntry->getPheromoneValue()) {
+        // the first of both entries is the best one
+        return false;
+    }
+    return true;
+}
+
+void RoutingTable::resetAggregates(PheromoneAggregates& aggregates) {
+    aggregates.cumulativeSelectionWeights.clear();
+    aggregates.sumOfPheromoneValues = 0;
+    aggregates.bestEntry = nullptr;
+}
+
+void RoutingTable::removeFromAggregates(DestinationRoutes* routes, RoutingTableEntry* entry) {
+    routes->aggregates.cumulativeSelectionWeights.clear();
+    if (entry == routes->aggregates.bestEntry) {
+        recomputeAggregates(routes);
+    }
+    else {
+        routes->aggregates.sumOfPheromoneValues -= entry->getPheromoneValue();
+    }
+}
+
+void RoutingTable::recomputeAggregates(DestinationRoutes* routes) {
+    // this also gets rid of the rounding errors that accumulate in the incrementally updated sum
+    resetAggregates(routes->aggregates);
+    for (auto& entry: routes->entries) {
+        addToAggregates(routes->aggregates, entry);
+    }
+}
+
+void RoutingTable::invalidateSelectionWeights(DestinationRoutes* routes) {
+    if (routes != nullptr) {
+        routes->aggregates.cumulativeSelectionWeights.clear();
+        return;
+    }
+
+    for (auto& destinationRoutes: *table) {
+        destinationRoutes.second->aggregates.cumulativeSelectionWeights.clear();
+    }
+}
+
+void RoutingTable::evaporateBuckets(unsigned int nrOfBuckets) {
+    requireStandardLayout("RoutingTable::evaporateBuckets: This table layout does not implement this method");
+    for (unsigned int i = 0; i < nrOfBuckets && table->empty() == false; i++) {
+        // the number of buckets may have changed since the last call if the table has been rehashed
+        if (evaporationCursor >= table->bucket_count()) {
+            evaporationCursor = 0;
+        }
+
+        RoutingTableMap::local_iterator iterator = table->begin(evaporationCursor);
+        while (iterator != table->end(evaporationCursor)) {
+            AddressPtr destination = iterator->first;
+            DestinationRoutes* routes = iterator->second;
+
+            // we need to advance the iterator before the destination is erased (erase never rehashes the table)
+            iterator++;
+            if (evaporateRoutes(destination, routes)) {
+                table->erase(destination);
+                delete routes;
             }
         }
+
+        evaporationCursor++;
+    }
+}
+
+void RoutingTable::snapshot(const std::string& path) const {
+    // the entries are evaporated up to their timestamp which counts the milliseconds since the lastAccessTime
+    long timeSinceLastAccess = 0;
+    if (lastAccessTime != nullptr) {
+        Time* currentTime = Environment::getClock()->makeTime();
+        currentTime->setToCurrentTime();
+        timeSinceLastAccess = currentTime->getDifferenceInMilliSeconds(lastAccessTime);
+        delete currentTime;
+    }
+    RouteSnapshot::write(*this, timeSinceLastAccess, path);
+}
+
+unsigned int RoutingTable::restore(const std::string& path, RouteSnapshotResolver* resolver) {
+    return RouteSnapshot::restore(*this, path, resolver);
+}
+
+void RoutingTable::requireStandardLayout(const char* message) const {
+    if (table == nullptr) {
+        throw Exception(message);
     }
 }
 
@@ -236,23 +543,97 @@ EvaporationPolicy* RoutingTable::getEvaporationPolicy() const{
     return this->evaporationPolicy;
 }
 
+void RoutingTable::setLazyEvaporation(bool isActivated) {
+    this->lazyEvaporation = isActivated;
+}
+
+bool RoutingTable::isLazyEvaporationActivated() const {
+    return lazyEvaporation;
+}
+
+void RoutingTable::setMaxNrOfBucketsPerEvaporation(unsigned int maxNrOfBuckets) {
+    this->maxNrOfBucketsPerEvaporation = maxNrOfBuckets;
+}
+
+unsigned int RoutingTable::getMaxNrOfBucketsPerEvaporation() const {
+    return maxNrOfBucketsPerEvaporation;
+}
+
+void RoutingTable::setMaxNrOfEntries(unsigned int maxNrOfEntries) {
+    eviction.setMaxNrOfEntries(maxNrOfEntries);
+}
+
+unsigned int RoutingTable::getMaxNrOfEntries() const {
+    return eviction.getMaxNrOfEntries();
+}
+
+void RoutingTable::setPheromoneAwareEviction(bool isActivated) {
+    eviction.setPheromoneAware(isActivated);
+}
+
+bool RoutingTable::isPheromoneAwareEvictionActivated() const {
+    return eviction.isPheromoneAware();
+}
+
+void RoutingTable::setEvictionListener(RouteEvictionListener* listener) {
+    eviction.setListener(listener);
+}
+
+void RoutingTable::makeRoomForNewEntry() {
+    RouteEviction::PheromoneLookup getPheromoneValue = [this](const RouteEviction::Route& route) {
+        return findStoredEntry(route.destination, route.nextHop, route.interface)->getPheromoneValue();
+    };
+
+    while (eviction.isFull()) {
+        RouteEviction::Route route = eviction.chooseRoute(getPheromoneValue);
+        removeEvictedRoute(route);
+        eviction.routeHasBeenEvicted(route);
+    }
+}
+
+RoutingTableEntry* RoutingTable::findStoredEntry(const AddressPtr& destination, const AddressPtr& nextHop, NetworkInterface* interface) {
+    requireStandardLayout("RoutingTable::findStoredEntry: This table layout does not implement this method");
+    RoutingTableMap::iterator foundDestination = table->find(destination);
+    if (foundDestination != table->end()) {
+        for (auto& entry: foundDestination->second->entries) {
+            if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)) {
+                return entry;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void RoutingTable::removeEvictedRoute(const RouteEviction::Route& route) {
+    // subclasses must not interfere here, so we explicitly call our own implementation
+    RoutingTable::removeEntry(route.destination, route.nextHop, route.interface);
+}
+
+bool RoutingTable::isLazyEvaporationUsed() const {
+    return lazyEvaporation && evaporationPolicy != nullptr && evaporationPolicy->isLazyEvaluationSupported();
+}
+
 unsigned int RoutingTable::getTotalNumberOfEntries() const {
+    requireStandardLayout("RoutingTable::getTotalNumberOfEntries: This table layout does not implement this method");
     unsigned int tableSize = 0;
     RoutingTableMap::const_iterator iterator;
-    for (iterator=table.begin(); iterator!=table.end(); iterator++) {
-        RoutingTableEntryList* entryList = iterator->second;
-        tableSize += entryList->size();
+    for (iterator=table->begin(); iterator!=table->end(); iterator++) {
+        tableSize += iterator->second->entries.size();
     }
     return tableSize;
 }
 
 RoutingTableEntryTupel RoutingTable::getEntryAt(int wantedPosition) const {
+    return findEntryAt(wantedPosition);
+}
+
+RoutingTableEntryTupel RoutingTable::findEntryAt(int wantedPosition) const {
+    requireStandardLayout("RoutingTable::findEntryAt: This table layout does not implement this method");
     int currentPosition = 0;
     RoutingTableMap::const_iterator iterator;
-    for (iterator=table.begin(); iterator!=table.end(); iterator++) {
+    for (iterator=table->begin(); iterator!=table->end(); iterator++) {
         AddressPtr destination = iterator->first;
-        RoutingTableEntryList* entryList = iterator->second;
-        for (auto& entry: *entryList) {
+        for (auto& entry: iterator->second->entries) {
             if(currentPosition == wantedPosition) {
                 RoutingTableEntryTupel tupel;
                 tupel.destination = destination;
@@ -268,19 +649,90 @@ RoutingTableEntryTupel RoutingTable::getEntryAt(int wantedPosition) const {
     throw Exception("RoutingTable::getEntryAt: Index out of bounds");
 }
 
+void RoutingTable::forEachEntry(const RoutingTableVisitor& visitor) const {
+    requireStandardLayout("RoutingTable::forEachEntry: This table layout does not implement this method");
+    for (auto& destinationEntries: *table) {
+        for (auto& entry: destinationEntries.second->entries) {
+            visitor(destinationEntries.first, entry);
+        }
+    }
+}
+
+RoutingTable::const_iterator RoutingTable::begin() const {
+    return const_iterator(this, false);
+}
+
+RoutingTable::const_iterator RoutingTable::end() const {
+    return const_iterator(this, true);
+}
+
+bool RoutingTable::moveToFirstEntry(IteratorPosition& position) const {
+    requireStandardLayout("RoutingTable::moveToFirstEntry: This table layout does not implement this method");
+    position.destination = table->begin();
+    position.route = 0;
+    return position.destination != table->end();
+}
+
+bool RoutingTable::moveToNextEntry(IteratorPosition& position) const {
+    position.route++;
+    if (position.route >= position.destination->second->entries.size()) {
+        // the lists in the table are never empty so we can just go to the next destination
+        position.destination++;
+        position.route = 0;
+    }
+    return position.destination != table->end();
+}
+
+RoutingTableEntryTupel RoutingTable::getEntryAtPosition(const IteratorPosition& position) const {
+    RoutingTableEntryTupel tupel;
+    tupel.destination = position.destination->first;
+    tupel.entry = position.destination->second->entries.at(position.route);
+    return tupel;
+}
+
+RoutingTable::const_iterator::const_iterator(const RoutingTable* table, bool isAtEnd) {
+    this->table = table;
+    position.destination = RoutingTableMap::const_iterator();
+    position.slot = 0;
+    position.route = 0;
+    this->isAtEnd = isAtEnd || table->moveToFirstEntry(position) == false;
+}
+
+RoutingTableEntryTupel RoutingTable::const_iterator::operator*() const {
+    return table->getEntryAtPosition(position);
+}
+
+RoutingTable::const_iterator& RoutingTable::const_iterator::operator++() {
+    isAtEnd = table->moveToNextEntry(position) == false;
+    return *this;
+}
+
+bool RoutingTable::const_iterator::operator==(const const_iterator& other) const {
+    if (isAtEnd || other.isAtEnd) {
+        return isAtEnd == other.isAtEnd;
+    }
+    return position.destination == other.position.destination && position.slot == other.position.slot && position.route == other.position.route;
+}
+
+bool RoutingTable::const_iterator::operator!=(const const_iterator& other) const {
+    return (*this == other) == false;
+}
+
 std::deque<RoutingTableEntryTupel> RoutingTable::getAllRoutesThatLeadOver(AddressPtr nextHop) const {
+    requireStandardLayout("RoutingTable::getAllRoutesThatLeadOver: This table layout does not implement this method");
     std::deque<RoutingTableEntryTupel> result = std::deque<RoutingTableEntryTupel>();
 
-    // TODO this could be made faster with an additional hashmap (but would require more memory)
-    for (RoutingTableMap::const_iterator iterator=table.begin(); iterator!=table.end(); iterator++) {
-        AddressPtr destination = iterator->first;
-        RoutingTableEntryList* nextHopsForDestination = iterator->second;
-        for (auto& entry: *nextHopsForDestination) {
-            if(entry->getAddress()->equals(nextHop)) {
-                RoutingTableEntryTupel tupel;
-                tupel.destination = destination;
-                tupel.entry = entry;
-                result.push_back(tupel);
+    NextHopIndex::const_iterator foundNextHop = nextHopIndex.find(nextHop);
+    if (foundNextHop != nextHopIndex.end()) {
+        for (auto& destinationCounter: foundNextHop->second) {
+            AddressPtr destination = destinationCounter.first;
+            for (auto& entry: table->at(destination)->entries) {
+                if(entry->getAddress()->equals(nextHop)) {
+                    RoutingTableEntryTupel tupel;
+                    tupel.destination = destination;
+                    tupel.entry = entry;
+                    result.push_back(tupel);
+                }
             }
         }
     }
@@ -288,4 +740,27 @@ std::deque<RoutingTableEntryTupel> RoutingTable::getAllRoutesThatLeadOver(Addres
     return result;
 }
 
+void RoutingTable::addToNextHopIndex(const AddressPtr& destination, const AddressPtr& nextHop) {
+    nextHopIndex[nextHop][destination]++;
+    invalidateRouteHandles();
+}
+
+void RoutingTable::removeFromNextHopIndex(const AddressPtr& destination, const AddressPtr& nextHop) {
+    invalidateRouteHandles();
+    NextHopIndex::iterator foundNextHop = nextHopIndex.find(nextHop);
+    if (foundNextHop != nextHopIndex.end()) {
+        DestinationCounterMap& destinations = foundNextHop->second;
+        DestinationCounterMap::iterator foundDestination = destinations.find(destination);
+        if (foundDestination != destinations.end()) {
+            foundDestination->second--;
+            if (foundDestination->second == 0) {
+                destinations.erase(foundDestination);
+                if (destinations.empty()) {
+                    nextHopIndex.erase(foundNextHop);
+                }
+            }
+        }
+    }
+}
+
 ARA_NAMESPACE_END
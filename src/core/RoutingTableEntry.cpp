@@ -6,33 +6,48 @@
 
 ARA_NAMESPACE_BEGIN
 
-RoutingTableEntry::RoutingTableEntry(std::shared_ptr<Address> address, NetworkInterface* interface, float pheromoneValue) {
-    nextHop = new NextHop(address, interface);
-    this->pheromoneValue = pheromoneValue;
-}
+const unsigned int RoutingTableEntry::NOT_TRACKED;
+
+RoutingTableEntry::RoutingTableEntry(std::shared_ptr<Address> address, NetworkInterface* interface, float pheromoneValue) : nextHop(address, interface), pheromoneValue(pheromoneValue), evictionQueuePosition(NOT_TRACKED), timestamp(0) {}
 
-RoutingTableEntry::~RoutingTableEntry() {
-    delete nextHop;
+RoutingTableEntry::RoutingTableEntry(const RoutingTableEntry& other) : nextHop(other.nextHop), pheromoneValue(other.pheromoneValue.load(std::memory_order_relaxed)), evictionQueuePosition(other.evictionQueuePosition), timestamp(other.timestamp.load(std::memory_order_relaxed)) {}
+
+RoutingTableEntry& RoutingTableEntry::operator=(const RoutingTableEntry& other) {
+    nextHop = other.nextHop;
+    pheromoneValue.store(other.pheromoneValue.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    evictionQueuePosition = other.evictionQueuePosition;
+    timestamp.store(other.timestamp.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return *this;
 }
 
+RoutingTableEntry::~RoutingTableEntry() {}
+
 NextHop* RoutingTableEntry::getNextHop() {
-    return nextHop;
+    return &nextHop;
 }
 
-std::shared_ptr<Address> RoutingTableEntry::getAddress() {
-    return nextHop->getAddress();
+const std::shared_ptr<Address>& RoutingTableEntry::getAddress() {
+    return nextHop.getAddress();
 }
 
 NetworkInterface* RoutingTableEntry::getNetworkInterface() {
-    return nextHop->getInterface();
+    return nextHop.getInterface();
 }
 
 float RoutingTableEntry::getPheromoneValue() {
-    return pheromoneValue;
+    return pheromoneValue.load(std::memory_order_relaxed);
 }
 
 void RoutingTableEntry::setPheromoneValue(float newPheromoneValue) {
-    this->pheromoneValue = newPheromoneValue;
+    pheromoneValue.store(newPheromoneValue, std::memory_order_relaxed);
+}
+
+long RoutingTableEntry::getTimestamp() {
+    return timestamp.load(std::memory_order_relaxed);
+}
+
+void RoutingTableEntry::setTimestamp(long newTimestamp) {
+    timestamp.store(newTimestamp, std::memory_order_relaxed);
 }
 
 ARA_NAMESPACE_END
@@ -0,0 +1,93 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "SequenceNumberWindow.h"
+
+#include <algorithm>
+#include <cstring>
+
+ARA_NAMESPACE_BEGIN
+
+SequenceNumberWindow::SequenceNumberWindow() {
+    std::memset(bits, 0, sizeof(bits));
+    highestSequenceNumber = 0;
+    isEmpty = true;
+}
+
+int32_t SequenceNumberWindow::getDistanceToHighestSequenceNumber(unsigned int sequenceNumber) const {
+    // the unsigned subtraction wraps around so the signed result is correct as long as both numbers are less than 2^31 apart
+    return (int32_t) (uint32_t) (highestSequenceNumber - sequenceNumber);
+}
+
+bool SequenceNumberWindow::contains(unsigned int sequenceNumber) const {
+    if (isEmpty) {
+        return false;
+    }
+
+    int32_t distance = getDistanceToHighestSequenceNumber(sequenceNumber);
+    if (distance < 0 || distance >= (int32_t) SIZE) {
+        // this is either newer than everything we have seen so far or too old to tell
+        return false;
+    }
+    else {
+        return isSet(sequenceNumber);
+    }
+}
+
+bool SequenceNumberWindow::isOutdated(unsigned int sequenceNumber) const {
+    return isEmpty == false && getDistanceToHighestSequenceNumber(sequenceNumber) >= (int32_t) SIZE;
+}
+
+void SequenceNumberWindow::insert(unsigned int sequenceNumber) {
+    if (isEmpty) {
+        highestSequenceNumber = sequenceNumber;
+        isEmpty = false;
+    }
+    else {
+        int32_t distance = getDistanceToHighestSequenceNumber(sequenceNumber);
+        if (distance >= (int32_t) SIZE) {
+            // this has already fallen out of the window
+            return;
+        }
+        else if (distance < 0) {
+            // move the window forward and forget the sequence numbers that are now reused in the ring buffer
+            unsigned int advance = (unsigned int) -(int64_t) distance;
+            if (advance >= SIZE) {
+                std::memset(bits, 0, sizeof(bits));
+            }
+            else {
+                clearAfterHighestSequenceNumber(advance);
+            }
+            highestSequenceNumber = sequenceNumber;
+        }
+    }
+
+    set(sequenceNumber);
+}
+
+bool SequenceNumberWindow::isSet(unsigned int sequenceNumber) const {
+    unsigned int position = sequenceNumber % SIZE;
+    return (bits[position / 64] >> (position % 64)) & 1;
+}
+
+void SequenceNumberWindow::set(unsigned int sequenceNumber) {
+    unsigned int position = sequenceNumber % SIZE;
+    bits[position / 64] |= (uint64_t) 1 << (position % 64);
+}
+
+void SequenceNumberWindow::clearAfterHighestSequenceNumber(unsigned int nrOfSequenceNumbers) {
+    unsigned int position = (highestSequenceNumber + 1) % SIZE;
+    while (nrOfSequenceNumbers > 0) {
+        // clear the bits up to the end of the current word at once (SIZE is a multiple of 64, so no word wraps around)
+        unsigned int offset = position % 64;
+        unsigned int nrOfBits = std::min(64 - offset, nrOfSequenceNumbers);
+        uint64_t mask = (nrOfBits == 64) ? ~(uint64_t) 0 : (((uint64_t) 1 << nrOfBits) - 1) << offset;
+        bits[position / 64] &= ~mask;
+
+        nrOfSequenceNumbers -= nrOfBits;
+        position = (position + nrOfBits) % SIZE;
+    }
+}
+
+ARA_NAMESPACE_END
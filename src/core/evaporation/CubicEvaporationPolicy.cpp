@@ -15,6 +15,7 @@ CubicEvaporationPolicy::CubicEvaporationPolicy(unsigned int millisecondsUntilPla
     this->alpha = millisecondsUntilPlateauCenterIsReached;
     this->plateauCenterDepth = plateauCenterDepth;
     this->exponent = oddExponent;
+    this->potentiatedAlpha = pow(alpha, exponent);
 }
 
 void CubicEvaporationPolicy::checkExponent(unsigned int exponent) {
@@ -24,10 +25,7 @@ void CubicEvaporationPolicy::checkExponent(unsigned int exponent) {
 }
 
 float CubicEvaporationPolicy::evaporate(float oldPheromoneValue, float milliSecondsSinceLastTraffic) {
-    float potentiatedAlpha = pow(alpha, exponent);
-    float factor = plateauCenterDepth / potentiatedAlpha;
-    float amountOfEvaporation = factor * (potentiatedAlpha + pow(milliSecondsSinceLastTraffic - alpha, exponent));
-    float newPheromoneValue = oldPheromoneValue - amountOfEvaporation;
+    float newPheromoneValue = oldPheromoneValue - getAmountOfEvaporation(milliSecondsSinceLastTraffic);
 
     if(newPheromoneValue < 0) {
         newPheromoneValue = 0;
@@ -36,8 +34,14 @@ float CubicEvaporationPolicy::evaporate(float oldPheromoneValue, float milliSeco
     return newPheromoneValue;
 }
 
+float CubicEvaporationPolicy::getAmountOfEvaporation(float milliSecondsSinceLastTraffic) const {
+    float factor = plateauCenterDepth / potentiatedAlpha;
+    return factor * (potentiatedAlpha + pow(milliSecondsSinceLastTraffic - alpha, exponent));
+}
+
 void CubicEvaporationPolicy::setTimeUntilPlateauCenterIsReached(unsigned int millisecondsUntilPlateauCenterIsReached) {
     alpha = millisecondsUntilPlateauCenterIsReached;
+    potentiatedAlpha = pow(alpha, exponent);
 }
 
 void CubicEvaporationPolicy::setPlateauCenterDepth(float newPlateauCenterDepth) {
@@ -47,4 +51,5 @@ void CubicEvaporationPolicy::setPlateauCenterDepth(float newPlateauCenterDepth)
 void CubicEvaporationPolicy::setExponent(unsigned int newOddExponent) {
     checkExponent(newOddExponent);
     exponent = newOddExponent;
+    potentiatedAlpha = pow(alpha, exponent);
 }
@@ -0,0 +1,145 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "EvaporationKernels.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ARA_X86_EVAPORATION_KERNELS
+#include <immintrin.h>
+#endif
+
+ARA_NAMESPACE_BEGIN
+
+EvaporationKernels::InstructionSet EvaporationKernels::instructionSet = EvaporationKernels::getSupportedInstructionSet();
+
+namespace {
+
+    void multiplyScalar(float* values, size_t nrOfValues, float factor, float threshold) {
+        for (size_t i = 0; i < nrOfValues; i++) {
+            float newValue = values[i] * factor;
+            values[i] = newValue < threshold ? 0 : newValue;
+        }
+    }
+
+    void subtractScalar(float* values, size_t nrOfValues, float amount, float threshold) {
+        for (size_t i = 0; i < nrOfValues; i++) {
+            float newValue = values[i] - amount;
+            values[i] = newValue < threshold ? 0 : newValue;
+        }
+    }
+
+#ifdef ARA_X86_EVAPORATION_KERNELS
+    /*
+     * The values below the threshold are masked out with andnot, so each value that does not
+     * compare less than the threshold (this includes NaN) is kept like in the scalar kernels.
+     * The remaining values that do not fill a whole vector are handled by the scalar kernels.
+     */
+
+    __attribute__((target("sse2")))
+    void multiplySSE(float* values, size_t nrOfValues, float factor, float threshold) {
+        __m128 factors = _mm_set1_ps(factor);
+        __m128 thresholds = _mm_set1_ps(threshold);
+        size_t i = 0;
+        for (; i + 4 <= nrOfValues; i += 4) {
+            __m128 newValues = _mm_mul_ps(_mm_loadu_ps(values + i), factors);
+            __m128 isBelowThreshold = _mm_cmplt_ps(newValues, thresholds);
+            _mm_storeu_ps(values + i, _mm_andnot_ps(isBelowThreshold, newValues));
+        }
+        multiplyScalar(values + i, nrOfValues - i, factor, threshold);
+    }
+
+    __attribute__((target("sse2")))
+    void subtractSSE(float* values, size_t nrOfValues, float amount, float threshold) {
+        __m128 amounts = _mm_set1_ps(amount);
+        __m128 thresholds = _mm_set1_ps(threshold);
+        size_t i = 0;
+        for (; i + 4 <= nrOfValues; i += 4) {
+            __m128 newValues = _mm_sub_ps(_mm_loadu_ps(values + i), amounts);
+            __m128 isBelowThreshold = _mm_cmplt_ps(newValues, thresholds);
+            _mm_storeu_ps(values + i, _mm_andnot_ps(isBelowThreshold, newValues));
+        }
+        subtractScalar(values + i, nrOfValues - i, amount, threshold);
+    }
+
+    __attribute__((target("avx2")))
+    void multiplyAVX2(float* values, size_t nrOfValues, float factor, float threshold) {
+        __m256 factors = _mm256_set1_ps(factor);
+        __m256 thresholds = _mm256_set1_ps(threshold);
+        size_t i = 0;
+        for (; i + 8 <= nrOfValues; i += 8) {
+            __m256 newValues = _mm256_mul_ps(_mm256_loadu_ps(values + i), factors);
+            __m256 isBelowThreshold = _mm256_cmp_ps(newValues, thresholds, _CMP_LT_OQ);
+            _mm256_storeu_ps(values + i, _mm256_andnot_ps(isBelowThreshold, newValues));
+        }
+        multiplySSE(values + i, nrOfValues - i, factor, threshold);
+    }
+
+    __attribute__((target("avx2")))
+    void subtractAVX2(float* values, size_t nrOfValues, float amount, float threshold) {
+        __m256 amounts = _mm256_set1_ps(amount);
+        __m256 thresholds = _mm256_set1_ps(threshold);
+        size_t i = 0;
+        for (; i + 8 <= nrOfValues; i += 8) {
+            __m256 newValues = _mm256_sub_ps(_mm256_loadu_ps(values + i), amounts);
+            __m256 isBelowThreshold = _mm256_cmp_ps(newValues, thresholds, _CMP_LT_OQ);
+            _mm256_storeu_ps(values + i, _mm256_andnot_ps(isBelowThreshold, newValues));
+        }
+        subtractSSE(values + i, nrOfValues - i, amount, threshold);
+    }
+#endif
+}
+
+void EvaporationKernels::multiply(float* values, size_t nrOfValues, float factor, float threshold) {
+    switch (instructionSet) {
+#ifdef ARA_X86_EVAPORATION_KERNELS
+        case AVX2:
+            multiplyAVX2(values, nrOfValues, factor, threshold);
+            break;
+        case SSE:
+            multiplySSE(values, nrOfValues, factor, threshold);
+            break;
+#endif
+        default:
+            multiplyScalar(values, nrOfValues, factor, threshold);
+    }
+}
+
+void EvaporationKernels::subtract(float* values, size_t nrOfValues, float amount, float threshold) {
+    switch (instructionSet) {
+#ifdef ARA_X86_EVAPORATION_KERNELS
+        case AVX2:
+            subtractAVX2(values, nrOfValues, amount, threshold);
+            break;
+        case SSE:
+            subtractSSE(values, nrOfValues, amount, threshold);
+            break;
+#endif
+        default:
+            subtractScalar(values, nrOfValues, amount, threshold);
+    }
+}
+
+EvaporationKernels::InstructionSet EvaporationKernels::getInstructionSet() {
+    return instructionSet;
+}
+
+EvaporationKernels::InstructionSet EvaporationKernels::getSupportedInstructionSet() {
+#ifdef ARA_X86_EVAPORATION_KERNELS
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        return AVX2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return SSE;
+    }
+#endif
+    return SCALAR;
+}
+
+void EvaporationKernels::setInstructionSet(InstructionSet instructionSet) {
+    InstructionSet supportedInstructionSet = getSupportedInstructionSet();
+    EvaporationKernels::instructionSet = instructionSet < supportedInstructionSet ? instructionSet : supportedInstructionSet;
+}
+
+ARA_NAMESPACE_END
@@ -3,6 +3,7 @@
  */
 
 #include "ExponentialEvaporationPolicy.h"
+#include "EvaporationKernels.h"
 
 #include <cmath>
 #include <iostream>
@@ -28,3 +29,15 @@ float ExponentialEvaporationPolicy::evaporate(float oldPheromoneValue, int milli
         return newPheromoneValue;
     }
 }
+
+void ExponentialEvaporationPolicy::evaporate(float* pheromoneValues, size_t nrOfValues, int millisecondsSinceLastEvaporation) {
+    if(millisecondsSinceLastEvaporation != 0) {
+        float multiplicator = millisecondsSinceLastEvaporation / (float) timeInterval;
+        EvaporationKernels::multiply(pheromoneValues, nrOfValues, pow(evaporationFactor, multiplicator), threshold);
+    }
+}
+
+bool ExponentialEvaporationPolicy::isLazyEvaluationSupported() const {
+    // factor^a * factor^b = factor^(a+b) and the threshold is hit either way because the function is monotonic
+    return true;
+}
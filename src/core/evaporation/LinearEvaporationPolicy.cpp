@@ -3,6 +3,7 @@
  */
 
 #include "LinearEvaporationPolicy.h"
+#include "EvaporationKernels.h"
 
 #include <cmath>
 #include <iostream>
@@ -42,3 +43,15 @@ float LinearEvaporationPolicy::evaporate(float oldPheromoneValue, int millisecon
         return newPheromoneValue;
     }
 }
+
+void LinearEvaporationPolicy::evaporate(float* pheromoneValues, size_t nrOfValues, int millisecondsSinceLastEvaporation) {
+    if(millisecondsSinceLastEvaporation != 0) {
+        float multiplicator = ((float)millisecondsSinceLastEvaporation) / ((float)timeInterval);
+        EvaporationKernels::subtract(pheromoneValues, nrOfValues, this->evaporationFactor * multiplicator, threshold);
+    }
+}
+
+bool LinearEvaporationPolicy::isLazyEvaluationSupported() const {
+    // the pheromones decrease by a constant amount per millisecond and the threshold is hit either way
+    return true;
+}
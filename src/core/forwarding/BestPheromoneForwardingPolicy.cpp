@@ -14,18 +14,10 @@ BestPheromoneForwardingPolicy::BestPheromoneForwardingPolicy(RoutingTable* routi
 }
 
 NextHop* BestPheromoneForwardingPolicy::getNextHop(const Packet* packet) {
-    RoutingTableEntryList possibleNextHops = routingTable->getPossibleNextHops(packet);
-    if(possibleNextHops.empty()) {
-        throw Exception("Could not determine next hop: there are no known routes to the destination");
-    }
+    RoutingTableEntry* bestEntry = routingTable->getNextHopCandidates(packet).getBestCandidate();
 
-    RoutingTableEntry* bestEntry = nullptr;
-    float globalMaximum = 0;
-    for(auto& possibleNextHop: possibleNextHops) {
-        if(possibleNextHop->getPheromoneValue() > globalMaximum) {
-            bestEntry = possibleNextHop;
-            globalMaximum = bestEntry->getPheromoneValue();
-        }
+    if(bestEntry == nullptr) {
+        throw Exception("Could not determine next hop: there are no known routes to the destination");
     }
 
     return bestEntry->getNextHop();
@@ -11,58 +11,23 @@ StochasticForwardingPolicy::StochasticForwardingPolicy(RoutingTable* routingTabl
 }
 
 NextHop* StochasticForwardingPolicy::getNextHop(const Packet* packet) {
-    std::deque<RoutingTableEntry*> possibleNextHops = routingTable->getPossibleNextHops(packet);
+    NextHopCandidates possibleNextHops = routingTable->getNextHopCandidates(packet);
 
     if (possibleNextHops.empty()) {
         throw Exception("Could not determine next hop: there are no known routes to the destination");
     }
 
-    unsigned int nrOfPossibleNextHops = possibleNextHops.size();
-
-    if (nrOfPossibleNextHops > 0) {
-        std::vector<float> cumulativeSum(nrOfPossibleNextHops);
-        std::vector<float> probabilities(nrOfPossibleNextHops);
-        std::vector<float> pheromoneValues(nrOfPossibleNextHops);
-
-        float sumOfPheromoneValues = 0;
-
-        for (unsigned int i = 0; i < nrOfPossibleNextHops; i++) {
-            pheromoneValues[i] = possibleNextHops.at(i)->getPheromoneValue();
-            sumOfPheromoneValues += pheromoneValues[i];
-        }
-
-        // calculate the probabilities
-        for (unsigned int i = 0; i < nrOfPossibleNextHops; i++) {
-            probabilities[i] = pheromoneValues[i] / sumOfPheromoneValues;
-        }
-
-        // compute the cumulative sum
-        std::partial_sum(probabilities.begin(), probabilities.end(), cumulativeSum.begin());
-
-        // get a random number between 0.0 and 1.0
-        float randomNumber = this->getRandomNumber();
-
-        int nodeIndex = 0;
-
-        while (randomNumber > cumulativeSum[nodeIndex]) {
-            nodeIndex += 1;
-        }
-
-        NextHop* result = possibleNextHops.at(nodeIndex)->getNextHop();
-        return result;
-    }
-    // DEBUG:
-    std::cerr << "[StochasticForwardingPolicy::getNextHop] no next hop available" << std::endl;
-
-    return nullptr;
+    // get a random number between 0.0 and 1.0
+    float randomNumber = this->getRandomNumber();
+    return possibleNextHops.sample(randomNumber)->getNextHop();
 }
 
-void StochasticForwardingPolicy::initializeRandomNumberGenerator(unsigned int seed) {
-    srand(seed);
+void StochasticForwardingPolicy::initializeRandomNumberGenerator(uint64_t seed, uint64_t stream) {
+    randomNumberGenerator.seed(seed, stream);
 }
 
 float StochasticForwardingPolicy::getRandomNumber() {
-    return (float)random() / (float)RAND_MAX;
+    return randomNumberGenerator.nextFloat();
 }
 
 ARA_NAMESPACE_END
@@ -10,10 +10,6 @@ LinearPathReinforcementPolicy::LinearPathReinforcementPolicy(float deltaPhi) {
     this->deltaPhi = deltaPhi;
 }
 
-float LinearPathReinforcementPolicy::calculateReinforcedValue(float oldPheromoneValue) {
-     return oldPheromoneValue + deltaPhi;
-}
-
 void LinearPathReinforcementPolicy::setDeltaPhi(float deltaPhi) {
     this->deltaPhi = deltaPhi;
 }
@@ -19,6 +19,7 @@ void AbstractEARAClient::initializeEARA(EARAConfiguration& configuration) {
     routingTable = configuration.getEnergyAwareRoutingTable();
     packetFactory = configuration.getEARAPacketFactory();
     forwardingPolicy = configuration.getForwardingPolicy();
+    routingTable->activateFitnessWeighting(WeightedFitness(forwardingPolicy->getPheromoneWeight(), forwardingPolicy->getEnergyWeight()));
     maximumEnergyValue = configuration.getMaximumEnergyValue();
     maximumBatteryCapacityInNetwork = configuration.getMaximumBatteryCapacityInNetwork(); //TODO read this from configuration
     influenceOfMinimumEnergyValue = configuration.getInfluenceOfMinimumEnergyValue();
@@ -48,8 +49,8 @@ void AbstractEARAClient::createNewRouteFrom(Packet* packet, NetworkInterface* in
 }
 
 void AbstractEARAClient::updateRoutingTable(Packet* packet, NetworkInterface* interface) {
-    AddressPtr source = packet->getSource();
-    AddressPtr sender = packet->getSender();
+    const AddressPtr& source = packet->getSource();
+    const AddressPtr& sender = packet->getSender();
     if (packet->isAntPacket() && isLocalAddress(packet->getPreviousHop()) == false
         && routingTable->isNewRoute(source, sender, interface) == false) {
 
@@ -73,7 +74,7 @@ void AbstractEARAClient::broadCast(Packet* packet) {
     AbstractARAClient::broadCast(packet);
 }
 
-void AbstractEARAClient::sendUnicast(Packet* packet, NetworkInterface* interface, AddressPtr receiver) {
+void AbstractEARAClient::sendUnicast(Packet* packet, NetworkInterface* interface, const AddressPtr& receiver) {
     addEnergyInformationToPacket(packet);
     AbstractARAClient::sendUnicast(packet, interface, receiver);
 }
@@ -88,7 +89,7 @@ void AbstractEARAClient::addEnergyInformationToPacket(Packet* packet) {
 }
 
 bool AbstractEARAClient::hasBeenReceivedEarlier(const Packet* packet) {
-    if (runningRouteDiscoveryDelayTimers.find(packet->getSource()) == runningRouteDiscoveryDelayTimers.end()) {
+    if (runningRouteDiscoveryDelayTimers.find(packet->getSourceId()) == runningRouteDiscoveryDelayTimers.end()) {
         return AbstractARAClient::hasBeenReceivedEarlier(packet);
     }
     else {
@@ -155,7 +156,7 @@ float AbstractEARAClient::getEnergyPercentage(float energyValue) const {
 }
 
 void AbstractEARAClient::handleAntPacketWithDelayTimer(Packet* antPacket, NetworkInterface* interface) {
-    RouteDiscoveryDelayTimerMap::iterator found = runningRouteDiscoveryDelayTimers.find(antPacket->getSource());
+    RouteDiscoveryDelayTimerMap::iterator found = runningRouteDiscoveryDelayTimers.find(antPacket->getSourceId());
     float routeEnergyOfNewAnt = routingTable->getEnergyValue(antPacket->getSource(), antPacket->getSender(), interface);
 
     if (found == runningRouteDiscoveryDelayTimers.end()) {
@@ -185,7 +186,7 @@ void AbstractEARAClient::startNewRouteDiscoveryDelayTimer(Packet* antPacket, flo
     Timer* newDelayTimer = getNewTimer(TimerType::ROUTE_DISCOVERY_DELAY_TIMER, contextObject);
     newDelayTimer->addTimeoutListener(this);
     newDelayTimer->run(routeDiscoveryDelayInMilliSeconds * 1000);
-    runningRouteDiscoveryDelayTimers[antPacket->getSource()] = newDelayTimer;
+    runningRouteDiscoveryDelayTimers[antPacket->getSourceId()] = newDelayTimer;
 }
 
 float AbstractEARAClient::calculateRouteFitness(int ttl, float energyFitness) {
@@ -208,7 +209,7 @@ void AbstractEARAClient::timerHasExpired(Timer* responsibleTimer) {
 
 void AbstractEARAClient::handleExpiredRouteDiscoveryDelayTimer(Timer* timer) {
     AntPacketRouteFitness* bestAnt = (AntPacketRouteFitness*) timer->getContextObject();
-    runningRouteDiscoveryDelayTimers.erase(bestAnt->packet->getSource());
+    runningRouteDiscoveryDelayTimers.erase(bestAnt->packet->getSourceId());
     broadCast(bestAnt->packet);
     delete bestAnt;
     delete timer;
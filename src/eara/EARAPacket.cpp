@@ -9,7 +9,11 @@
 ARA_NAMESPACE_BEGIN
 
 EARAPacket::EARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize)
-    : Packet(source, destination, sender, type, seqNr, ttl, payload, payloadSize) {
+    : EARAPacket(source, destination, sender, type, seqNr, ttl, PayloadBuffer(payload, payloadSize)) {
+}
+
+EARAPacket::EARAPacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload)
+    : Packet(source, destination, sender, type, seqNr, ttl, payload) {
     totalEnergyValue = 0;
     minEnergyValue = UINT_MAX;
 }
@@ -11,7 +11,7 @@ EARAPacket* EARAPacketFactory::makePEANT(AddressPtr source,  unsigned int sequen
 }
 
 EARAPacket* EARAPacketFactory::makeClone(const Packet* originalPacket) {
-    EARAPacket* clone = makePacket(originalPacket->getSource(), originalPacket->getDestination(), originalPacket->getSender(), originalPacket->getType(), originalPacket->getSequenceNumber(), originalPacket->getTTL(), originalPacket->getPayload(), originalPacket->getPayloadLength(), originalPacket->getPreviousHop());
+    EARAPacket* clone = makePacket(originalPacket->getSource(), originalPacket->getDestination(), originalPacket->getSender(), originalPacket->getType(), originalPacket->getSequenceNumber(), originalPacket->getTTL(), originalPacket->getPayloadBuffer(), originalPacket->getPreviousHop());
 
     const EARAPacket* originalEARAPacket = dynamic_cast<const EARAPacket*>(originalPacket);
     if (originalEARAPacket != NULL) {
@@ -22,8 +22,12 @@ EARAPacket* EARAPacketFactory::makeClone(const Packet* originalPacket) {
     return clone;
 }
 
-EARAPacket* EARAPacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const char* payload, unsigned int payloadSize, AddressPtr previousHop) {
-    EARAPacket* packet = new EARAPacket(source, destination, sender, type, seqNr, ttl, payload, payloadSize);
+std::size_t EARAPacketFactory::getPacketSize() const {
+    return sizeof(EARAPacket);
+}
+
+EARAPacket* EARAPacketFactory::makePacket(AddressPtr source, AddressPtr destination, AddressPtr sender, char type, unsigned int seqNr, int ttl, const PayloadBuffer& payload, AddressPtr previousHop) {
+    EARAPacket* packet = new EARAPacket(source, destination, sender, type, seqNr, ttl, payload);
     if(previousHop != nullptr) {
         packet->setPreviousHop(previousHop);
     }
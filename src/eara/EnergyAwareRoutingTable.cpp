@@ -7,14 +7,14 @@
 
 ARA_NAMESPACE_BEGIN
 
+EnergyAwareRoutingTable::EnergyAwareRoutingTable() {
+    fitnessWeightingIsActivated = false;
+}
+
 void EnergyAwareRoutingTable::update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue) {
-    EARARoutingTableEntry* entry = getRoutingTableEntry(destination, nextHop, interface);
-    if (entry == nullptr) {
-        throw Exception("EnergyAwareRoutingTable can only create/update entries when an energy value is supplied (Most likely a bug in EARA code?!)");
-    }
-    else {
-        entry->setPheromoneValue(pheromoneValue);
-    }
+    // the update needs to go through the base class so the aggregates of the destination are kept up to date
+    RouteHandle route = findRoute(destination, nextHop, interface);
+    update(route, pheromoneValue);
 }
 
 void EnergyAwareRoutingTable::update(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface, float pheromoneValue, float normalizedEnergyValue) {
@@ -22,6 +22,13 @@ void EnergyAwareRoutingTable::update(AddressPtr destination, AddressPtr nextHop,
     RoutingTable::update(destination, entry);
 }
 
+void EnergyAwareRoutingTable::update(RouteHandle& route, float pheromoneValue) {
+    if (route.exists() == false) {
+        throw Exception("EnergyAwareRoutingTable can only create/update entries when an energy value is supplied (Most likely a bug in EARA code?!)");
+    }
+    RoutingTable::update(route, pheromoneValue);
+}
+
 void EnergyAwareRoutingTable::updateExistingEntry(RoutingTableEntry* oldEntry, RoutingTableEntry* newEntry) {
     //TODO somehow do this without casting (needs bigger refactoring of the RoutingTable class I guess)
     oldEntry->setPheromoneValue(newEntry->getPheromoneValue());
@@ -35,6 +42,10 @@ bool EnergyAwareRoutingTable::updateEnergyValue(AddressPtr destination, AddressP
     EARARoutingTableEntry* entry = getRoutingTableEntry(destination, nextHop, interface);
     if (entry != nullptr) {
         entry->setEnergyValue(newEnergyValue);
+        if (fitnessWeightingIsActivated) {
+            // the entry has been found so the routes of the destination exist and have already been evaporated
+            invalidateSelectionWeights(table->at(destination));
+        }
         return true;
     }
     else {
@@ -43,8 +54,8 @@ bool EnergyAwareRoutingTable::updateEnergyValue(AddressPtr destination, AddressP
 }
 
 EARARoutingTableEntry* EnergyAwareRoutingTable::getRoutingTableEntry(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
-    if (isDeliverable(destination)) {
-        RoutingTableEntryList* entries = table[destination];
+    RoutingTableEntryList* entries = findEntries(destination);
+    if (entries != nullptr) {
         for (auto& entry: *entries) {
             if (entry->getAddress()->equals(nextHop) && entry->getNetworkInterface()->equals(interface)) {
                 //TODO somehow remove this cast (refactor)
@@ -67,13 +78,71 @@ float EnergyAwareRoutingTable::getEnergyValue(AddressPtr destination, AddressPtr
     }
 }
 
+void EnergyAwareRoutingTable::forEachEntry(const EARARoutingTableVisitor& visitor) const {
+    RoutingTable::forEachEntry([&visitor](const AddressPtr& destination, RoutingTableEntry* entry) {
+        visitor(destination, (EARARoutingTableEntry*) entry);
+    });
+}
+
+EnergyAwareRoutingTable::const_iterator EnergyAwareRoutingTable::begin() const {
+    return const_iterator(RoutingTable::begin());
+}
+
+EnergyAwareRoutingTable::const_iterator EnergyAwareRoutingTable::end() const {
+    return const_iterator(RoutingTable::end());
+}
+
+EARARoutingTableEntryTupel EnergyAwareRoutingTable::const_iterator::operator*() const {
+    RoutingTableEntryTupel tupel = RoutingTable::const_iterator::operator*();
+    EARARoutingTableEntryTupel earaTupel;
+    earaTupel.destination = tupel.destination;
+    earaTupel.entry = (EARARoutingTableEntry*) tupel.entry;
+    return earaTupel;
+}
+
+EnergyAwareRoutingTable::const_iterator& EnergyAwareRoutingTable::const_iterator::operator++() {
+    RoutingTable::const_iterator::operator++();
+    return *this;
+}
+
+void EnergyAwareRoutingTable::activateFitnessWeighting(const WeightedFitness& fitness) {
+    if (isFitnessWeightingActivated(fitness) == false) {
+        this->fitness = fitness;
+        fitnessWeightingIsActivated = true;
+        invalidateSelectionWeights(nullptr);
+    }
+}
+
+void EnergyAwareRoutingTable::deactivateFitnessWeighting() {
+    if (fitnessWeightingIsActivated) {
+        fitnessWeightingIsActivated = false;
+        invalidateSelectionWeights(nullptr);
+    }
+}
+
+bool EnergyAwareRoutingTable::isFitnessWeightingActivated() const {
+    return fitnessWeightingIsActivated;
+}
+
+bool EnergyAwareRoutingTable::isFitnessWeightingActivated(const WeightedFitness& fitness) const {
+    return fitnessWeightingIsActivated && this->fitness == fitness;
+}
+
+float EnergyAwareRoutingTable::getSelectionWeight(RoutingTableEntry* entry) const {
+    if (fitnessWeightingIsActivated == false) {
+        return entry->getPheromoneValue();
+    }
+    //TODO somehow remove this cast (refactor)
+    EARARoutingTableEntry* earaEntry = (EARARoutingTableEntry*) entry;
+    return fitness.calculate(earaEntry->getPheromoneValue(), earaEntry->getEnergyValue());
+}
+
 EARARoutingTableEntryTupel EnergyAwareRoutingTable::getEntryAt(int wantedPosition) const {
     int currentPosition = 0;
     RoutingTableMap::const_iterator iterator;
-    for (iterator=table.begin(); iterator!=table.end(); iterator++) {
+    for (iterator=table->begin(); iterator!=table->end(); iterator++) {
         AddressPtr destination = iterator->first;
-        RoutingTableEntryList* entryList = iterator->second;
-        for (auto& entry: *entryList) {
+        for (auto& entry: iterator->second->entries) {
             if(currentPosition == wantedPosition) {
                 EARARoutingTableEntryTupel tupel;
                 tupel.destination = destination;
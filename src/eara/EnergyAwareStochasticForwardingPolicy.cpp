@@ -7,52 +7,41 @@
 #include "RoutingTableEntry.h"
 #include "Exception.h"
 
-#include <cmath>
 #include <deque>
-#include <cassert>
 
 ARA_NAMESPACE_BEGIN
 
-EnergyAwareStochasticForwardingPolicy::EnergyAwareStochasticForwardingPolicy(EnergyAwareRoutingTable* routingTable, float pheromoneWeight, float energyWeight) : StochasticForwardingPolicy(routingTable) {
+EnergyAwareStochasticForwardingPolicy::EnergyAwareStochasticForwardingPolicy(EnergyAwareRoutingTable* routingTable, float pheromoneWeight, float energyWeight) : StochasticForwardingPolicy(routingTable), fitness(pheromoneWeight, energyWeight) {
     this->routingTable = routingTable;
-    this->pheromoneWeight = pheromoneWeight;
-    this->energyWeight = energyWeight;
 }
 
 NextHop* EnergyAwareStochasticForwardingPolicy::getNextHop(const Packet* packet) {
-    std::deque<RoutingTableEntry*> possibleNextHops = routingTable->getPossibleNextHops(packet);
-    unsigned int nrOfPossibleNextHops = possibleNextHops.size();
+    NextHopCandidates possibleNextHops = routingTable->getNextHopCandidates(packet);
 
-    if (nrOfPossibleNextHops > 0) {
-        float sum = 0.0;
-
-        std::vector<float> products(nrOfPossibleNextHops);
-        std::vector<float> probabilities(nrOfPossibleNextHops);
-
-        for (unsigned int i = 0; i < nrOfPossibleNextHops; i++) {
-            EARARoutingTableEntry* entry = dynamic_cast<EARARoutingTableEntry*>(possibleNextHops.at(i));
-            assert(entry);
-
-            float pheromoneValue = entry->getPheromoneValue();
-            float energyValue = entry->getEnergyValue();
-
-            float potentiatedPheromoneValue = pow(pheromoneValue, pheromoneWeight);
-            float potentiatedEnergyValue = pow(energyValue, energyWeight);
-
-            products[i] = potentiatedPheromoneValue * potentiatedEnergyValue;
-            sum += products[i];
+    if (possibleNextHops.empty() == false) {
+        if (routingTable->isFitnessWeightingActivated(fitness)) {
+            // the routing table already knows the cumulative fitness of the routes
+            return possibleNextHops.sample(this->getRandomNumber())->getNextHop();
         }
 
-
-        for (unsigned int i = 0; i < nrOfPossibleNextHops; i++) {
-            probabilities[i] = products[i] / sum;
+        float sum = 0.0;
+        for (auto possibleNextHop: possibleNextHops) {
+            sum += getWeightedProduct(possibleNextHop);
         }
 
-        std::vector<float> cumulativeSum(nrOfPossibleNextHops);
-        std::partial_sum(probabilities.begin(), probabilities.end(), cumulativeSum.begin());
+        // walk along the cumulative sum of the probabilities until it exceeds the random number
+        float randomNumber = this->getRandomNumber();
+        float cumulativeSum = 0;
+        RoutingTableEntry* selectedEntry = nullptr;
+        for (auto possibleNextHop: possibleNextHops) {
+            selectedEntry = possibleNextHop;
+            cumulativeSum += getWeightedProduct(possibleNextHop) / sum;
+            if (randomNumber <= cumulativeSum) {
+                break;
+            }
+        }
 
-        int nodeIndex = getRandomNodeIndex(cumulativeSum);
-        return possibleNextHops.at(nodeIndex)->getNextHop();
+        return selectedEntry->getNextHop();
     }
     // DEBUG:
     std::cerr << "[EnergyAwareStochasticForwardingPolicy::getNextHop] no next hop found" << std::endl;
@@ -60,30 +49,34 @@ NextHop* EnergyAwareStochasticForwardingPolicy::getNextHop(const Packet* packet)
     return nullptr;
 }
 
-int EnergyAwareStochasticForwardingPolicy::getRandomNodeIndex(std::vector<float> cumulativeSum) {
-    float randomNumber = this->getRandomNumber();
-    int nodeIndex = 0;
-    while (randomNumber > cumulativeSum[nodeIndex]) {
-        nodeIndex += 1;
-    }
-
-    return nodeIndex;
+float EnergyAwareStochasticForwardingPolicy::getWeightedProduct(RoutingTableEntry* possibleNextHop) {
+    //TODO somehow remove this cast (refactor)
+    EARARoutingTableEntry* entry = (EARARoutingTableEntry*) possibleNextHop;
+    return fitness.calculate(entry->getPheromoneValue(), entry->getEnergyValue());
 }
 
 float EnergyAwareStochasticForwardingPolicy::getPheromoneWeight() {
-    return pheromoneWeight;
+    return fitness.getPheromoneWeight();
 }
 
 float EnergyAwareStochasticForwardingPolicy::getEnergyWeight() {
-    return energyWeight;
+    return fitness.getEnergyWeight();
 }
 
 void EnergyAwareStochasticForwardingPolicy::setPheromoneWeight(float pheromoneWeight){
-    this->pheromoneWeight = pheromoneWeight;
+    fitness.setPheromoneWeight(pheromoneWeight);
+    updateFitnessWeighting();
 }
 
 void EnergyAwareStochasticForwardingPolicy::setEnergyWeight(float energyWeight){
-    this->energyWeight = energyWeight;
+    fitness.setEnergyWeight(energyWeight);
+    updateFitnessWeighting();
+}
+
+void EnergyAwareStochasticForwardingPolicy::updateFitnessWeighting() {
+    if (routingTable != nullptr && routingTable->isFitnessWeightingActivated()) {
+        routingTable->activateFitnessWeighting(fitness);
+    }
 }
 
 ARA_NAMESPACE_END
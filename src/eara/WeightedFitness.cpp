@@ -0,0 +1,70 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "WeightedFitness.h"
+
+#include <cmath>
+
+ARA_NAMESPACE_BEGIN
+
+/** above this the multiplications are not faster than pow anymore */
+const unsigned int MAX_MULTIPLIED_EXPONENT = 8;
+
+WeightedFitness::WeightedFitness(float pheromoneWeight, float energyWeight) {
+    pheromoneExponent = makeExponent(pheromoneWeight);
+    energyExponent = makeExponent(energyWeight);
+}
+
+float WeightedFitness::calculate(float pheromoneValue, float energyValue) const {
+    return power(pheromoneValue, pheromoneExponent) * power(energyValue, energyExponent);
+}
+
+WeightedFitness::Exponent WeightedFitness::makeExponent(float value) {
+    Exponent exponent;
+    exponent.value = value;
+
+    float doubledValue = value * 2;
+    exponent.isHalfInteger = value >= 0 && value <= MAX_MULTIPLIED_EXPONENT && doubledValue == std::floor(doubledValue);
+    exponent.integerPart = exponent.isHalfInteger ? (unsigned int) value : 0;
+    exponent.hasHalf = exponent.isHalfInteger && ((unsigned int) doubledValue) % 2 == 1;
+    return exponent;
+}
+
+float WeightedFitness::power(float base, const Exponent& exponent) {
+    if (exponent.isHalfInteger == false) {
+        return std::pow(base, exponent.value);
+    }
+
+    float result = exponent.hasHalf ? std::sqrt(base) : 1;
+    for (unsigned int i = 0; i < exponent.integerPart; i++) {
+        result *= base;
+    }
+    return result;
+}
+
+float WeightedFitness::getPheromoneWeight() const {
+    return pheromoneExponent.value;
+}
+
+float WeightedFitness::getEnergyWeight() const {
+    return energyExponent.value;
+}
+
+void WeightedFitness::setPheromoneWeight(float pheromoneWeight) {
+    pheromoneExponent = makeExponent(pheromoneWeight);
+}
+
+void WeightedFitness::setEnergyWeight(float energyWeight) {
+    energyExponent = makeExponent(energyWeight);
+}
+
+bool WeightedFitness::operator==(const WeightedFitness& other) const {
+    return pheromoneExponent.value == other.pheromoneExponent.value && energyExponent.value == other.energyExponent.value;
+}
+
+bool WeightedFitness::operator!=(const WeightedFitness& other) const {
+    return (*this == other) == false;
+}
+
+ARA_NAMESPACE_END
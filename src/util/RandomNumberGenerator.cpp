@@ -0,0 +1,22 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "RandomNumberGenerator.h"
+
+ARA_NAMESPACE_BEGIN
+
+RandomNumberGenerator::RandomNumberGenerator(uint64_t seed, uint64_t stream) {
+    this->seed(seed, stream);
+}
+
+void RandomNumberGenerator::seed(uint64_t seed, uint64_t stream) {
+    // the increment selects the stream and must be odd
+    state = 0;
+    increment = (stream << 1) | 1;
+    next();
+    state += seed;
+    next();
+}
+
+ARA_NAMESPACE_END
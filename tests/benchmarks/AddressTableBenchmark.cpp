@@ -0,0 +1,61 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "Address.h"
+#include "testAPI/mocks/AddressMock.h"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+/**
+ * Measures what the AddressTable costs for the addresses of received packets. Each deserialized
+ * packet brings fresh address objects, so their first call of AddressTable::getId() goes through
+ * the synchronized table. This is compared with the plain virtual getHashValue() that has been
+ * used to hash the addresses before and with an address whose id is already cached. The last
+ * benchmark creates a new distinct address in each iteration that is dropped right away.
+ */
+
+const unsigned long NR_OF_ADDRESSES = 1000000;
+const unsigned int NR_OF_NODES = 64;
+
+int main(int argc, char** argv) {
+    std::vector<AddressPtr> nodes;
+    for (unsigned int i = 0; i < NR_OF_NODES; i++) {
+        nodes.push_back(AddressPtr(new AddressMock("node" + std::to_string(i))));
+        AddressTable::getId(nodes.back());
+    }
+    unsigned long checksum = 0;
+
+    benchmark("cached id", NR_OF_ADDRESSES, [&](unsigned long i) {
+        checksum += AddressTable::getId(nodes[i % NR_OF_NODES]);
+    });
+
+    benchmark("fresh address of a known node (getHashValue)", NR_OF_ADDRESSES, [&](unsigned long i) {
+        AddressPtr address (new AddressMock("node" + std::to_string(i % NR_OF_NODES)));
+        checksum += address->getHashValue();
+    });
+
+    benchmark("fresh address of a known node (getId)", NR_OF_ADDRESSES, [&](unsigned long i) {
+        AddressPtr address (new AddressMock("node" + std::to_string(i % NR_OF_NODES)));
+        checksum += AddressTable::getId(address);
+    });
+
+    benchmark("fresh address of a new node (getId)", NR_OF_ADDRESSES, [&](unsigned long i) {
+        AddressPtr address (new AddressMock("unknown" + std::to_string(i)));
+        checksum += AddressTable::getId(address);
+    });
+    std::printf("%-60s %12u\n", "interned addresses", AddressTable::size());
+
+    if (checksum == 0) {
+        // this is never true but keeps the compiler from optimizing the addresses away
+        std::printf("%lu\n", checksum);
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef BENCHMARK_H_
+#define BENCHMARK_H_
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace ARA {
+
+/**
+ * A minimal helper to time a piece of code in the benchmark programs.
+ * The given function is called once per iteration and the average time per
+ * call is printed to stdout.
+ */
+template<typename Function>
+double benchmark(const std::string& name, unsigned long nrOfIterations, Function function) {
+    auto start = std::chrono::high_resolution_clock::now();
+    for (unsigned long i = 0; i < nrOfIterations; i++) {
+        function(i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+
+    double nanoSeconds = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    double nanoSecondsPerIteration = nanoSeconds / nrOfIterations;
+    std::printf("%-60s %12.1f ns/op\n", name.c_str(), nanoSecondsPerIteration);
+    return nanoSecondsPerIteration;
+}
+
+} /* namespace ARA */
+
+#endif /* BENCHMARK_H_ */
@@ -0,0 +1,134 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "AbstractARAClient.h"
+#include "AbstractNetworkInterface.h"
+#include "BasicConfiguration.h"
+#include "RoutingTable.h"
+#include "PacketFactory.h"
+#include "ExponentialEvaporationPolicy.h"
+#include "LinearPathReinforcementPolicy.h"
+#include "BestPheromoneForwardingPolicy.h"
+#include "Environment.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/time/ClockMock.h"
+
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+/**
+ * Measures the throughput of AbstractARAClient::receivePacket(..) for DATA packets that are
+ * forwarded to one of the known destinations and for DATA packets that are directed to the
+ * client itself. Each packet is received from one of the neighbors, so the route back to its
+ * source is updated, the packet is checked for duplicates and then either forwarded (with the
+ * forwarding decision and the reinforcement of the route) or delivered. The network interface
+ * and the client discard all sent and delivered packets.
+ */
+
+const unsigned int NR_OF_NEIGHBORS = 16;
+const unsigned int NR_OF_DESTINATIONS = 64;
+const unsigned long NR_OF_PACKETS = 200000;
+const unsigned int NR_OF_ROUNDS = 5;
+
+class DiscardingNetworkInterface : public AbstractNetworkInterface {
+public:
+    DiscardingNetworkInterface(AbstractNetworkClient* client, AddressPtr localAddress, AddressPtr broadcastAddress) : AbstractNetworkInterface(client, localAddress, broadcastAddress) {}
+
+    void send(const Packet* packet, AddressPtr recipient) {
+        nrOfSentPackets++;
+        delete packet;
+    }
+
+    bool equals(NetworkInterface* otherInterface) {
+        return this == otherInterface;
+    }
+
+    unsigned long nrOfSentPackets = 0;
+};
+
+class BenchmarkClient : public AbstractARAClient {
+public:
+    BenchmarkClient(Configuration& configuration) : AbstractARAClient(configuration) {}
+
+    void deliverToSystem(const Packet* packet) {
+        nrOfDeliveredPackets++;
+        delete packet;
+    }
+
+    void packetNotDeliverable(const Packet* packet) {
+        delete packet;
+    }
+
+    RoutingTable* getRoutingTable() {
+        return routingTable;
+    }
+
+    PacketFactory* getPacketFactory() {
+        return packetFactory;
+    }
+
+    unsigned long nrOfDeliveredPackets = 0;
+};
+
+int main(int argc, char** argv) {
+    Environment::setClock(new ClockMock());
+
+    RoutingTable* routingTable = new RoutingTable();
+    BasicConfiguration configuration = BasicConfiguration(
+        routingTable,
+        new PacketFactory(15),
+        new ExponentialEvaporationPolicy(0.99f, 1000, 0.01f),
+        new LinearPathReinforcementPolicy(5),
+        new BestPheromoneForwardingPolicy(routingTable),
+        5
+    );
+    BenchmarkClient client = BenchmarkClient(configuration);
+    AddressPtr localAddress (new AddressMock("local"));
+    DiscardingNetworkInterface* interface = new DiscardingNetworkInterface(&client, localAddress, AddressPtr(new AddressMock("broadcast")));
+    client.addNetworkInterface(interface);
+
+    std::vector<AddressPtr> neighbors;
+    for (unsigned int i = 0; i < NR_OF_NEIGHBORS; i++) {
+        neighbors.push_back(AddressPtr(new AddressMock("neighbor" + std::to_string(i))));
+    }
+
+    std::vector<AddressPtr> sources;
+    std::vector<AddressPtr> destinations;
+    for (unsigned int i = 0; i < NR_OF_DESTINATIONS; i++) {
+        sources.push_back(AddressPtr(new AddressMock("source" + std::to_string(i))));
+        destinations.push_back(AddressPtr(new AddressMock("destination" + std::to_string(i))));
+        client.getRoutingTable()->update(destinations[i], neighbors[i % NR_OF_NEIGHBORS], interface, 10);
+        client.getRoutingTable()->update(destinations[i], neighbors[(i + 1) % NR_OF_NEIGHBORS], interface, 8);
+    }
+
+    PacketFactory* packetFactory = client.getPacketFactory();
+
+    unsigned int sequenceNumber = 0;
+    for (unsigned int round = 0; round < NR_OF_ROUNDS; round++) {
+        benchmark("receivePacket (forward DATA packet)", NR_OF_PACKETS, [&](unsigned long i) {
+            unsigned int flow = i % NR_OF_DESTINATIONS;
+            Packet* packet = packetFactory->makeDataPacket(sources[flow], destinations[flow], sequenceNumber++, "payload", 8);
+            packet->setSender(neighbors[(flow + NR_OF_NEIGHBORS / 2) % NR_OF_NEIGHBORS]);
+            client.receivePacket(packet, interface);
+        });
+
+        benchmark("receivePacket (deliver DATA packet)", NR_OF_PACKETS, [&](unsigned long i) {
+            unsigned int flow = i % NR_OF_DESTINATIONS;
+            Packet* packet = packetFactory->makeDataPacket(sources[flow], localAddress, sequenceNumber++, "payload", 8);
+            packet->setSender(neighbors[flow % NR_OF_NEIGHBORS]);
+            client.receivePacket(packet, interface);
+        });
+    }
+
+    if (interface->nrOfSentPackets + client.nrOfDeliveredPackets != 2 * NR_OF_PACKETS * NR_OF_ROUNDS) {
+        std::printf("Only %lu packets have been sent and %lu packets have been delivered\n", interface->nrOfSentPackets, client.nrOfDeliveredPackets);
+    }
+
+    delete interface;
+    Environment::setClock(nullptr);
+    return 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "EvaporationKernels.h"
+#include "LinearEvaporationPolicy.h"
+#include "ExponentialEvaporationPolicy.h"
+
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+/**
+ * Compares the scalar per-entry evaporation of each evaporation policy with the batch evaporation
+ * that evaporates a whole array of pheromone values at once. The batch evaporation is measured
+ * with each instruction set that is supported by this CPU.
+ */
+
+const unsigned int NR_OF_VALUES = 30000;
+const unsigned long NR_OF_SWEEPS = 2000;
+const int TIME_DIFFERENCE = 50;
+
+const char* getName(EvaporationKernels::InstructionSet instructionSet) {
+    switch (instructionSet) {
+        case EvaporationKernels::AVX2: return "AVX2";
+        case EvaporationKernels::SSE: return "SSE";
+        default: return "scalar";
+    }
+}
+
+/**
+ * Fills the values with pheromone values that stay above the thresholds of the policies for all sweeps.
+ */
+void fill(std::vector<float>& values) {
+    for (unsigned int i = 0; i < values.size(); i++) {
+        values[i] = 1e6f + (i % 100);
+    }
+}
+
+void runBenchmarks(std::string policyName, EvaporationPolicy& policy, int timeDifference) {
+    std::vector<float> values(NR_OF_VALUES);
+    std::string prefix = policyName + " (" + std::to_string(NR_OF_VALUES) + " values) ";
+
+    fill(values);
+    benchmark(prefix + "per-entry sweep", NR_OF_SWEEPS, [&](unsigned long) {
+        for (auto& value: values) {
+            value = policy.evaporate(value, timeDifference);
+        }
+    });
+
+    EvaporationKernels::InstructionSet supportedInstructionSet = EvaporationKernels::getSupportedInstructionSet();
+    for (int instructionSet = EvaporationKernels::SCALAR; instructionSet <= supportedInstructionSet; instructionSet++) {
+        EvaporationKernels::setInstructionSet((EvaporationKernels::InstructionSet) instructionSet);
+        fill(values);
+        benchmark(prefix + "batch sweep (" + getName(EvaporationKernels::getInstructionSet()) + ")", NR_OF_SWEEPS, [&](unsigned long) {
+            policy.evaporate(values.data(), values.size(), timeDifference);
+        });
+    }
+    EvaporationKernels::setInstructionSet(supportedInstructionSet);
+
+    float sum = 0;
+    for (auto& value: values) {
+        sum += value;
+    }
+    if (sum < 0) {
+        // this is never true but keeps the compiler from optimizing the sweeps away
+        std::printf("%f\n", sum);
+    }
+}
+
+int main(int argc, char** argv) {
+    LinearEvaporationPolicy linearPolicy(0.01f, 0.1f, 1000);
+    runBenchmarks("LinearEvaporationPolicy", linearPolicy, TIME_DIFFERENCE);
+
+    ExponentialEvaporationPolicy exponentialPolicy(0.9999f, 1000, 0.1f);
+    runBenchmarks("ExponentialEvaporationPolicy", exponentialPolicy, TIME_DIFFERENCE);
+    return 0;
+}
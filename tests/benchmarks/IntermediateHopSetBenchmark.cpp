@@ -0,0 +1,80 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "IntermediateHopSet.h"
+#include "testAPI/mocks/AddressMock.h"
+
+#include <cstdio>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace ARA;
+
+/**
+ * Measures how the known intermediate hops of a source are handled during a FANT flood: Each
+ * iteration starts a new route discovery (the set is cleared), registers the senders and previous
+ * hops of the ant packets that arrive from the neighbors and checks each of them for loops like
+ * AbstractARAClient::hasPreviousNodeBeenSeenBefore() does. This is done with an IntermediateHopSet
+ * and, for comparison, with the std::unordered_set that has been used before.
+ */
+
+const unsigned long NR_OF_ROUTE_DISCOVERIES = 1000000;
+const unsigned int NR_OF_SOURCES = 64;
+const unsigned int NR_OF_NODES = 1024;
+
+std::vector<AddressPtr> nodes;
+
+template<typename Set>
+void runBenchmark(const std::string& name, unsigned int nrOfHops, bool (*contains)(const Set&, AddressId), void (*insert)(Set&, const AddressPtr&)) {
+    std::vector<Set> sets(NR_OF_SOURCES);
+    unsigned long nrOfLoops = 0;
+
+    benchmark(name + " (" + std::to_string(nrOfHops) + " hops)", NR_OF_ROUTE_DISCOVERIES, [&](unsigned long i) {
+        Set& set = sets[i % NR_OF_SOURCES];
+        set.clear();
+        for (AddressId hop = 0; hop < nrOfHops; hop++) {
+            unsigned int sender = (i + hop * 7) % NR_OF_NODES;
+            if (contains(set, AddressTable::getId(nodes[sender]))) {
+                nrOfLoops++;
+            }
+            insert(set, nodes[sender]);
+            insert(set, nodes[sender + 1]);
+        }
+    });
+
+    if (nrOfLoops == NR_OF_ROUTE_DISCOVERIES * nrOfHops) {
+        // this is never true but keeps the compiler from optimizing the sets away
+        std::printf("%lu\n", nrOfLoops);
+    }
+}
+
+bool containsHop(const IntermediateHopSet& set, AddressId hop) {
+    return set.contains(hop);
+}
+
+bool containsHop(const std::unordered_set<AddressId>& set, AddressId hop) {
+    return set.find(hop) != set.end();
+}
+
+void insertHop(IntermediateHopSet& set, const AddressPtr& hop) {
+    set.insert(hop);
+}
+
+void insertHop(std::unordered_set<AddressId>& set, const AddressPtr& hop) {
+    set.insert(AddressTable::getId(hop));
+}
+
+int main(int argc, char** argv) {
+    for (unsigned int i = 0; i <= NR_OF_NODES; i++) {
+        nodes.push_back(AddressPtr(new AddressMock("node" + std::to_string(i))));
+    }
+
+    for (unsigned int nrOfHops : {2, 4, 8}) {
+        runBenchmark<IntermediateHopSet>("IntermediateHopSet", nrOfHops, containsHop, insertHop);
+        runBenchmark<std::unordered_set<AddressId>>("std::unordered_set", nrOfHops, containsHop, insertHop);
+    }
+    return 0;
+}
@@ -0,0 +1,72 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "PacketFactory.h"
+#include "PayloadBuffer.h"
+#include "Packet.h"
+#include "testAPI/mocks/AddressMock.h"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+using namespace ARA;
+
+/**
+ * Measures the creation, cloning and deletion of DATA packets with the payload sizes of the traffic
+ * profiles in simulations/: 20 bytes of the sensor nodes (static/traffic.xml), 512 bytes and
+ * 1280 bytes (the *_traffic.xml profiles). Each packet is cloned once per network interface like
+ * in AbstractNetworkClient::broadCast(). Payloads up to PayloadBuffer::INLINE_CAPACITY bytes are
+ * stored inline, the heap payloads are forced with PayloadBuffer::adopt() for comparison.
+ * Build it with PAYLOAD_INLINE_CAPACITY=20 (see the Makefile) to compare the inline capacity
+ * that exactly fits the sensor profile with the default one.
+ */
+
+const unsigned long NR_OF_PACKETS = 1000000;
+const unsigned int NR_OF_INTERFACES = 2;
+
+void runBenchmarks(PacketFactory& factory, const std::string& profile, unsigned int payloadSize) {
+    AddressPtr source (new AddressMock("source"));
+    AddressPtr destination (new AddressMock("destination"));
+    std::string payload = std::string(payloadSize, 'x');
+    std::string prefix = "DATA packet (" + profile + ", " + std::to_string(payloadSize) + " bytes) ";
+    unsigned long checksum = 0;
+
+    benchmark(prefix + "make and broadcast" + (payloadSize <= PayloadBuffer::INLINE_CAPACITY ? " (inline)" : " (shared)"), NR_OF_PACKETS, [&](unsigned long i) {
+        Packet* packet = factory.makeDataPacket(source, destination, i, payload.c_str(), payloadSize);
+        for (unsigned int j = 0; j < NR_OF_INTERFACES; j++) {
+            Packet* clone = factory.makeClone(packet);
+            checksum += clone->getPayload()[0];
+            delete clone;
+        }
+        delete packet;
+    });
+
+    benchmark(prefix + "make and broadcast (heap)", NR_OF_PACKETS, [&](unsigned long i) {
+        char* data = new char[payloadSize];
+        std::memcpy(data, payload.c_str(), payloadSize);
+        Packet* packet = factory.makeDataPacket(source, destination, i, PayloadBuffer::adopt(data, payloadSize));
+        for (unsigned int j = 0; j < NR_OF_INTERFACES; j++) {
+            Packet* clone = factory.makeClone(packet);
+            checksum += clone->getPayload()[0];
+            delete clone;
+        }
+        delete packet;
+    });
+
+    if (checksum == 0) {
+        // this is never true but keeps the compiler from optimizing the packets away
+        std::printf("%lu\n", checksum);
+    }
+}
+
+int main(int argc, char** argv) {
+    PacketFactory factory = PacketFactory(15);
+    std::printf("Inline payload capacity: %u bytes\n", PayloadBuffer::INLINE_CAPACITY);
+    runBenchmarks(factory, "sensor profile", 20);
+    runBenchmarks(factory, "512 byte profile", 512);
+    runBenchmarks(factory, "1280 byte profile", 1280);
+    return 0;
+}
@@ -0,0 +1,190 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "Benchmark.h"
+#include "RoutingTable.h"
+#include "FlatRoutingTable.h"
+#include "ConcurrentRoutingTable.h"
+#include "ExponentialEvaporationPolicy.h"
+#include "BestPheromoneForwardingPolicy.h"
+#include "StochasticForwardingPolicy.h"
+#include "Environment.h"
+#include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/time/ClockMock.h"
+#include "testAPI/mocks/time/TimeMock.h"
+
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+/**
+ * Compares the standard RoutingTable with the FlatRoutingTable on the operations that are
+ * on the hot path of the AbstractARAClient: Lookups, route selection for a packet (including
+ * the forwarding decisions of the BestPheromoneForwardingPolicy and the StochasticForwardingPolicy),
+ * pheromone reinforcement, removal of routes, dumping all entries and the evaporation sweep.
+ * The standard table is also measured with the lazy and the incremental evaporation.
+ */
+
+const unsigned int NR_OF_NEIGHBORS = 16;
+const unsigned int ROUTES_PER_DESTINATION = 3;
+const unsigned long NR_OF_OPERATIONS = 200000;
+
+void fill(RoutingTable* routingTable, std::vector<AddressPtr>& destinations, std::vector<AddressPtr>& neighbors, NetworkInterface* interface) {
+    for (unsigned int i = 0; i < destinations.size(); i++) {
+        for (unsigned int j = 0; j < ROUTES_PER_DESTINATION; j++) {
+            routingTable->update(destinations[i], neighbors[(i + j) % NR_OF_NEIGHBORS], interface, 10 + j);
+        }
+    }
+}
+
+void runBenchmarks(std::string tableName, RoutingTable* routingTable, unsigned int nrOfDestinations, NetworkInterface* interface) {
+    std::vector<AddressPtr> destinations;
+    std::vector<Packet*> packets;
+    for (unsigned int i = 0; i < nrOfDestinations; i++) {
+        std::string name = "destination" + std::to_string(i);
+        destinations.push_back(AddressPtr(new AddressMock(name)));
+        packets.push_back(new PacketMock("source", name.c_str(), "sender"));
+    }
+
+    std::vector<AddressPtr> neighbors;
+    for (unsigned int i = 0; i < NR_OF_NEIGHBORS; i++) {
+        neighbors.push_back(AddressPtr(new AddressMock("neighbor" + std::to_string(i))));
+    }
+
+    std::string prefix = tableName + " (" + std::to_string(nrOfDestinations) + " destinations) ";
+
+    benchmark(prefix + "fill", 1, [&](unsigned long) {
+        fill(routingTable, destinations, neighbors, interface);
+    });
+
+    float sum = 0;
+    benchmark(prefix + "getPheromoneValue", NR_OF_OPERATIONS, [&](unsigned long i) {
+        unsigned int destination = (i * 7919) % nrOfDestinations;
+        sum += routingTable->getPheromoneValue(destinations[destination], neighbors[destination % NR_OF_NEIGHBORS], interface);
+    });
+
+    benchmark(prefix + "isDeliverable", NR_OF_OPERATIONS, [&](unsigned long i) {
+        sum += routingTable->isDeliverable(packets[(i * 7919) % nrOfDestinations]);
+    });
+
+    benchmark(prefix + "getPossibleNextHops", NR_OF_OPERATIONS, [&](unsigned long i) {
+        sum += routingTable->getPossibleNextHops(packets[(i * 7919) % nrOfDestinations]).size();
+    });
+
+    BestPheromoneForwardingPolicy forwardingPolicy(routingTable);
+    benchmark(prefix + "forwarding decision", NR_OF_OPERATIONS, [&](unsigned long i) {
+        Packet* packet = packets[(i * 7919) % nrOfDestinations];
+        if (routingTable->isDeliverable(packet)) {
+            sum += forwardingPolicy.getNextHop(packet)->getInterface() != nullptr;
+        }
+    });
+
+    StochasticForwardingPolicy stochasticForwardingPolicy(routingTable);
+    benchmark(prefix + "stochastic forwarding decision", NR_OF_OPERATIONS, [&](unsigned long i) {
+        Packet* packet = packets[(i * 7919) % nrOfDestinations];
+        if (routingTable->isDeliverable(packet)) {
+            sum += stochasticForwardingPolicy.getNextHop(packet)->getInterface() != nullptr;
+        }
+    });
+
+    benchmark(prefix + "update (existing route)", NR_OF_OPERATIONS, [&](unsigned long i) {
+        unsigned int destination = (i * 7919) % nrOfDestinations;
+        routingTable->update(destinations[destination], neighbors[destination % NR_OF_NEIGHBORS], interface, 10 + (i % 5));
+    });
+
+    benchmark(prefix + "reinforce (getPheromoneValue + update)", NR_OF_OPERATIONS, [&](unsigned long i) {
+        unsigned int destination = (i * 7919) % nrOfDestinations;
+        float pheromoneValue = routingTable->getPheromoneValue(destinations[destination], neighbors[destination % NR_OF_NEIGHBORS], interface);
+        routingTable->update(destinations[destination], neighbors[destination % NR_OF_NEIGHBORS], interface, pheromoneValue + 0.001f);
+    });
+
+    benchmark(prefix + "reinforce (RouteHandle)", NR_OF_OPERATIONS, [&](unsigned long i) {
+        unsigned int destination = (i * 7919) % nrOfDestinations;
+        RouteHandle route = routingTable->findRoute(destinations[destination], neighbors[destination % NR_OF_NEIGHBORS], interface);
+        route.setPheromoneValue(route.getPheromoneValue() + 0.001f);
+    });
+
+    benchmark(prefix + "removeEntry + update", NR_OF_OPERATIONS, [&](unsigned long i) {
+        unsigned int destination = (i * 7919) % nrOfDestinations;
+        AddressPtr neighbor = neighbors[(destination + 1) % NR_OF_NEIGHBORS];
+        routingTable->removeEntry(destinations[destination], neighbor, interface);
+        routingTable->update(destinations[destination], neighbor, interface, 11);
+    });
+
+    if (nrOfDestinations <= 1000) {
+        // this is quadratic in the size of the table so we skip it for the large tables
+        benchmark(prefix + "dump (getEntryAt)", 1, [&](unsigned long) {
+            unsigned int nrOfEntries = routingTable->getTotalNumberOfEntries();
+            for (unsigned int i = 0; i < nrOfEntries; i++) {
+                sum += routingTable->getEntryAt(i).entry->getPheromoneValue();
+            }
+        });
+    }
+
+    benchmark(prefix + "dump (forEachEntry)", 1, [&](unsigned long) {
+        routingTable->forEachEntry([&](const AddressPtr& destination, RoutingTableEntry* entry) {
+            sum += entry->getPheromoneValue();
+        });
+    });
+
+    routingTable->triggerEvaporation();
+    benchmark(prefix + "evaporation sweep", 100, [&](unsigned long) {
+        TimeMock::letTimePass(100);
+        routingTable->triggerEvaporation();
+    });
+
+    if (sum < 0) {
+        // this is never true but keeps the compiler from optimizing the lookups away
+        std::printf("%f\n", sum);
+    }
+
+    for (auto& packet: packets) {
+        delete packet;
+    }
+}
+
+int main(int argc, char** argv) {
+    Environment::setClock(new ClockMock());
+    ARAClientMock client;
+    NetworkInterface* interface = client.createNewNetworkInterfaceMock();
+    ExponentialEvaporationPolicy evaporationPolicy(0.99f, 1000, 0.01f);
+
+    unsigned int sizes[] = {1000, 10000};
+    for (unsigned int nrOfDestinations : sizes) {
+        RoutingTable* standardTable = new RoutingTable();
+        standardTable->setEvaporationPolicy(&evaporationPolicy);
+        runBenchmarks("RoutingTable", standardTable, nrOfDestinations, interface);
+        delete standardTable;
+
+        RoutingTable* flatTable = new FlatRoutingTable();
+        flatTable->setEvaporationPolicy(&evaporationPolicy);
+        runBenchmarks("FlatRoutingTable", flatTable, nrOfDestinations, interface);
+        delete flatTable;
+
+        RoutingTable* concurrentTable = new ConcurrentRoutingTable();
+        concurrentTable->setEvaporationPolicy(&evaporationPolicy);
+        runBenchmarks("ConcurrentRoutingTable", concurrentTable, nrOfDestinations, interface);
+        delete concurrentTable;
+
+        RoutingTable* lazyTable = new RoutingTable();
+        lazyTable->setEvaporationPolicy(&evaporationPolicy);
+        lazyTable->setLazyEvaporation(true);
+        runBenchmarks("RoutingTable (lazy)", lazyTable, nrOfDestinations, interface);
+        delete lazyTable;
+
+        RoutingTable* incrementalTable = new RoutingTable();
+        incrementalTable->setEvaporationPolicy(&evaporationPolicy);
+        incrementalTable->setMaxNrOfBucketsPerEvaporation(8);
+        runBenchmarks("RoutingTable (incremental)", incrementalTable, nrOfDestinations, interface);
+        delete incrementalTable;
+        std::printf("\n");
+    }
+
+    Environment::setClock(nullptr);
+    return 0;
+}
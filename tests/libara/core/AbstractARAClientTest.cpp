@@ -13,6 +13,7 @@
 #include "Logger.h"
 #include "Environment.h"
 #include "TimerType.h"
+#include "SequenceNumberWindow.h"
 
 #include "testAPI/mocks/ARAClientMock.h"
 #include "testAPI/mocks/RoutingTableMock.h"
@@ -190,6 +191,60 @@ TEST(AbstractARAClientTest, sendPacketToNextHopIfRouteIsKnown) {
     CHECK_EQUAL(originalTTL, sentPacket->getTTL());
 }
 
+TEST(AbstractARAClientTest, packetsOfAFlowKeepTheirNextHopIfFlowCacheIsActivated) {
+    BasicConfiguration configuration = client->getStandardConfiguration();
+    configuration.setFlowCacheDwellTime(1000);
+    configuration.setFlowCachePheromoneShiftThreshold(0.5);
+    createNewClient(configuration);
+
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    PacketMock firstPacket = PacketMock("source", "destination", "sender", 1);
+    routingTable->update(firstPacket.getDestination(), nodeA, interface, 10);
+    routingTable->update(firstPacket.getDestination(), nodeB, interface, 5);
+
+    client->sendPacket(new PacketMock("source", "destination", "sender", 1));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeA));
+
+    // the route over B is now the best one but the flow stays on its route over A
+    routingTable->update(firstPacket.getDestination(), nodeB, interface, 30);
+    client->sendPacket(new PacketMock("source", "destination", "sender", 2));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeA));
+
+    // after the dwell time the next hop is chosen again
+    TimeMock::letTimePass(1000);
+    client->sendPacket(new PacketMock("source", "destination", "sender", 3));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeB));
+}
+
+TEST(AbstractARAClientTest, flowIsCachedAgainIfTheSameNextHopIsChosenAfterTheDwellTime) {
+    BasicConfiguration configuration = client->getStandardConfiguration();
+    configuration.setFlowCacheDwellTime(1000);
+    configuration.setFlowCachePheromoneShiftThreshold(0.5);
+    createNewClient(configuration);
+
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr destination (new AddressMock("destination"));
+    routingTable->update(destination, nodeA, interface, 10);
+    routingTable->update(destination, nodeB, interface, 5);
+
+    client->sendPacket(new PacketMock("source", "destination", "sender", 1));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeA));
+
+    // the dwell time has passed but A is still the best next hop
+    TimeMock::letTimePass(1000);
+    client->sendPacket(new PacketMock("source", "destination", "sender", 2));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeA));
+
+    // the new decision starts a new dwell time, so the flow stays on A
+    routingTable->update(destination, nodeB, interface, 30);
+    client->sendPacket(new PacketMock("source", "destination", "sender", 3));
+    CHECK(interface->getSentPackets()->back()->getRight()->equals(nodeA));
+}
+
 TEST(AbstractARAClientTest, getNumberOfNetworkInterfaces) {
     NetworkInterfaceMock interface1 = NetworkInterfaceMock(client);
     NetworkInterfaceMock interface2 = NetworkInterfaceMock(client);
@@ -282,6 +337,35 @@ TEST(AbstractARAClientTest, loopDetection) {
     CHECK_EQUAL(0, duplicateWarning->getPayloadLength());
 }
 
+/**
+ * In this test node A receives a DATA packet from (src) that is older than all sequence numbers
+ * A remembers for (src), e.g. because it has been trapped at (src) during a route discovery.
+ * A can not tell if this is a duplicate, so it must relay the packet instead of sending a
+ * duplicate warning. An ant packet that old is dropped because it might have been flooded before.
+ *
+ * (src)--->(A)--->(B)--->(dest)
+ */
+TEST(AbstractARAClientTest, outdatedDataPacketsAreNoDuplicates) {
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock("A");
+    AddressPtr source (new AddressMock("src"));
+    AddressPtr destination (new AddressMock("dest"));
+    AddressPtr nodeB (new AddressMock("B"));
+    unsigned int newSequenceNumber = SequenceNumberWindow::SIZE + 100;
+    routingTable->update(destination, nodeB, interface, 10.0);
+
+    client->receivePacket(new Packet(source, destination, source, PacketType::DATA, newSequenceNumber, 10), interface);
+    LONGS_EQUAL(1, interface->getNumberOfSentPackets());
+
+    client->receivePacket(new Packet(source, destination, source, PacketType::DATA, 1, 10), interface);
+    LONGS_EQUAL(2, interface->getNumberOfSentPackets());
+    const Packet* relayedPacket = interface->getSentPackets()->at(1)->getLeft();
+    CHECK(relayedPacket->getType() == PacketType::DATA);
+    LONGS_EQUAL(1, relayedPacket->getSequenceNumber());
+
+    client->receivePacket(new Packet(source, destination, source, PacketType::FANT, 2, 10), interface);
+    LONGS_EQUAL(2, interface->getNumberOfSentPackets());
+}
+
 /**
  * In this test we simulate that a FANT or a BANT have been received
  * twice at node x. This kind of duplication must simply be ignored
@@ -950,6 +1034,28 @@ TEST(AbstractARAClientTest, broadcastRouteFailureIfNoAlternativeRoutesAreKownOnR
     BYTES_EQUAL(maxNrOfHops, sentPacket->getTTL());
 }
 
+TEST(AbstractARAClientTest, broadcastRouteFailureIfLastRouteHasBeenEvicted) {
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock("sender");
+    SendPacketsList* sentPackets = interface->getSentPackets();
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr otherDestination (new AddressMock("otherDestination"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->setMaxNrOfEntries(1);
+
+    routingTable->update(destination, nextHop, interface, 10);
+    routingTable->update(otherDestination, nextHop, interface, 10);
+
+    // the first route has been evicted and is handled like a route failure
+    CHECK(routingTable->isDeliverable(destination) == false);
+    CHECK(routingTable->isDeliverable(otherDestination));
+    BYTES_EQUAL(1, sentPackets->size());
+    Pair<const Packet*, AddressPtr>* sentPacketInfo = sentPackets->front();
+    const Packet* sentPacket = sentPacketInfo->getLeft();
+    CHECK(interface->isBroadcastAddress(sentPacketInfo->getRight()));
+    CHECK(sentPacket->getType() == PacketType::ROUTE_FAILURE);
+    CHECK(sentPacket->getDestination()->equals(destination));
+}
+
 TEST(AbstractARAClientTest, clientsDeleteRoutingTableEntryWhenTheyReceiveRoutingFailurePacket) {
     NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock();
     AddressPtr source (new AddressMock("source"));
@@ -1271,7 +1377,7 @@ TEST(AbstractARAClientTest, clientWaitsBeforeSendingTheDATA) {
  */
 TEST(AbstractARAClientTest, routeFailurePacketIsCorrectlyProcessed) {
     ARAClientMock* nodeA = client;
-    ARAClientMock nodeB = ARAClientMock();
+    ARAClientMock nodeB;
     NetworkInterfaceMock* interfaceOfA = nodeA->createNewNetworkInterfaceMock("A");
     NetworkInterfaceMock* interfaceOfB = nodeB.createNewNetworkInterfaceMock("B");
     SendPacketsList* sentPacketsOfA = interfaceOfA->getSentPackets();
@@ -1757,6 +1863,45 @@ TEST(AbstractARAClientTest, deleteAllKnownRoutesViaNextHopwhenLinkIsBroken) {
     }
 }
 
+/**
+ * In this test we check if a client forgets about a neighbor once the link to it is broken,
+ * while it keeps the state of other sources that can still be reached.
+ *
+ * Test setup:                   | Description:
+ * (A)---(B)                     |   * We are testing from the perspective of (A)
+ *  └----(C)---(src)             |   * (A) has received packets from (B) and from (src) via (C)
+ *                               |   * (A) recognizes a link failure to (B)
+ *                               |   * (A) should have erased the state of (B) but not the one of (src)
+ */
+TEST(AbstractARAClientTest, stateOfANeighborIsErasedWhenTheLinkIsBroken) {
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock("A");
+    AddressPtr nodeA = interface->getLocalAddress();
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    AddressPtr source (new AddressMock("src"));
+    AddressPtr destination (new AddressMock("dest"));
+
+    client->receivePacket(new Packet(nodeB, nodeA, nodeB, PacketType::DATA, 1, 10), interface);
+    client->receivePacket(new Packet(source, nodeA, nodeC, PacketType::DATA, 1, 10), interface);
+    CHECK_TRUE(client->hasPeerState(nodeB));
+    CHECK_TRUE(client->hasPeerState(source));
+
+    Packet* somePacket = new Packet(nodeA, destination, nodeA, PacketType::DATA, 123, 10);
+    client->handleBrokenLink(somePacket, nodeB, interface);
+
+    CHECK_FALSE(client->hasPeerState(nodeB));
+    CHECK_TRUE(client->hasPeerState(source));
+
+    // a duplicate from (src) must still be recognized
+    Packet* duplicate = new Packet(source, nodeA, nodeC, PacketType::DATA, 1, 10);
+    CHECK_TRUE(client->hasBeenReceivedEarlier(duplicate));
+    delete duplicate;
+
+    for (auto& deliveredPacket: *client->getDeliveredPackets()) {
+        delete deliveredPacket;
+    }
+}
+
 /**
  * This test checks if a node sends a HELLO packet to all of its neighbors
  * which have not send or successfully received any packets lately.
@@ -1897,15 +2042,15 @@ TEST(AbstractARAClientTest, clientCanHandleHelloPacket) {
 TEST(AbstractARAClientTest, chainRouteFailuresIfCriticalLinkBroke) {
     NetworkInterfaceMock* interfaceOfSrc = client->createNewNetworkInterfaceMock("src");
 
-    ARAClientMock clientA = ARAClientMock();
+    ARAClientMock clientA;
     NetworkInterfaceMock* interfaceOfA = clientA.createNewNetworkInterfaceMock("A");
     SendPacketsList* sentPacketsOfA = interfaceOfA->getSentPackets();
 
-    ARAClientMock clientB = ARAClientMock();
+    ARAClientMock clientB;
     NetworkInterfaceMock* interfaceOfB = clientB.createNewNetworkInterfaceMock("B");
     SendPacketsList* sentPacketsOfB = interfaceOfB->getSentPackets();
 
-    ARAClientMock clientC = ARAClientMock();
+    ARAClientMock clientC;
     NetworkInterfaceMock* interfaceOfC = clientC.createNewNetworkInterfaceMock("C");
     SendPacketsList* sentPacketsOfC = interfaceOfC->getSentPackets();
 
@@ -0,0 +1,130 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "Address.h"
+#include "NoSuchElementException.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+
+#include <string>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(AddressTableTest) {};
+
+TEST(AddressTableTest, equalAddressesHaveTheSameId) {
+    AddressPtr address1 (new AddressMock("A"));
+    AddressPtr address2 (new AddressMock("A"));
+    AddressPtr address3 (new AddressMock("B"));
+
+    AddressId id = AddressTable::getId(address1);
+    CHECK_EQUAL(id, AddressTable::getId(address2));
+    CHECK(AddressTable::getId(address3) != id);
+
+    // the ids do not change when they are requested again
+    CHECK_EQUAL(id, AddressTable::getId(address1));
+}
+
+TEST(AddressTableTest, addressesAreReleasedIfNoAddressObjectRefersToThem) {
+    AddressTable::releaseUnusedAddresses();
+    unsigned int nrOfAddresses = AddressTable::size();
+
+    AddressPtr address1 (new AddressMock("released"));
+    AddressPtr address2 (new AddressMock("released"));
+    AddressId id = AddressTable::getId(address1);
+    AddressTable::getId(address2);
+    CHECK_EQUAL(nrOfAddresses + 1, AddressTable::size());
+
+    // the first address object is kept by the table but the second one still refers to the id
+    address1.reset();
+    AddressTable::releaseUnusedAddresses();
+    CHECK(AddressTable::getAddress(id)->equals(address2));
+
+    address2.reset();
+    AddressTable::releaseUnusedAddresses();
+    CHECK_EQUAL(nrOfAddresses, AddressTable::size());
+
+    // the ids are never reused
+    AddressPtr address3 (new AddressMock("released"));
+    CHECK(AddressTable::getId(address3) != id);
+}
+
+TEST(AddressTableTest, retainedAddressesAreKept) {
+    AddressPtr address (new AddressMock("retained"));
+    AddressId id = AddressTable::getId(address);
+    AddressTable::retain(id);
+
+    address.reset();
+    AddressTable::releaseUnusedAddresses();
+    CHECK(AddressTable::getAddress(id)->equals(AddressPtr(new AddressMock("retained"))));
+
+    AddressTable::release(id);
+    AddressTable::releaseUnusedAddresses();
+    try {
+        AddressTable::getAddress(id);
+        FAIL("An exception should have been thrown");
+    } catch (NoSuchElementException &exception) {
+        // this is expected
+    }
+}
+
+TEST(AddressTableTest, unusedAddressesAreCollectedByTheFollowingLookups) {
+    AddressTable::releaseUnusedAddresses();
+    unsigned int nrOfAddresses = AddressTable::size();
+
+    for (unsigned int i = 0; i < 1000; i++) {
+        AddressPtr address (new AddressMock("collected" + std::to_string(i)));
+        AddressTable::getId(address);
+    }
+    CHECK(AddressTable::size() <= nrOfAddresses + 2);
+}
+
+TEST(AddressTableTest, getAddress) {
+    AddressPtr address (new AddressMock("getAddress"));
+    AddressId id = AddressTable::getId(address);
+
+    AddressPtr internedAddress = AddressTable::getAddress(id);
+    CHECK(internedAddress->equals(address));
+}
+
+TEST(AddressTableTest, getAddressThrowsExceptionForUnknownIds) {
+    try {
+        AddressTable::getAddress(UNKNOWN_ADDRESS_ID);
+        FAIL("An exception should have been thrown");
+    } catch (NoSuchElementException &exception) {
+        // this is expected
+    }
+}
+
+TEST(AddressTableTest, assignedAddressesDoNotKeepTheirOldId) {
+    AddressMock* original = new AddressMock("original");
+    AddressPtr address (original);
+    AddressId originalId = AddressTable::getId(address);
+
+    *original = AddressMock("assigned");
+    CHECK(AddressTable::getId(address) != originalId);
+    CHECK_EQUAL(AddressTable::getId(AddressPtr(new AddressMock("assigned"))), AddressTable::getId(address));
+}
+
+TEST(AddressTableTest, addressHashAndPredicateUseTheIds) {
+    AddressPtr address1 (new AddressMock("A"));
+    AddressPtr address2 (new AddressMock("A"));
+    AddressPtr address3 (new AddressMock("B"));
+    AddressHash hash;
+    AddressPredicate predicate;
+
+    CHECK_EQUAL(AddressTable::getId(address1), hash(address1));
+    CHECK(predicate(address1, address2));
+    CHECK(predicate(address1, address3) == false);
+}
+
+TEST(AddressTableTest, packetIds) {
+    PacketMock packet = PacketMock("source", "destination", "sender", 1);
+    CHECK_EQUAL(AddressTable::getId(AddressPtr(new AddressMock("source"))), packet.getSourceId());
+    CHECK_EQUAL(AddressTable::getId(AddressPtr(new AddressMock("destination"))), packet.getDestinationId());
+    CHECK_EQUAL(AddressTable::getId(AddressPtr(new AddressMock("sender"))), packet.getSenderId());
+}
@@ -0,0 +1,93 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "BasicARAClient.h"
+#include "BasicConfiguration.h"
+#include "Exception.h"
+#include "PacketFactory.h"
+#include "StochasticForwardingPolicy.h"
+#include "testAPI/mocks/BasicARAClientMock.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(BasicARAClientTest) {
+    BasicARAClientMock* client;
+    RoutingTable* routingTable;
+
+    void setup() {
+        BasicConfiguration configuration = BasicARAClientMock::getStandardConfiguration();
+        client = new BasicARAClientMock(configuration);
+        routingTable = client->getRoutingTable();
+    }
+
+    void teardown() {
+        delete client;
+    }
+};
+
+TEST(BasicARAClientTest, sendPacketToBestNextHopAndReinforceRoute) {
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    Packet* packet = new PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet->getDestination();
+    routingTable->update(destination, nodeA, interface, 5);
+    routingTable->update(destination, nodeB, interface, 10);
+
+    client->sendPacket(packet);
+
+    BYTES_EQUAL(1, interface->getNumberOfSentPackets());
+    Pair<const Packet*, AddressPtr>* sentPacketInfo = interface->getSentPackets()->front();
+    CHECK(sentPacketInfo->getRight()->equals(nodeB));
+    CHECK(sentPacketInfo->getLeft()->getSender()->equals(interface->getLocalAddress()));
+    CHECK(sentPacketInfo->getLeft()->getPreviousHop()->equals(AddressPtr(new AddressMock("sender"))));
+
+    // the route has been reinforced by the LinearPathReinforcementPolicy (deltaPhi = 5)
+    CHECK_EQUAL(15, routingTable->getPheromoneValue(destination, nodeB, interface));
+    CHECK_EQUAL(5, routingTable->getPheromoneValue(destination, nodeA, interface));
+}
+
+TEST(BasicARAClientTest, undeliverablePacketsAreHandledLikeInTheAbstractARAClient) {
+    NetworkInterfaceMock* interface = client->createNewNetworkInterfaceMock();
+    PacketMock* packet = new PacketMock();
+    packet->setSource(interface->getLocalAddress());
+
+    CHECK_FALSE(routingTable->isDeliverable(packet));
+    client->sendPacket(packet);
+    CHECK(client->getPacketTrap()->contains(packet));
+}
+
+TEST(BasicARAClientTest, configurationMustMatchTheTypesOfTheClient) {
+    RoutingTable* otherRoutingTable = new RoutingTableMock();
+    BasicConfiguration configuration = BasicConfiguration(
+        otherRoutingTable,
+        new PacketFactory(15),
+        new ExponentialEvaporationPolicyMock(),
+        new LinearPathReinforcementPolicy(5),
+        new StochasticForwardingPolicy(otherRoutingTable),
+        5
+    );
+
+    try {
+        BasicARAClientMock otherClient (configuration);
+        FAIL("Should have thrown an exception (the forwarding policy is no BestPheromoneForwardingPolicy)");
+    } catch(Exception &exception) {
+        STRCMP_EQUAL("The forwarding policy does not match the type of the BasicARAClient", exception.getMessage());
+    }
+
+    ForwardingPolicy* otherForwardingPolicy = new StochasticForwardingPolicy(routingTable);
+    try {
+        client->setForwardingPolicy(otherForwardingPolicy);
+        FAIL("Should have thrown an exception (the forwarding policy is no BestPheromoneForwardingPolicy)");
+    } catch(Exception &exception) {
+        STRCMP_EQUAL("The forwarding policy does not match the type of the BasicARAClient", exception.getMessage());
+    }
+    delete otherForwardingPolicy;
+}
@@ -0,0 +1,399 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "ConcurrentRoutingTable.h"
+#include "RoutingTableEntry.h"
+#include "Exception.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/ExponentialEvaporationPolicyMock.h"
+#include "testAPI/mocks/BatchCountingEvaporationPolicyMock.h"
+#include "testAPI/mocks/time/TimeMock.h"
+#include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/RouteEvictionListenerMock.h"
+
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(ConcurrentRoutingTableTest) {
+    ARAClientMock* client;
+    ConcurrentRoutingTable* routingTable;
+    ExponentialEvaporationPolicyMock* evaporationPolicy;
+    NetworkInterfaceMock* interface;
+
+    void setup() {
+        client = new ARAClientMock();
+        evaporationPolicy = (ExponentialEvaporationPolicyMock*) client->getRoutingTable()->getEvaporationPolicy();
+        routingTable = new ConcurrentRoutingTable();
+        routingTable->setEvaporationPolicy(evaporationPolicy);
+        interface = client->createNewNetworkInterfaceMock();
+    }
+
+    void teardown() {
+        delete routingTable;
+        delete client;
+    }
+};
+
+TEST(ConcurrentRoutingTableTest, updateAndGetPheromoneValue) {
+    PacketMock packet = PacketMock();
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nextHop (new AddressMock("nextHop"));
+
+    CHECK(routingTable->isDeliverable(&packet) == false);
+    routingTable->update(destination, nextHop, interface, 1.5);
+
+    CHECK(routingTable->isDeliverable(&packet));
+    CHECK(routingTable->exists(destination, nextHop, interface));
+    CHECK_EQUAL(1.5, routingTable->getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+
+    // an update of an existing route overwrites the pheromone value
+    routingTable->update(destination, new RoutingTableEntry(nextHop, interface, 3.5));
+    CHECK_EQUAL(3.5, routingTable->getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+
+    std::deque<RoutingTableEntry*> nextHops = routingTable->getPossibleNextHops(&packet);
+    CHECK_EQUAL(1, nextHops.size());
+    CHECK(nextHops.front()->getAddress()->equals(nextHop));
+    CHECK_EQUAL(interface, nextHops.front()->getNetworkInterface());
+}
+
+TEST(ConcurrentRoutingTableTest, manyDestinations) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    unsigned int nrOfDestinations = 1000;
+
+    for (unsigned int i = 0; i < nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, i + 1);
+    }
+    CHECK_EQUAL(nrOfDestinations, routingTable->getTotalNumberOfEntries());
+
+    // remove every second destination
+    for (unsigned int i = 0; i < nrOfDestinations; i += 2) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        CHECK_TRUE(routingTable->removeEntry(destination, nextHop, interface));
+    }
+    CHECK_EQUAL(nrOfDestinations / 2, routingTable->getTotalNumberOfEntries());
+
+    // add some new destinations so the directory is rebuilt without the removed ones
+    for (unsigned int i = nrOfDestinations; i < 2 * nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, i + 1);
+    }
+
+    for (unsigned int i = 0; i < 2 * nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        if (i < nrOfDestinations && i % 2 == 0) {
+            CHECK(routingTable->isDeliverable(destination) == false);
+        }
+        else {
+            CHECK_EQUAL(i + 1, routingTable->getPheromoneValue(destination, nextHop, interface));
+        }
+    }
+}
+
+TEST(ConcurrentRoutingTableTest, nextHopCandidatesStayValidWhileTheTableIsModified) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    routingTable->update(destination, nodeA, interface, 1);
+    routingTable->update(destination, nodeB, interface, 2);
+
+    {
+        NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+        routingTable->removeEntry(destination, nodeA, interface);
+        routingTable->update(destination, nodeB, interface, 5);
+        routingTable->update(destination, nodeB, interface, 6);
+
+        // the view still shows the routes at the time it has been created
+        BYTES_EQUAL(2, candidates.size());
+        float sumOfPheromoneValues = 0;
+        for (auto entry: candidates) {
+            sumOfPheromoneValues += entry->getPheromoneValue();
+        }
+        CHECK_EQUAL(3, sumOfPheromoneValues);
+    }
+
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    BYTES_EQUAL(1, candidates.size());
+    CHECK_EQUAL(6, (*candidates.begin())->getPheromoneValue());
+}
+
+TEST(ConcurrentRoutingTableTest, reinforceRouteViaHandle) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+
+    RouteHandle route = routingTable->findRoute(destination, nextHop, interface);
+    CHECK_FALSE(route.exists());
+    route.setPheromoneValue(2);
+    CHECK_TRUE(route.exists());
+
+    // another writer modifies the destination in the meantime
+    routingTable->update(destination, AddressPtr(new AddressMock("other")), interface, 1);
+    CHECK_EQUAL(2, route.getPheromoneValue());
+    route.setPheromoneValue(route.getPheromoneValue() + 1);
+
+    CHECK_EQUAL(3, routingTable->getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(2, routingTable->getTotalNumberOfEntries());
+}
+
+TEST(ConcurrentRoutingTableTest, existingRoutesAreUpdatedInPlace) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->update(destination, nextHop, interface, 1);
+    RoutingTableEntry* entry = routingTable->findRoute(destination, nextHop, interface).getEntry();
+
+    // neither a reinforcement nor an evaporation without any removed route copies the routes
+    routingTable->update(destination, nextHop, interface, 4);
+    RouteHandle route = routingTable->findRoute(destination, nextHop, interface);
+    route.setPheromoneValue(5);
+    routingTable->triggerEvaporation();
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    CHECK(routingTable->findRoute(destination, nextHop, interface).getEntry() == entry);
+    DOUBLES_EQUAL(5 * evaporationPolicy->getEvaporationFactor(), entry->getPheromoneValue(), 0.00001);
+
+    // a new route is added to a copy
+    routingTable->update(destination, AddressPtr(new AddressMock("other")), interface, 1);
+    CHECK(routingTable->findRoute(destination, nextHop, interface).getEntry() != entry);
+}
+
+TEST(ConcurrentRoutingTableTest, evaporationRemovesEntries) {
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+
+    routingTable->update(destination1, nextHopA, interface, 0.6);
+    routingTable->update(destination1, nextHopB, interface, 10);
+    routingTable->update(destination2, nextHopA, interface, 0.6);
+
+    // the first call only initializes the evaporation time
+    routingTable->triggerEvaporation();
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    CHECK(routingTable->exists(destination1, nextHopA, interface) == false);
+    DOUBLES_EQUAL(10 * evaporationFactor, routingTable->getPheromoneValue(destination1, nextHopB, interface), 0.00001);
+    CHECK(routingTable->isDeliverable(destination2) == false);
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nextHopA).empty());
+    CHECK_EQUAL(1, routingTable->getAllRoutesThatLeadOver(nextHopB).size());
+}
+
+TEST(ConcurrentRoutingTableTest, incrementalEvaporationReachesTheSameValuesAsTheFullSweep) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->setMaxNrOfBucketsPerEvaporation(3);
+
+    routingTable->triggerEvaporation();
+    for (int i = 0; i < 20; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, 10);
+    }
+    AddressPtr youngerDestination (new AddressMock("younger"));
+
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+    routingTable->update(youngerDestination, nextHop, interface, 10);
+    for (int i = 0; i < 100; i++) {
+        routingTable->triggerEvaporation();
+    }
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    for (int i = 0; i < 20; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        DOUBLES_EQUAL(10 * evaporationFactor, routingTable->getPheromoneValue(destination, nextHop, interface), 0.00001);
+    }
+    DOUBLES_EQUAL(10, routingTable->getPheromoneValue(youngerDestination, nextHop, interface), 0.00001);
+}
+
+TEST(ConcurrentRoutingTableTest, iterateOverAllEntries) {
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+
+    CHECK(routingTable->begin() == routingTable->end());
+
+    unsigned int nrOfDestinations = 10;
+    for (unsigned int i = 0; i < nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        routingTable->update(destination, nextHopA, interface, 1);
+        routingTable->update(destination, nextHopB, interface, 2);
+    }
+
+    int position = 0;
+    for (RoutingTable::const_iterator iterator = routingTable->begin(); iterator != routingTable->end(); ++iterator) {
+        RoutingTableEntryTupel expectedTupel = routingTable->getEntryAt(position);
+        CHECK((*iterator).entry == expectedTupel.entry);
+        position++;
+    }
+    CHECK_EQUAL(2 * nrOfDestinations, position);
+
+    float sumOfPheromoneValues = 0;
+    routingTable->forEachEntry([&](const AddressPtr& destination, RoutingTableEntry* entry) {
+        sumOfPheromoneValues += entry->getPheromoneValue();
+    });
+    CHECK_EQUAL(3 * nrOfDestinations, sumOfPheromoneValues);
+
+    try {
+        routingTable->getEntryAt(2 * nrOfDestinations);
+        FAIL("Should have thrown an exception (index out of bounds)");
+    } catch(Exception &exception) {
+        STRCMP_EQUAL("ConcurrentRoutingTable::getEntryAt: Index out of bounds", exception.getMessage());
+    }
+}
+
+TEST(ConcurrentRoutingTableTest, readersRunConcurrentlyToWriters) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    unsigned int nrOfNextHops = 8;
+    std::vector<AddressPtr> nextHops;
+    for (unsigned int i = 0; i < nrOfNextHops; i++) {
+        nextHops.push_back(AddressPtr(new AddressMock("nextHop" + std::to_string(i))));
+    }
+
+    std::atomic<bool> isWriterDone(false);
+    std::atomic<unsigned int> nrOfInvalidReads(0);
+    auto reader = [&]() {
+        while (isWriterDone.load() == false) {
+            // all routes are written with pheromone values between 1 and 2
+            for (auto entry: routingTable->getNextHopCandidates(&packet)) {
+                float pheromoneValue = entry->getPheromoneValue();
+                if (pheromoneValue < 1 || pheromoneValue > 2) {
+                    nrOfInvalidReads++;
+                }
+            }
+        }
+    };
+
+    std::thread firstReader(reader);
+    std::thread secondReader(reader);
+    for (unsigned int i = 0; i < 20000; i++) {
+        AddressPtr nextHop = nextHops[i % nrOfNextHops];
+        if (i % 3 == 1) {
+            routingTable->removeEntry(destination, nextHop, interface);
+        }
+        else {
+            routingTable->update(destination, nextHop, interface, 1 + (i % 100) / 100.0f);
+        }
+    }
+    isWriterDone.store(true);
+    firstReader.join();
+    secondReader.join();
+
+    BYTES_EQUAL(0, nrOfInvalidReads.load());
+}
+
+TEST(ConcurrentRoutingTableTest, leastRecentlyUpdatedRouteIsEvictedIfTableIsFull) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+    AddressPtr destination3 (new AddressMock("3"));
+    AddressPtr destination4 (new AddressMock("4"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setPheromoneAwareEviction(false);
+    routingTable->setMaxNrOfEntries(3);
+
+    routingTable->update(destination1, nextHop, interface, 1);
+    routingTable->update(destination2, nextHop, interface, 2);
+    routingTable->update(destination3, nextHop, interface, 3);
+    routingTable->update(destination1, nextHop, interface, 5);
+    CHECK(listener.evictedDestinations.empty());
+
+    routingTable->update(destination4, nextHop, interface, 4);
+    CHECK_EQUAL(3, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->isDeliverable(destination2) == false);
+    CHECK(routingTable->exists(destination1, nextHop, interface));
+    CHECK(routingTable->exists(destination3, nextHop, interface));
+    CHECK(routingTable->exists(destination4, nextHop, interface));
+    BYTES_EQUAL(1, listener.evictedDestinations.size());
+    CHECK(listener.evictedDestinations.front()->equals(destination2));
+}
+
+TEST(ConcurrentRoutingTableTest, routeWithLowestPheromoneValueIsEvictedIfTableIsFull) {
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setMaxNrOfEntries(2);
+
+    routingTable->update(destination, nodeA, interface, 10);
+    RouteHandle route = routingTable->findRoute(destination, nodeB, interface);
+    route.setPheromoneValue(1);
+    route = routingTable->findRoute(destination, nodeC, interface);
+    route.setPheromoneValue(5);
+
+    CHECK_EQUAL(2, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->exists(destination, nodeA, interface));
+    CHECK(routingTable->exists(destination, nodeB, interface) == false);
+    CHECK_EQUAL(5, routingTable->getPheromoneValue(destination, nodeC, interface));
+    BYTES_EQUAL(1, listener.evictedNextHops.size());
+    CHECK(listener.evictedNextHops.front()->equals(nodeB));
+}
+
+TEST(ConcurrentRoutingTableTest, removedRoutesAreNotEvicted) {
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setPheromoneAwareEviction(false);
+    routingTable->setMaxNrOfEntries(4);
+
+    // the table never grows beyond its limit, no matter how often its routes are removed or replaced
+    std::deque<AddressPtr> destinations;
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    for (unsigned int i = 0; i < 40; i++) {
+        destinations.push_back(AddressPtr(new AddressMock(std::to_string(i))));
+        routingTable->update(destinations.back(), nextHop, interface, 1);
+        if (i % 3 == 1) {
+            routingTable->removeEntry(destinations.back(), nextHop, interface);
+        }
+        CHECK(routingTable->getTotalNumberOfEntries() <= 4);
+    }
+
+    for (auto& destination: listener.evictedDestinations) {
+        unsigned int i = std::stoi(destination->toString());
+        CHECK(i % 3 != 1);
+    }
+    CHECK_EQUAL(4, routingTable->getTotalNumberOfEntries());
+    CHECK_EQUAL(40 - 13 - 4, listener.evictedDestinations.size());
+}
+
+TEST(ConcurrentRoutingTableTest, allRoutesAreEvaporatedInOneBatch) {
+    BatchCountingEvaporationPolicyMock batchCountingPolicy;
+    ConcurrentRoutingTable table;
+    table.setEvaporationPolicy(&batchCountingPolicy);
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    table.update(nodeA, nodeB, interface, 2);
+    table.update(nodeA, nodeC, interface, 0.6);
+    table.update(nodeB, nodeC, interface, 4);
+    table.update(nodeC, nodeA, interface, 0.6);
+    table.triggerEvaporation();
+
+    TimeMock::letTimePass(batchCountingPolicy.getTimeInterval());
+    table.triggerEvaporation();
+    BYTES_EQUAL(1, batchCountingPolicy.nrOfBatches);
+    BYTES_EQUAL(4, batchCountingPolicy.nrOfBatchedValues);
+
+    // the values are written back to the right routes
+    BYTES_EQUAL(2, table.getTotalNumberOfEntries());
+    DOUBLES_EQUAL(2 * batchCountingPolicy.getEvaporationFactor(), table.getPheromoneValue(nodeA, nodeB, interface), 0.00001);
+    DOUBLES_EQUAL(4 * batchCountingPolicy.getEvaporationFactor(), table.getPheromoneValue(nodeB, nodeC, interface), 0.00001);
+    CHECK_FALSE(table.isDeliverable(nodeC));
+}
@@ -0,0 +1,94 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "EpochManager.h"
+#include "EpochGuard.h"
+
+using namespace ARA;
+
+/**
+ * Counts how many of its instances have been deleted.
+ */
+class RetiredObjectMock {
+    public:
+        RetiredObjectMock(int* nrOfDeletedObjects) {
+            this->nrOfDeletedObjects = nrOfDeletedObjects;
+        }
+
+        ~RetiredObjectMock() {
+            (*nrOfDeletedObjects)++;
+        }
+
+    private:
+        int* nrOfDeletedObjects;
+};
+
+TEST_GROUP(EpochManagerTest) {};
+
+TEST(EpochManagerTest, retiredObjectsAreDeletedAfterTwoEpochs) {
+    EpochManager epochManager;
+    int nrOfDeletedObjects = 0;
+
+    epochManager.retire(new RetiredObjectMock(&nrOfDeletedObjects));
+    CHECK_TRUE(epochManager.reclaim());
+    BYTES_EQUAL(0, nrOfDeletedObjects);
+    BYTES_EQUAL(1, epochManager.getNrOfRetiredObjects());
+
+    CHECK_TRUE(epochManager.reclaim());
+    BYTES_EQUAL(1, nrOfDeletedObjects);
+    BYTES_EQUAL(0, epochManager.getNrOfRetiredObjects());
+    BYTES_EQUAL(2, epochManager.getCurrentEpoch());
+}
+
+TEST(EpochManagerTest, activeReaderBlocksTheReclamation) {
+    EpochManager epochManager;
+    int nrOfDeletedObjects = 0;
+
+    {
+        EpochGuard guard(&epochManager);
+        CHECK_TRUE(guard.isActive());
+        epochManager.retire(new RetiredObjectMock(&nrOfDeletedObjects));
+
+        // the epoch can be advanced once but not a second time while the reader is still active
+        CHECK_TRUE(epochManager.reclaim());
+        CHECK_FALSE(epochManager.reclaim());
+        CHECK_FALSE(epochManager.reclaim());
+        BYTES_EQUAL(0, nrOfDeletedObjects);
+
+        // a copy of the guard stays in the old epoch
+        EpochGuard copiedGuard = guard;
+        CHECK_FALSE(epochManager.reclaim());
+    }
+
+    CHECK_TRUE(epochManager.reclaim());
+    BYTES_EQUAL(1, nrOfDeletedObjects);
+}
+
+TEST(EpochManagerTest, movedGuardKeepsTheEpoch) {
+    EpochManager epochManager;
+    EpochGuard movedGuard;
+    CHECK_FALSE(movedGuard.isActive());
+
+    {
+        EpochGuard guard(&epochManager);
+        movedGuard = std::move(guard);
+        CHECK_FALSE(guard.isActive());
+    }
+
+    CHECK_TRUE(movedGuard.isActive());
+    CHECK_TRUE(epochManager.reclaim());
+    CHECK_FALSE(epochManager.reclaim());
+}
+
+TEST(EpochManagerTest, remainingObjectsAreDeletedWithTheManager) {
+    int nrOfDeletedObjects = 0;
+    {
+        EpochManager epochManager;
+        epochManager.retire(new RetiredObjectMock(&nrOfDeletedObjects));
+        epochManager.reclaim();
+        epochManager.retire(new RetiredObjectMock(&nrOfDeletedObjects));
+    }
+    BYTES_EQUAL(2, nrOfDeletedObjects);
+}
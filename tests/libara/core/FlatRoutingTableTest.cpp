@@ -0,0 +1,453 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "FlatRoutingTable.h"
+#include "RoutingTableEntry.h"
+#include "Exception.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/ExponentialEvaporationPolicyMock.h"
+#include "testAPI/mocks/time/TimeMock.h"
+#include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/RouteEvictionListenerMock.h"
+
+#include <deque>
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+/**
+ * A FlatRoutingTable that reveals the home slots of the destinations so we can test the collision handling.
+ */
+class CollisionInspectingRoutingTable : public FlatRoutingTable {
+    public:
+        using FlatRoutingTable::getHomeSlot;
+};
+
+TEST_GROUP(FlatRoutingTableTest) {
+    ARAClientMock* client;
+    CollisionInspectingRoutingTable* routingTable;
+    ExponentialEvaporationPolicyMock* evaporationPolicy;
+    NetworkInterfaceMock* interface;
+
+    void setup() {
+        client = new ARAClientMock();
+        evaporationPolicy = (ExponentialEvaporationPolicyMock*) client->getRoutingTable()->getEvaporationPolicy();
+        routingTable = new CollisionInspectingRoutingTable();
+        routingTable->setEvaporationPolicy(evaporationPolicy);
+        interface = client->createNewNetworkInterfaceMock();
+    }
+
+    void teardown() {
+        delete routingTable;
+        delete client;
+    }
+
+    /**
+     * Creates destinations that all share the same home slot with the current capacity of the table.
+     * The home slot depends on the id of an address, so we simply skip all addresses that land elsewhere.
+     */
+    std::vector<AddressPtr> createCollidingDestinations(unsigned int nrOfDestinations) {
+        std::vector<AddressPtr> destinations;
+        destinations.push_back(AddressPtr(new AddressMock("colliding0")));
+        size_t homeSlot = routingTable->getHomeSlot(destinations.front());
+
+        for (unsigned int i = 1; destinations.size() < nrOfDestinations; i++) {
+            AddressPtr destination (new AddressMock("colliding" + std::to_string(i)));
+            if (routingTable->getHomeSlot(destination) == homeSlot) {
+                destinations.push_back(destination);
+            }
+        }
+        return destinations;
+    }
+};
+
+TEST(FlatRoutingTableTest, updateAndGetPheromoneValue) {
+    PacketMock packet = PacketMock();
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nextHop (new AddressMock("nextHop"));
+
+    CHECK(routingTable->isDeliverable(&packet) == false);
+    routingTable->update(destination, nextHop, interface, 1.5);
+
+    CHECK(routingTable->isDeliverable(&packet));
+    CHECK(routingTable->exists(destination, nextHop, interface));
+    CHECK_EQUAL(1.5, routingTable->getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+
+    // an update of an existing route overwrites the pheromone value
+    routingTable->update(destination, nextHop, interface, 3.5);
+    CHECK_EQUAL(3.5, routingTable->getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+
+    std::deque<RoutingTableEntry*> nextHops = routingTable->getPossibleNextHops(&packet);
+    CHECK_EQUAL(1, nextHops.size());
+    CHECK(nextHops.front()->getAddress()->equals(nextHop));
+    CHECK_EQUAL(interface, nextHops.front()->getNetworkInterface());
+}
+
+TEST(FlatRoutingTableTest, updateWithEntryObject) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+
+    routingTable->update(destination, new RoutingTableEntry(nextHop, interface, 2));
+    routingTable->update(destination, new RoutingTableEntry(nextHop, interface, 4));
+
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+    CHECK_EQUAL(4, routingTable->getPheromoneValue(destination, nextHop, interface));
+}
+
+TEST(FlatRoutingTableTest, routesSpillOverTheInlineCapacity) {
+    AddressPtr destination (new AddressMock("Destination"));
+    unsigned int nrOfRoutes = FlatRoutingTable::INLINE_ROUTES * 3;
+
+    for (unsigned int i = 0; i < nrOfRoutes; i++) {
+        AddressPtr nextHop (new AddressMock(std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, i + 1);
+    }
+
+    CHECK_EQUAL(nrOfRoutes, routingTable->getTotalNumberOfEntries());
+    std::deque<RoutingTableEntry*> nextHops = routingTable->getPossibleNextHops(destination);
+    CHECK_EQUAL(nrOfRoutes, nextHops.size());
+
+    // the routes keep the order in which they have been added
+    for (unsigned int i = 0; i < nrOfRoutes; i++) {
+        AddressPtr nextHop (new AddressMock(std::to_string(i)));
+        CHECK(nextHops.at(i)->getAddress()->equals(nextHop));
+        CHECK_EQUAL(i + 1, nextHops.at(i)->getPheromoneValue());
+    }
+
+    // remove a route from the middle
+    AddressPtr removedHop (new AddressMock("1"));
+    routingTable->removeEntry(destination, removedHop, interface);
+    CHECK(routingTable->exists(destination, removedHop, interface) == false);
+    CHECK_EQUAL(nrOfRoutes - 1, routingTable->getTotalNumberOfEntries());
+    nextHops = routingTable->getPossibleNextHops(destination);
+    CHECK(nextHops.at(1)->getAddress()->equals(AddressPtr(new AddressMock("2"))));
+}
+
+TEST(FlatRoutingTableTest, manyDestinations) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    unsigned int nrOfDestinations = 1000;
+
+    for (unsigned int i = 0; i < nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, i + 1);
+    }
+    CHECK_EQUAL(nrOfDestinations, routingTable->getTotalNumberOfEntries());
+
+    // remove every second destination
+    for (unsigned int i = 0; i < nrOfDestinations; i += 2) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        routingTable->removeEntry(destination, nextHop, interface);
+    }
+    CHECK_EQUAL(nrOfDestinations / 2, routingTable->getTotalNumberOfEntries());
+
+    for (unsigned int i = 0; i < nrOfDestinations; i++) {
+        AddressPtr destination (new AddressMock("D" + std::to_string(i)));
+        if (i % 2 == 0) {
+            CHECK(routingTable->isDeliverable(destination) == false);
+        }
+        else {
+            CHECK_EQUAL(i + 1, routingTable->getPheromoneValue(destination, nextHop, interface));
+        }
+    }
+}
+
+TEST(FlatRoutingTableTest, removeEntryKeepsCollidingDestinationsReachable) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    std::vector<AddressPtr> destinations = createCollidingDestinations(3);
+    AddressPtr destinationA = destinations[0];
+    AddressPtr destinationB = destinations[1];
+    AddressPtr destinationC = destinations[2];
+
+    routingTable->update(destinationA, nextHop, interface, 1);
+    routingTable->update(destinationB, nextHop, interface, 2);
+    routingTable->update(destinationC, nextHop, interface, 3);
+    BYTES_EQUAL(routingTable->getHomeSlot(destinationA), routingTable->getHomeSlot(destinationB));
+    BYTES_EQUAL(routingTable->getHomeSlot(destinationA), routingTable->getHomeSlot(destinationC));
+
+    // A is the head of the probe sequence and B and C must still be found after it has been removed
+    routingTable->removeEntry(destinationA, nextHop, interface);
+    CHECK(routingTable->isDeliverable(destinationA) == false);
+    CHECK_EQUAL(2, routingTable->getPheromoneValue(destinationB, nextHop, interface));
+    CHECK_EQUAL(3, routingTable->getPheromoneValue(destinationC, nextHop, interface));
+
+    routingTable->removeEntry(destinationC, nextHop, interface);
+    CHECK(routingTable->isDeliverable(destinationB));
+    CHECK(routingTable->isDeliverable(destinationC) == false);
+    CHECK_EQUAL(1, routingTable->getTotalNumberOfEntries());
+}
+
+TEST(FlatRoutingTableTest, doNotReturnSourceOrSenderOfAPacketAsPossibleNextHop) {
+    PacketMock packet = PacketMock("source", "destination", "sender", 123, 10);
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+
+    routingTable->update(destination, packet.getSource(), interface, 10);
+    routingTable->update(destination, packet.getSender(), interface, 10);
+    CHECK(routingTable->isDeliverable(&packet) == false);
+    CHECK(routingTable->getPossibleNextHops(&packet).empty());
+
+    routingTable->update(destination, nodeA, interface, 10);
+    CHECK(routingTable->isDeliverable(&packet));
+    std::deque<RoutingTableEntry*> nextHops = routingTable->getPossibleNextHops(&packet);
+    CHECK_EQUAL(1, nextHops.size());
+    CHECK(nextHops.front()->getAddress()->equals(nodeA));
+}
+
+TEST(FlatRoutingTableTest, evaporationRemovesEntries) {
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+    std::vector<AddressPtr> destinations = createCollidingDestinations(3);
+    AddressPtr destination1 = destinations[0];
+    AddressPtr destination2 = destinations[1];
+    AddressPtr destination3 = destinations[2];
+
+    routingTable->update(destination1, nextHopA, interface, 0.6);
+    routingTable->update(destination1, nextHopB, interface, 10);
+    routingTable->update(destination2, nextHopA, interface, 0.6);
+    routingTable->update(destination3, nextHopA, interface, 10);
+    BYTES_EQUAL(routingTable->getHomeSlot(destination1), routingTable->getHomeSlot(destination3));
+
+    // the first call only initializes the evaporation time
+    routingTable->triggerEvaporation();
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    CHECK(routingTable->exists(destination1, nextHopA, interface) == false);
+    DOUBLES_EQUAL(10 * evaporationFactor, routingTable->getPheromoneValue(destination1, nextHopB, interface), 0.00001);
+    CHECK(routingTable->isDeliverable(destination2) == false);
+    DOUBLES_EQUAL(10 * evaporationFactor, routingTable->getPheromoneValue(destination3, nextHopA, interface), 0.00001);
+    CHECK_EQUAL(2, routingTable->getTotalNumberOfEntries());
+}
+
+TEST(FlatRoutingTableTest, getEntryAt) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+    routingTable->update(destination, nextHopA, interface, 1);
+    routingTable->update(destination, nextHopB, interface, 2);
+
+    RoutingTableEntryTupel tupel = routingTable->getEntryAt(1);
+    CHECK(tupel.destination->equals(destination));
+    CHECK(tupel.entry->getAddress()->equals(nextHopB));
+
+    try {
+        routingTable->getEntryAt(2);
+        FAIL("Should have thrown an exception (index out of bounds)");
+    } catch(Exception &exception) {
+        STRCMP_EQUAL("FlatRoutingTable::getEntryAt: Index out of bounds", exception.getMessage());
+    }
+}
+
+TEST(FlatRoutingTableTest, getAllRoutesThatLeadOverSpecificNextHop) {
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+
+    routingTable->update(destination1, nextHopA, interface, 1);
+    routingTable->update(destination1, nextHopB, interface, 1);
+    routingTable->update(destination2, nextHopA, interface, 1);
+
+    std::deque<RoutingTableEntryTupel> routes = routingTable->getAllRoutesThatLeadOver(nextHopA);
+    CHECK_EQUAL(2, routes.size());
+    for (auto& route: routes) {
+        CHECK(route.entry->getAddress()->equals(nextHopA));
+    }
+    CHECK_EQUAL(1, routingTable->getAllRoutesThatLeadOver(nextHopB).size());
+}
+
+TEST(FlatRoutingTableTest, routesThatLeadOverSpecificNextHopAreUpdatedOnRemoval) {
+    std::vector<AddressPtr> destinations = createCollidingDestinations(2);
+    AddressPtr destination1 = destinations[0];
+    AddressPtr destination2 = destinations[1];
+    AddressPtr nextHopA (new AddressMock("A"));
+
+    routingTable->update(destination1, nextHopA, interface, 10);
+    routingTable->update(destination2, nextHopA, interface, 0.6);
+    BYTES_EQUAL(routingTable->getHomeSlot(destination1), routingTable->getHomeSlot(destination2));
+
+    CHECK_TRUE(routingTable->removeEntry(destination1, nextHopA, interface));
+    CHECK_FALSE(routingTable->removeEntry(destination1, nextHopA, interface));
+    std::deque<RoutingTableEntryTupel> routes = routingTable->getAllRoutesThatLeadOver(nextHopA);
+    CHECK_EQUAL(1, routes.size());
+    CHECK(routes.front().destination->equals(destination2));
+
+    routingTable->triggerEvaporation();
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+    CHECK(routingTable->getAllRoutesThatLeadOver(nextHopA).empty());
+}
+
+TEST(FlatRoutingTableTest, lazyEvaporationIsAppliedOnLookup) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    routingTable->setLazyEvaporation(true);
+
+    routingTable->triggerEvaporation();
+    routingTable->update(destination, nodeA, interface, 2.5);
+    routingTable->update(destination, nodeB, interface, 0.6);
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    DOUBLES_EQUAL(2.5 * evaporationFactor, routingTable->getPheromoneValue(destination, nodeA, interface), 0.00001);
+    CHECK_FALSE(routingTable->exists(destination, nodeB, interface));
+    BYTES_EQUAL(1, routingTable->getTotalNumberOfEntries());
+}
+
+TEST(FlatRoutingTableTest, lazyEvaporationRemovesRoutesThatAreNotLookedUpAnymore) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->setLazyEvaporation(true);
+
+    routingTable->triggerEvaporation();
+    for (auto& destination: createCollidingDestinations(100)) {
+        routingTable->update(destination, nextHop, interface, 2);
+    }
+
+    TimeMock::letTimePass(100000);
+    for (int i = 0; i < 1000; i++) {
+        routingTable->triggerEvaporation();
+    }
+    BYTES_EQUAL(0, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nextHop).empty());
+}
+
+TEST(FlatRoutingTableTest, incrementalEvaporationReachesTheSameValuesAsTheFullSweep) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->setMaxNrOfBucketsPerEvaporation(3);
+
+    routingTable->triggerEvaporation();
+    for (int i = 0; i < 20; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, 10);
+    }
+    AddressPtr youngerDestination (new AddressMock("younger"));
+
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+    routingTable->update(youngerDestination, nextHop, interface, 10);
+    for (int i = 0; i < 100; i++) {
+        routingTable->triggerEvaporation();
+    }
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    for (int i = 0; i < 20; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        DOUBLES_EQUAL(10 * evaporationFactor, routingTable->getPheromoneValue(destination, nextHop, interface), 0.00001);
+    }
+    DOUBLES_EQUAL(10, routingTable->getPheromoneValue(youngerDestination, nextHop, interface), 0.00001);
+}
+
+TEST(FlatRoutingTableTest, iterateOverAllEntries) {
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+
+    CHECK(routingTable->begin() == routingTable->end());
+
+    unsigned int nrOfDestinations = 10;
+    for (auto& destination: createCollidingDestinations(nrOfDestinations)) {
+        routingTable->update(destination, nextHopA, interface, 1);
+        routingTable->update(destination, nextHopB, interface, 2);
+    }
+
+    int position = 0;
+    for (RoutingTable::const_iterator iterator = routingTable->begin(); iterator != routingTable->end(); ++iterator) {
+        RoutingTableEntryTupel expectedTupel = routingTable->getEntryAt(position);
+        CHECK((*iterator).entry == expectedTupel.entry);
+        position++;
+    }
+    CHECK_EQUAL(2 * nrOfDestinations, position);
+
+    float sumOfPheromoneValues = 0;
+    routingTable->forEachEntry([&](const AddressPtr& destination, RoutingTableEntry* entry) {
+        sumOfPheromoneValues += entry->getPheromoneValue();
+    });
+    CHECK_EQUAL(3 * nrOfDestinations, sumOfPheromoneValues);
+}
+
+TEST(FlatRoutingTableTest, leastRecentlyUpdatedRouteIsEvictedIfTableIsFull) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+    AddressPtr destination3 (new AddressMock("3"));
+    AddressPtr destination4 (new AddressMock("4"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setPheromoneAwareEviction(false);
+    routingTable->setMaxNrOfEntries(3);
+
+    routingTable->update(destination1, nextHop, interface, 1);
+    routingTable->update(destination2, nextHop, interface, 2);
+    routingTable->update(destination3, nextHop, interface, 3);
+    routingTable->update(destination1, nextHop, interface, 5);
+    CHECK(listener.evictedDestinations.empty());
+
+    routingTable->update(destination4, nextHop, interface, 4);
+    CHECK_EQUAL(3, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->isDeliverable(destination2) == false);
+    CHECK(routingTable->exists(destination1, nextHop, interface));
+    CHECK(routingTable->exists(destination3, nextHop, interface));
+    CHECK(routingTable->exists(destination4, nextHop, interface));
+    BYTES_EQUAL(1, listener.evictedDestinations.size());
+    CHECK(listener.evictedDestinations.front()->equals(destination2));
+}
+
+TEST(FlatRoutingTableTest, routeWithLowestPheromoneValueIsEvictedIfTableIsFull) {
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setMaxNrOfEntries(2);
+
+    routingTable->update(destination, nodeA, interface, 10);
+    RouteHandle route = routingTable->findRoute(destination, nodeB, interface);
+    route.setPheromoneValue(1);
+    route = routingTable->findRoute(destination, nodeC, interface);
+    route.setPheromoneValue(5);
+
+    CHECK_EQUAL(2, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->exists(destination, nodeA, interface));
+    CHECK(routingTable->exists(destination, nodeB, interface) == false);
+    CHECK_EQUAL(5, routingTable->getPheromoneValue(destination, nodeC, interface));
+    BYTES_EQUAL(1, listener.evictedNextHops.size());
+    CHECK(listener.evictedNextHops.front()->equals(nodeB));
+}
+
+TEST(FlatRoutingTableTest, removedRoutesAreNotEvicted) {
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setPheromoneAwareEviction(false);
+    routingTable->setMaxNrOfEntries(4);
+
+    // the table never grows beyond its limit, no matter how often its routes are removed or replaced
+    std::deque<AddressPtr> destinations;
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    for (unsigned int i = 0; i < 40; i++) {
+        destinations.push_back(AddressPtr(new AddressMock(std::to_string(i))));
+        routingTable->update(destinations.back(), nextHop, interface, 1);
+        if (i % 3 == 1) {
+            routingTable->removeEntry(destinations.back(), nextHop, interface);
+        }
+        CHECK(routingTable->getTotalNumberOfEntries() <= 4);
+    }
+
+    for (auto& destination: listener.evictedDestinations) {
+        unsigned int i = std::stoi(destination->toString());
+        CHECK(i % 3 != 1);
+    }
+    CHECK_EQUAL(4, routingTable->getTotalNumberOfEntries());
+    CHECK_EQUAL(40 - 13 - 4, listener.evictedDestinations.size());
+}
@@ -0,0 +1,142 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "FlowCache.h"
+#include "RoutingTable.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/RoutingTableMock.h"
+#include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/time/TimeMock.h"
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(FlowCacheTest) {
+    ARAClientMock* client;
+    FlowCache* flowCache;
+    RoutingTable* routingTable;
+    NetworkInterfaceMock* interface;
+    PacketMock* packet;
+    AddressPtr nodeA;
+
+    void setup() {
+        client = new ARAClientMock();
+        flowCache = new FlowCache(1000, 0.5);
+        routingTable = new RoutingTableMock();
+        interface = client->createNewNetworkInterfaceMock();
+        packet = new PacketMock("source", "destination", "sender");
+        nodeA = AddressPtr(new AddressMock("A"));
+    }
+
+    void teardown() {
+        delete flowCache;
+        delete routingTable;
+        delete packet;
+        delete client;
+    }
+
+    void sendPacketOverRoute(AddressPtr nextHop, float pheromoneValue) {
+        routingTable->update(packet->getDestination(), nextHop, interface, pheromoneValue);
+        flowCache->routeHasBeenUsed(packet, nextHop, interface, pheromoneValue);
+    }
+};
+
+TEST(FlowCacheTest, unknownFlowIsNotCached) {
+    routingTable->update(packet->getDestination(), nodeA, interface, 10);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+}
+
+TEST(FlowCacheTest, nextHopIsKeptForTheDwellTime) {
+    sendPacketOverRoute(nodeA, 10);
+
+    NextHop* nextHop = flowCache->getNextHop(packet, routingTable);
+    CHECK(nextHop != nullptr);
+    CHECK(nextHop->getAddress()->equals(nodeA));
+    CHECK(nextHop->getInterface() == interface);
+
+    // packets of other flows are not affected
+    PacketMock otherFlow = PacketMock("otherSource", "destination", "sender");
+    CHECK(flowCache->getNextHop(&otherFlow, routingTable) == nullptr);
+
+    TimeMock::letTimePass(999);
+    CHECK(flowCache->getNextHop(packet, routingTable) != nullptr);
+
+    // further packets of the flow do not extend the dwell time
+    flowCache->routeHasBeenUsed(packet, nodeA, interface, 10);
+    TimeMock::letTimePass(1);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+
+    // a new decision is cached with a new dwell time
+    AddressPtr nodeB (new AddressMock("B"));
+    sendPacketOverRoute(nodeB, 10);
+    TimeMock::letTimePass(500);
+    nextHop = flowCache->getNextHop(packet, routingTable);
+    CHECK(nextHop != nullptr);
+    CHECK(nextHop->getAddress()->equals(nodeB));
+    BYTES_EQUAL(1, flowCache->size());
+}
+
+TEST(FlowCacheTest, nextHopIsChosenAgainIfThePheromoneValueHasShifted) {
+    sendPacketOverRoute(nodeA, 10);
+
+    routingTable->update(packet->getDestination(), nodeA, interface, 15);
+    CHECK(flowCache->getNextHop(packet, routingTable) != nullptr);
+    routingTable->update(packet->getDestination(), nodeA, interface, 5);
+    CHECK(flowCache->getNextHop(packet, routingTable) != nullptr);
+
+    routingTable->update(packet->getDestination(), nodeA, interface, 4.9);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+    routingTable->update(packet->getDestination(), nodeA, interface, 15.1);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+
+    // the shift is measured against the value the flow has last seen
+    flowCache->routeHasBeenUsed(packet, nodeA, interface, 15.1);
+    CHECK(flowCache->getNextHop(packet, routingTable) != nullptr);
+}
+
+TEST(FlowCacheTest, nextHopIsChosenAgainIfTheRouteHasBeenRemoved) {
+    sendPacketOverRoute(nodeA, 10);
+
+    routingTable->removeEntry(packet->getDestination(), nodeA, interface);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+}
+
+TEST(FlowCacheTest, packetsAreNotSentBackToTheSenderOrSource) {
+    sendPacketOverRoute(nodeA, 10);
+
+    PacketMock packetFromA = PacketMock("source", "destination", "A");
+    CHECK(flowCache->getNextHop(&packetFromA, routingTable) == nullptr);
+
+    sendPacketOverRoute(packet->getSource(), 10);
+    CHECK(flowCache->getNextHop(packet, routingTable) == nullptr);
+}
+
+TEST(FlowCacheTest, expiredFlowsArePurged) {
+    for (unsigned int i = 0; i < 64; i++) {
+        PacketMock packetOfFlow = PacketMock("source", std::to_string(i).c_str(), "sender");
+        flowCache->routeHasBeenUsed(&packetOfFlow, nodeA, interface, 10);
+    }
+    BYTES_EQUAL(64, flowCache->size());
+
+    TimeMock::letTimePass(1000);
+    sendPacketOverRoute(nodeA, 10);
+    BYTES_EQUAL(1, flowCache->size());
+}
+
+TEST(FlowCacheTest, flowIsFoundAfterTheAddressesOfThePacketsHaveBeenDeleted) {
+    sendPacketOverRoute(nodeA, 10);
+
+    // the packets of a flow are received one after another, so the source may be unknown in between
+    delete packet;
+    AddressTable::releaseUnusedAddresses();
+    packet = new PacketMock("source", "destination", "sender");
+
+    NextHop* nextHop = flowCache->getNextHop(packet, routingTable);
+    CHECK(nextHop != nullptr);
+    CHECK(nextHop->getAddress()->equals(nodeA));
+}
@@ -0,0 +1,103 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "IntermediateHopSet.h"
+#include "testAPI/mocks/AddressMock.h"
+
+#include <string>
+#include <vector>
+
+using namespace ARA;
+
+TEST_GROUP(IntermediateHopSetTest) {
+    std::vector<AddressPtr> hops;
+
+    void setup() {
+        for (unsigned int i = 0; i < 4 * IntermediateHopSet::INLINE_CAPACITY; i++) {
+            hops.push_back(AddressPtr(new AddressMock("hop" + std::to_string(i))));
+        }
+    }
+
+    AddressId idOf(unsigned int hop) {
+        return AddressTable::getId(hops[hop]);
+    }
+};
+
+TEST(IntermediateHopSetTest, emptySetContainsNothing) {
+    IntermediateHopSet set;
+    CHECK_TRUE(set.isEmpty());
+    CHECK_FALSE(set.contains(idOf(0)));
+    CHECK_FALSE(set.contains(idOf(1)));
+}
+
+TEST(IntermediateHopSetTest, insertedHopsAreContained) {
+    IntermediateHopSet set;
+    set.insert(hops[3]);
+    set.insert(hops[7]);
+    set.insert(hops[3]);
+
+    CHECK_FALSE(set.isEmpty());
+    CHECK_TRUE(set.contains(idOf(3)));
+    CHECK_TRUE(set.contains(idOf(7)));
+    CHECK_FALSE(set.contains(idOf(4)));
+}
+
+TEST(IntermediateHopSetTest, hopsBeyondTheInlineCapacityAreStillContained) {
+    IntermediateHopSet set;
+    unsigned int nrOfHops = 3 * IntermediateHopSet::INLINE_CAPACITY;
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        set.insert(hops[hop]);
+    }
+
+    // the Bloom filter has no false negatives
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        CHECK_TRUE(set.contains(idOf(hop)));
+    }
+}
+
+TEST(IntermediateHopSetTest, clearForgetsAllHops) {
+    IntermediateHopSet set;
+    unsigned int nrOfHops = 3 * IntermediateHopSet::INLINE_CAPACITY;
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        set.insert(hops[hop]);
+    }
+
+    set.clear();
+    CHECK_TRUE(set.isEmpty());
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        CHECK_FALSE(set.contains(idOf(hop)));
+    }
+
+    // the old hops must not come back when the set spills over again
+    for (unsigned int hop = nrOfHops; hop < hops.size(); hop++) {
+        set.insert(hops[hop]);
+    }
+    unsigned int nrOfFalsePositives = 0;
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        if (set.contains(idOf(hop))) {
+            nrOfFalsePositives++;
+        }
+    }
+    CHECK(nrOfFalsePositives < nrOfHops / 4);
+}
+
+TEST(IntermediateHopSetTest, idsOfTheHopsStayValid) {
+    IntermediateHopSet set;
+    unsigned int nrOfHops = 2 * IntermediateHopSet::INLINE_CAPACITY;
+    std::vector<AddressId> ids;
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        set.insert(hops[hop]);
+        ids.push_back(idOf(hop));
+    }
+
+    // the hops are seen again with new address objects after all others have been deleted
+    hops.clear();
+    AddressTable::releaseUnusedAddresses();
+    for (unsigned int hop = 0; hop < nrOfHops; hop++) {
+        AddressPtr address (new AddressMock("hop" + std::to_string(hop)));
+        CHECK_EQUAL(ids[hop], AddressTable::getId(address));
+        CHECK_TRUE(set.contains(AddressTable::getId(address)));
+    }
+}
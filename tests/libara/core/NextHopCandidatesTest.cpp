@@ -0,0 +1,328 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "NextHopCandidates.h"
+#include "RoutingTable.h"
+#include "FlatRoutingTable.h"
+#include "ConcurrentRoutingTable.h"
+#include "RoutingTableEntry.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/ExponentialEvaporationPolicyMock.h"
+#include "testAPI/mocks/time/TimeMock.h"
+
+#include <deque>
+#include <string>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(NextHopCandidatesTest) {
+    ARAClientMock* client;
+    NetworkInterfaceMock* interface;
+
+    void setup() {
+        client = new ARAClientMock();
+        interface = client->createNewNetworkInterfaceMock();
+    }
+
+    void teardown() {
+        delete client;
+    }
+
+    void checkCandidates(RoutingTable* routingTable) {
+        PacketMock packet = PacketMock("source", "destination", "sender");
+        AddressPtr destination = packet.getDestination();
+        AddressPtr nodeA (new AddressMock("A"));
+        AddressPtr nodeB (new AddressMock("B"));
+
+        CHECK_TRUE(routingTable->getNextHopCandidates(&packet).empty());
+        routingTable->update(destination, packet.getSource(), interface, 1);
+        routingTable->update(destination, nodeA, interface, 2);
+        routingTable->update(destination, packet.getSender(), interface, 3);
+        routingTable->update(destination, nodeB, interface, 4);
+
+        NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK_FALSE(candidates.empty());
+        BYTES_EQUAL(2, candidates.size());
+
+        std::deque<RoutingTableEntry*> entries;
+        for (auto entry: candidates) {
+            entries.push_back(entry);
+        }
+        BYTES_EQUAL(2, entries.size());
+        CHECK(entries.at(0)->getAddress()->equals(nodeA));
+        CHECK(entries.at(1)->getAddress()->equals(nodeB));
+    }
+
+    void checkAggregates(RoutingTable* routingTable) {
+        PacketMock packet = PacketMock("source", "destination", "sender");
+        AddressPtr destination = packet.getDestination();
+        AddressPtr nodeA (new AddressMock("A"));
+        AddressPtr nodeB (new AddressMock("B"));
+        AddressPtr nodeC (new AddressMock("C"));
+
+        routingTable->update(destination, nodeA, interface, 2);
+        routingTable->update(destination, nodeB, interface, 5);
+        routingTable->update(destination, nodeC, interface, 5);
+        NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeB));
+        DOUBLES_EQUAL(12, candidates.getSumOfPheromoneValues(), 0.0001);
+
+        // the best route gets worse
+        routingTable->update(destination, nodeB, interface, 1);
+        candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeC));
+        DOUBLES_EQUAL(8, candidates.getSumOfPheromoneValues(), 0.0001);
+
+        // another route catches up with the best route
+        routingTable->update(destination, nodeA, interface, 5);
+        candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeA));
+        DOUBLES_EQUAL(11, candidates.getSumOfPheromoneValues(), 0.0001);
+
+        // the best route is removed
+        routingTable->removeEntry(destination, nodeA, interface);
+        candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeC));
+        DOUBLES_EQUAL(6, candidates.getSumOfPheromoneValues(), 0.0001);
+
+        // some other route is removed
+        routingTable->removeEntry(destination, nodeB, interface);
+        candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeC));
+        DOUBLES_EQUAL(5, candidates.getSumOfPheromoneValues(), 0.0001);
+    }
+
+    void checkAggregatesAfterEvaporation(RoutingTable* routingTable) {
+        PacketMock packet = PacketMock("source", "destination", "sender");
+        AddressPtr destination = packet.getDestination();
+        AddressPtr nodeA (new AddressMock("A"));
+        AddressPtr nodeB (new AddressMock("B"));
+        ExponentialEvaporationPolicyMock* evaporationPolicy = (ExponentialEvaporationPolicyMock*) routingTable->getEvaporationPolicy();
+        float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+
+        routingTable->update(destination, nodeA, interface, 4);
+        routingTable->update(destination, nodeB, interface, 0.2);
+        routingTable->triggerEvaporation();
+
+        // the route over B evaporates completely
+        TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+        routingTable->triggerEvaporation();
+        NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+        CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeA));
+        DOUBLES_EQUAL(4 * evaporationFactor, candidates.getSumOfPheromoneValues(), 0.0001);
+    }
+};
+
+TEST(NextHopCandidatesTest, emptyView) {
+    NextHopCandidates candidates = NextHopCandidates();
+    CHECK_TRUE(candidates.empty());
+    BYTES_EQUAL(0, candidates.size());
+    CHECK(candidates.begin() == candidates.end());
+}
+
+TEST(NextHopCandidatesTest, sourceAndSenderAreSkipped) {
+    checkCandidates(client->getRoutingTable());
+}
+
+TEST(NextHopCandidatesTest, sourceAndSenderAreSkippedInFlatRoutingTable) {
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    checkCandidates(&routingTable);
+}
+
+TEST(NextHopCandidatesTest, viewIsEmptyIfAllRoutesLeadBack) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    RoutingTable* routingTable = client->getRoutingTable();
+    routingTable->update(packet.getDestination(), packet.getSender(), interface, 1);
+    routingTable->update(packet.getDestination(), packet.getSource(), interface, 1);
+
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK_TRUE(candidates.empty());
+    CHECK(candidates.begin() == candidates.end());
+    CHECK_FALSE(routingTable->isDeliverable(&packet));
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowUpdatesAndRemovals) {
+    checkAggregates(client->getRoutingTable());
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowUpdatesAndRemovalsInFlatRoutingTable) {
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    checkAggregates(&routingTable);
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowTheMovedRoutesOfTheFlatRoutingTable) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    std::deque<AddressPtr> nextHops;
+    for (unsigned int i = 0; i < 2 * FlatRoutingTable::INLINE_ROUTES; i++) {
+        nextHops.push_back(AddressPtr(new AddressMock("nextHop" + std::to_string(i))));
+    }
+    for (unsigned int i = 0; i < FlatRoutingTable::INLINE_ROUTES; i++) {
+        routingTable.update(destination, nextHops[i], interface, i == 2 ? 100 : 1);
+    }
+
+    // the slots and their inline routes are moved while the table grows
+    std::deque<AddressPtr> otherDestinations;
+    for (unsigned int i = 0; i < 100; i++) {
+        otherDestinations.push_back(AddressPtr(new AddressMock("destination" + std::to_string(i))));
+        routingTable.update(otherDestinations.back(), nextHops[0], interface, 1);
+    }
+    NextHopCandidates candidates = routingTable.getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate() == routingTable.findRoute(destination, nextHops[2], interface).getEntry());
+    DOUBLES_EQUAL(100 + FlatRoutingTable::INLINE_ROUTES - 1, candidates.getSumOfPheromoneValues(), 0.0001);
+
+    // the routes spill over to the heap
+    for (unsigned int i = FlatRoutingTable::INLINE_ROUTES; i < nextHops.size(); i++) {
+        routingTable.update(destination, nextHops[i], interface, 1);
+    }
+    candidates = routingTable.getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate() == routingTable.findRoute(destination, nextHops[2], interface).getEntry());
+    DOUBLES_EQUAL(100 + nextHops.size() - 1, candidates.getSumOfPheromoneValues(), 0.0001);
+
+    // a route before the best one is removed, so the best route moves to the front
+    routingTable.removeEntry(destination, nextHops[0], interface);
+    candidates = routingTable.getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate() == routingTable.findRoute(destination, nextHops[2], interface).getEntry());
+    DOUBLES_EQUAL(100 + nextHops.size() - 2, candidates.getSumOfPheromoneValues(), 0.0001);
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowEvaporation) {
+    checkAggregatesAfterEvaporation(client->getRoutingTable());
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowEvaporationInFlatRoutingTable) {
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    checkAggregatesAfterEvaporation(&routingTable);
+}
+
+TEST(NextHopCandidatesTest, aggregatesFollowLazyEvaporationInFlatRoutingTable) {
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    routingTable.setLazyEvaporation(true);
+    checkAggregatesAfterEvaporation(&routingTable);
+}
+
+TEST(NextHopCandidatesTest, aggregatesSkipSourceAndSender) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    RoutingTable* routingTable = client->getRoutingTable();
+
+    routingTable->update(destination, nodeA, interface, 2);
+    routingTable->update(destination, packet.getSender(), interface, 10);
+    routingTable->update(destination, nodeB, interface, 3);
+    routingTable->update(destination, packet.getSource(), interface, 7);
+
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeB));
+    DOUBLES_EQUAL(5, candidates.getSumOfPheromoneValues(), 0.0001);
+
+    // without the routes that lead back the aggregates can be used directly
+    routingTable->removeEntry(destination, packet.getSender(), interface);
+    routingTable->removeEntry(destination, packet.getSource(), interface);
+    candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeB));
+    DOUBLES_EQUAL(5, candidates.getSumOfPheromoneValues(), 0.0001);
+}
+
+TEST(NextHopCandidatesTest, bestCandidateAndSumWithoutAggregates) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    ConcurrentRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+
+    CHECK(routingTable.getNextHopCandidates(&packet).getBestCandidate() == nullptr);
+    routingTable.update(destination, nodeA, interface, 3);
+    routingTable.update(destination, packet.getSender(), interface, 10);
+    routingTable.update(destination, nodeB, interface, 3);
+
+    NextHopCandidates candidates = routingTable.getNextHopCandidates(&packet);
+    CHECK(candidates.getBestCandidate()->getAddress()->equals(nodeA));
+    DOUBLES_EQUAL(6, candidates.getSumOfPheromoneValues(), 0.0001);
+}
+
+TEST(NextHopCandidatesTest, sampleFollowsCumulativeDistribution) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    RoutingTable* routingTable = client->getRoutingTable();
+
+    CHECK(routingTable->getNextHopCandidates(&packet).sample(0.5) == nullptr);
+    routingTable->update(destination, nodeA, interface, 1);
+    routingTable->update(destination, nodeB, interface, 2);
+    routingTable->update(destination, nodeC, interface, 3);
+
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.1)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.2)->getAddress()->equals(nodeB));
+    CHECK(candidates.sample(0.45)->getAddress()->equals(nodeB));
+    CHECK(candidates.sample(0.55)->getAddress()->equals(nodeC));
+    CHECK(candidates.sample(1)->getAddress()->equals(nodeC));
+
+    // the cached distribution must be rebuilt after the pheromone values have changed
+    routingTable->update(destination, nodeA, interface, 4);
+    candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0.4)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.5)->getAddress()->equals(nodeB));
+
+    routingTable->removeEntry(destination, nodeA, interface);
+    candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0.3)->getAddress()->equals(nodeB));
+    CHECK(candidates.sample(0.5)->getAddress()->equals(nodeC));
+}
+
+TEST(NextHopCandidatesTest, sampleSkipsSourceAndSender) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    RoutingTable* routingTable = client->getRoutingTable();
+
+    routingTable->update(destination, packet.getSource(), interface, 5);
+    routingTable->update(destination, nodeA, interface, 1);
+    routingTable->update(destination, packet.getSender(), interface, 5);
+    routingTable->update(destination, nodeB, interface, 3);
+
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.2)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.3)->getAddress()->equals(nodeB));
+    CHECK(candidates.sample(1)->getAddress()->equals(nodeB));
+}
+
+TEST(NextHopCandidatesTest, sampleWithoutAnySelectionWeightPicksEachCandidateEqually) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+
+    routingTable.update(destination, nodeA, interface, 0);
+    routingTable.update(destination, packet.getSender(), interface, 0);
+    routingTable.update(destination, nodeB, interface, 0);
+
+    NextHopCandidates candidates = routingTable.getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.49)->getAddress()->equals(nodeA));
+    CHECK(candidates.sample(0.5)->getAddress()->equals(nodeB));
+    CHECK(candidates.sample(1)->getAddress()->equals(nodeB));
+}
@@ -14,7 +14,7 @@ using namespace ARA;
 TEST_GROUP(NextHopTest) {};
 
 TEST(NextHopTest, testGetters) {
-    ARAClientMock client = ARAClientMock();
+    ARAClientMock client;
     NetworkInterfaceMock interface = NetworkInterfaceMock(&client);
     std::shared_ptr<Address> address (new AddressMock());
     NextHop nextHop = NextHop(address, &interface);
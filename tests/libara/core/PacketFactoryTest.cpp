@@ -9,6 +9,7 @@
 #include "PacketType.h"
 
 #include <cstring>
+#include <string>
 
 using namespace ARA;
 
@@ -232,3 +233,48 @@ TEST(PacketFactoryTest, makePANT) {
 
     delete pant;
 }
+
+TEST(PacketFactoryTest, clonesShareThePayload) {
+   AddressPtr source (new AddressMock("source"));
+   AddressPtr destination (new AddressMock("destination"));
+   std::string payload = std::string(PayloadBuffer::INLINE_CAPACITY + 100, 'x');
+   Packet* packet = factory->makeDataPacket(source, destination, 1, payload.c_str(), 0);
+   Packet* clone = factory->makeClone(packet);
+
+   CHECK(clone->getPayload() == packet->getPayload());
+   BYTES_EQUAL(payload.size() + 1, clone->getPayloadLength());
+   BYTES_EQUAL(2, packet->getPayloadBuffer().getNrOfReferences());
+
+   delete packet;
+   STRCMP_EQUAL(payload.c_str(), clone->getPayload());
+   delete clone;
+}
+
+TEST(PacketFactoryTest, smallPayloadsAreStoredInTheClones) {
+   AddressPtr source (new AddressMock("source"));
+   AddressPtr destination (new AddressMock("destination"));
+   std::string payload = std::string(PayloadBuffer::INLINE_CAPACITY, 'x');
+   Packet* packet = factory->makeDataPacket(source, destination, 1, payload.c_str(), payload.size());
+   Packet* clone = factory->makeClone(packet);
+
+   CHECK(clone->getPayloadBuffer().isInline() == (PayloadBuffer::INLINE_CAPACITY > 0));
+   CHECK(std::memcmp(payload.c_str(), clone->getPayload(), payload.size()) == 0);
+   BYTES_EQUAL(payload.size(), clone->getPayloadLength());
+
+   delete packet;
+   delete clone;
+}
+
+TEST(PacketFactoryTest, makeDataPacketWithAdoptedPayload) {
+   AddressPtr source (new AddressMock("source"));
+   AddressPtr destination (new AddressMock("destination"));
+   char* payload = new char[1500];
+   std::memset(payload, 'x', 1500);
+
+   Packet* packet = factory->makeDataPacket(source, destination, 1, PayloadBuffer::adopt(payload, 1500));
+   CHECK(packet->getPayload() == payload);
+   BYTES_EQUAL(1500, packet->getPayloadLength());
+   BYTES_EQUAL(1, packet->getPayloadBuffer().getNrOfReferences());
+   CHECK(packet->getType() == PacketType::DATA);
+   delete packet;
+}
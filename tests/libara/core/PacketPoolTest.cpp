@@ -0,0 +1,160 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "PacketPool.h"
+#include "PacketFactory.h"
+#include "EARAPacketFactory.h"
+#include "Packet.h"
+#include "testAPI/mocks/AddressMock.h"
+
+#include <thread>
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(PacketPoolTest) {
+    AddressPtr source;
+    AddressPtr destination;
+
+    void setup() {
+        source = AddressPtr(new AddressMock("source"));
+        destination = AddressPtr(new AddressMock("destination"));
+        PacketPool::clear();
+        PacketPool::resetStatistics();
+    }
+
+    void teardown() {
+        PacketPool::setMaxNrOfFreePackets(4096);
+    }
+};
+
+TEST(PacketPoolTest, releasedPacketsAreReused) {
+    PacketFactory factory = PacketFactory(15);
+    Packet* packet = factory.makeFANT(source, destination, 1);
+    void* memory = packet;
+    factory.release(packet);
+    BYTES_EQUAL(1, PacketPool::getStatistics().nrOfFreePackets);
+
+    // packets that are deleted are returned to the pool as well
+    packet = factory.makeFANT(source, destination, 2);
+    CHECK(memory == packet);
+    delete packet;
+
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(2, statistics.nrOfAllocations);
+    BYTES_EQUAL(1, statistics.nrOfReusedPackets);
+    BYTES_EQUAL(2, statistics.nrOfReleases);
+    BYTES_EQUAL(0, statistics.nrOfPacketsInUse);
+    BYTES_EQUAL(1, statistics.maxNrOfPacketsInUse);
+    BYTES_EQUAL(1, statistics.nrOfFreePackets);
+}
+
+TEST(PacketPoolTest, maxNrOfPacketsInUse) {
+    PacketFactory factory = PacketFactory(15);
+    Packet* packets[3];
+    for (unsigned int i = 0; i < 3; i++) {
+        packets[i] = factory.makeFANT(source, destination, i);
+    }
+    factory.release(packets[0]);
+    packets[0] = factory.makeFANT(source, destination, 3);
+
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(3, statistics.nrOfPacketsInUse);
+    BYTES_EQUAL(3, statistics.maxNrOfPacketsInUse);
+
+    for (unsigned int i = 0; i < 3; i++) {
+        factory.release(packets[i]);
+    }
+    statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(0, statistics.nrOfPacketsInUse);
+    BYTES_EQUAL(3, statistics.maxNrOfPacketsInUse);
+    BYTES_EQUAL(3, statistics.nrOfFreePackets);
+}
+
+TEST(PacketPoolTest, reservePackets) {
+    EARAPacketFactory factory = EARAPacketFactory(15);
+    factory.reservePackets(5);
+    BYTES_EQUAL(5, PacketPool::getStatistics().nrOfFreePackets);
+
+    Packet* packets[5];
+    for (unsigned int i = 0; i < 5; i++) {
+        packets[i] = factory.makePEANT(source, i);
+    }
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(5, statistics.nrOfReusedPackets);
+    BYTES_EQUAL(0, statistics.nrOfFreePackets);
+
+    for (unsigned int i = 0; i < 5; i++) {
+        factory.release(packets[i]);
+    }
+}
+
+TEST(PacketPoolTest, freeListsAreLimited) {
+    PacketPool::setMaxNrOfFreePackets(2);
+    PacketFactory factory = PacketFactory(15);
+    Packet* packets[3];
+    for (unsigned int i = 0; i < 3; i++) {
+        packets[i] = factory.makeFANT(source, destination, i);
+    }
+    for (unsigned int i = 0; i < 3; i++) {
+        factory.release(packets[i]);
+    }
+    BYTES_EQUAL(2, PacketPool::getStatistics().nrOfFreePackets);
+
+    PacketPool::clear();
+    BYTES_EQUAL(0, PacketPool::getStatistics().nrOfFreePackets);
+}
+
+TEST(PacketPoolTest, largeBlocksAreNotPooled) {
+    void* block = PacketPool::allocate(PacketPool::MAX_POOLED_PACKET_SIZE + 1);
+    PacketPool::release(block, PacketPool::MAX_POOLED_PACKET_SIZE + 1);
+
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(1, statistics.nrOfAllocations);
+    BYTES_EQUAL(1, statistics.nrOfReleases);
+    BYTES_EQUAL(0, statistics.nrOfFreePackets);
+}
+
+TEST(PacketPoolTest, packetsMayBeReleasedByAnotherThread) {
+    PacketFactory factory = PacketFactory(15);
+    Packet* packet = factory.makeFANT(source, destination, 1);
+
+    std::thread releasingThread([&factory, packet]() {
+        factory.release(packet);
+    });
+    releasingThread.join();
+
+    // the packet has been kept by the free list of the other thread
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(1, statistics.nrOfAllocations);
+    BYTES_EQUAL(1, statistics.nrOfReleases);
+    BYTES_EQUAL(0, statistics.nrOfPacketsInUse);
+    BYTES_EQUAL(1, statistics.maxNrOfPacketsInUse);
+    BYTES_EQUAL(0, statistics.nrOfFreePackets);
+}
+
+TEST(PacketPoolTest, countersOfEndedThreadsAreKept) {
+    PacketFactory factory = PacketFactory(15);
+    Packet* packet = nullptr;
+
+    std::thread allocatingThread([this, &factory, &packet]() {
+        Packet* otherPacket = factory.makeFANT(source, destination, 1);
+        packet = factory.makeFANT(source, destination, 2);
+        factory.release(otherPacket);
+    });
+    allocatingThread.join();
+
+    PacketPoolStatistics statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(2, statistics.nrOfAllocations);
+    BYTES_EQUAL(1, statistics.nrOfReleases);
+    BYTES_EQUAL(1, statistics.nrOfPacketsInUse);
+    BYTES_EQUAL(2, statistics.maxNrOfPacketsInUse);
+
+    factory.release(packet);
+    statistics = PacketPool::getStatistics();
+    BYTES_EQUAL(2, statistics.nrOfReleases);
+    BYTES_EQUAL(0, statistics.nrOfPacketsInUse);
+}
@@ -0,0 +1,104 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "PayloadBuffer.h"
+
+#include <cstring>
+#include <string>
+
+using namespace ARA;
+
+TEST_GROUP(PayloadBufferTest) {
+    // a payload that does not fit into the inline storage
+    std::string largePayload = std::string(PayloadBuffer::INLINE_CAPACITY + 100, 'x');
+};
+
+TEST(PayloadBufferTest, emptyBuffer) {
+    PayloadBuffer buffer;
+    CHECK(buffer.isEmpty());
+    CHECK_FALSE(buffer.isInline());
+    CHECK(buffer.getData() == nullptr);
+    BYTES_EQUAL(0, buffer.getSize());
+    BYTES_EQUAL(0, buffer.getNrOfReferences());
+
+    PayloadBuffer bufferOfNothing = PayloadBuffer(nullptr, 10);
+    CHECK(bufferOfNothing.isEmpty());
+}
+
+TEST(PayloadBufferTest, dataIsCopied) {
+    char data[] = "Hello";
+    PayloadBuffer buffer = PayloadBuffer(data, 6);
+    data[0] = 'J';
+
+    CHECK_FALSE(buffer.isEmpty());
+    CHECK(buffer.getData() != data);
+    STRCMP_EQUAL("Hello", buffer.getData());
+    BYTES_EQUAL(6, buffer.getSize());
+
+    // a size of 0 means that the data is a null terminated string
+    PayloadBuffer stringBuffer = PayloadBuffer(largePayload.c_str(), 0);
+    STRCMP_EQUAL(largePayload.c_str(), stringBuffer.getData());
+    BYTES_EQUAL(largePayload.size() + 1, stringBuffer.getSize());
+}
+
+TEST(PayloadBufferTest, smallPayloadsAreStoredInline) {
+    if (PayloadBuffer::INLINE_CAPACITY < 6) {
+        return;
+    }
+
+    PayloadBuffer buffer = PayloadBuffer("Hello", 0);
+    CHECK(buffer.isInline());
+    CHECK(buffer.getData() == reinterpret_cast<const char*>(&buffer));
+
+    PayloadBuffer copy = buffer;
+    CHECK(copy.isInline());
+    CHECK(copy.getData() != buffer.getData());
+    STRCMP_EQUAL("Hello", copy.getData());
+    BYTES_EQUAL(1, buffer.getNrOfReferences());
+
+    PayloadBuffer movedBuffer = std::move(copy);
+    STRCMP_EQUAL("Hello", movedBuffer.getData());
+    CHECK(copy.isEmpty());
+
+    PayloadBuffer largeBuffer = PayloadBuffer(largePayload.c_str(), largePayload.size());
+    CHECK_FALSE(largeBuffer.isInline());
+    largeBuffer = buffer;
+    CHECK(largeBuffer.isInline());
+    STRCMP_EQUAL("Hello", largeBuffer.getData());
+}
+
+TEST(PayloadBufferTest, copiesShareTheData) {
+    PayloadBuffer buffer = PayloadBuffer(largePayload.c_str(), 0);
+    CHECK_FALSE(buffer.isInline());
+    BYTES_EQUAL(1, buffer.getNrOfReferences());
+
+    PayloadBuffer* copy = new PayloadBuffer(buffer);
+    CHECK(copy->getData() == buffer.getData());
+    BYTES_EQUAL(2, buffer.getNrOfReferences());
+
+    PayloadBuffer otherBuffer = PayloadBuffer("World", 0);
+    otherBuffer = buffer;
+    CHECK(otherBuffer.getData() == buffer.getData());
+    BYTES_EQUAL(3, buffer.getNrOfReferences());
+
+    delete copy;
+    otherBuffer = PayloadBuffer();
+    BYTES_EQUAL(1, buffer.getNrOfReferences());
+    STRCMP_EQUAL(largePayload.c_str(), buffer.getData());
+}
+
+TEST(PayloadBufferTest, adoptedDataIsNotCopied) {
+    char* data = new char[6];
+    std::strcpy(data, "Hello");
+
+    PayloadBuffer buffer = PayloadBuffer::adopt(data, 6);
+    CHECK_FALSE(buffer.isInline());
+    CHECK(buffer.getData() == data);
+    BYTES_EQUAL(6, buffer.getSize());
+
+    PayloadBuffer copy = buffer;
+    CHECK(copy.getData() == data);
+    BYTES_EQUAL(2, copy.getNrOfReferences());
+}
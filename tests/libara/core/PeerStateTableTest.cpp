@@ -0,0 +1,126 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "PeerStateTable.h"
+#include "NoSuchElementException.h"
+#include "testAPI/mocks/AddressMock.h"
+
+using namespace ARA;
+
+TEST_GROUP(PeerStateTableTest) {};
+
+TEST(PeerStateTableTest, newStatesAreEmpty) {
+    PeerStateTable table;
+    AddressPtr address (new AddressMock("A"));
+
+    PeerState& state = table.get(address);
+    CHECK_FALSE(state.receivedSequenceNumbers.contains(1));
+    CHECK_TRUE(state.knownIntermediateHops.isEmpty());
+    CHECK_FALSE(state.hasSeenRouteDiscovery);
+    CHECK(state.lastActivityTime == nullptr);
+    CHECK(state.lastActivityInterface == nullptr);
+    CHECK_FALSE(state.isRouteDiscoveryRunning);
+    CHECK(state.routeDiscoveryTimer == nullptr);
+    CHECK(state.pantTimer == nullptr);
+}
+
+TEST(PeerStateTableTest, findDoesNotCreateStates) {
+    PeerStateTable table;
+    AddressPtr address (new AddressMock("A"));
+
+    CHECK(table.find(address) == nullptr);
+    LONGS_EQUAL(0, table.size());
+
+    PeerState& state = table.get(address);
+    CHECK(table.find(address) == &state);
+    LONGS_EQUAL(1, table.size());
+}
+
+TEST(PeerStateTableTest, statesAreKeptForEachAddress) {
+    PeerStateTable table;
+    AddressPtr addressA (new AddressMock("A"));
+    AddressPtr addressB (new AddressMock("B"));
+    AddressPtr sameAsA (new AddressMock("A"));
+
+    table.get(addressA).receivedSequenceNumbers.insert(12);
+    table.get(addressB).lastRouteDiscoverySequenceNumber = 42;
+
+    CHECK_TRUE(table.get(sameAsA).receivedSequenceNumbers.contains(12));
+    CHECK_FALSE(table.get(addressB).receivedSequenceNumbers.contains(12));
+    LONGS_EQUAL(42, table.get(addressB).lastRouteDiscoverySequenceNumber);
+    LONGS_EQUAL(0, table.get(addressA).lastRouteDiscoverySequenceNumber);
+    LONGS_EQUAL(2, table.size());
+}
+
+TEST(PeerStateTableTest, statesDoNotMoveWhenTheTableGrows) {
+    PeerStateTable table;
+    AddressPtr address (new AddressMock("first"));
+    PeerState* firstState = &table.get(address);
+
+    for (unsigned int i = 0; i < 1000; i++) {
+        table.get(AddressPtr(new AddressMock("other" + std::to_string(i))));
+    }
+
+    CHECK(&table.get(address) == firstState);
+    CHECK(table.find(address) == firstState);
+}
+
+TEST(PeerStateTableTest, erasedStatesAreForgotten) {
+    PeerStateTable table;
+    AddressPtr address (new AddressMock("A"));
+    AddressPtr other (new AddressMock("B"));
+
+    table.get(address).hasSeenRouteDiscovery = true;
+    table.get(other);
+    table.erase(address);
+
+    // this must not return the erased state that has been looked up last
+    CHECK(table.find(address) == nullptr);
+    LONGS_EQUAL(1, table.size());
+    CHECK_FALSE(table.get(address).hasSeenRouteDiscovery);
+
+    // erasing an unknown node does nothing
+    table.erase(AddressPtr(new AddressMock("C")));
+    LONGS_EQUAL(2, table.size());
+}
+
+TEST(PeerStateTableTest, idsOfErasedStatesAreReleased) {
+    PeerStateTable table;
+    AddressPtr address (new AddressMock("releasedByPeerStateTable"));
+    AddressId id = AddressTable::getId(address);
+    table.get(id);
+
+    table.erase(id);
+    address.reset();
+    AddressTable::releaseUnusedAddresses();
+    try {
+        AddressTable::getAddress(id);
+        FAIL("An exception should have been thrown");
+    } catch (NoSuchElementException &exception) {
+        // this is expected
+    }
+}
+
+TEST(PeerStateTableTest, idsOfTheStatesAreRetained) {
+    AddressId id;
+    {
+        PeerStateTable table;
+        AddressPtr address (new AddressMock("retainedByPeerStateTable"));
+        id = AddressTable::getId(address);
+        table.get(id);
+
+        address.reset();
+        AddressTable::releaseUnusedAddresses();
+        CHECK(AddressTable::getAddress(id)->equals(AddressPtr(new AddressMock("retainedByPeerStateTable"))));
+    }
+
+    AddressTable::releaseUnusedAddresses();
+    try {
+        AddressTable::getAddress(id);
+        FAIL("An exception should have been thrown");
+    } catch (NoSuchElementException &exception) {
+        // this is expected
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "RouteHandle.h"
+#include "RoutingTable.h"
+#include "FlatRoutingTable.h"
+#include "EnergyAwareRoutingTable.h"
+#include "Exception.h"
+#include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/NetworkInterfaceMock.h"
+#include "testAPI/mocks/ARAClientMock.h"
+
+using namespace ARA;
+
+typedef std::shared_ptr<Address> AddressPtr;
+
+TEST_GROUP(RouteHandleTest) {
+    ARAClientMock* client;
+    NetworkInterfaceMock* interface;
+
+    void setup() {
+        client = new ARAClientMock();
+        interface = client->createNewNetworkInterfaceMock();
+    }
+
+    void teardown() {
+        delete client;
+    }
+
+    void checkLookupOrInsert(RoutingTable* routingTable) {
+        AddressPtr destination (new AddressMock("destination"));
+        AddressPtr nodeA (new AddressMock("A"));
+        AddressPtr nodeB (new AddressMock("B"));
+
+        // the destination is unknown
+        RouteHandle route = routingTable->findRoute(destination, nodeA, interface);
+        CHECK_FALSE(route.exists());
+        CHECK_EQUAL(0, route.getPheromoneValue());
+
+        route.setPheromoneValue(1.5);
+        CHECK_TRUE(route.exists());
+        CHECK_EQUAL(1.5, route.getPheromoneValue());
+        CHECK_EQUAL(1.5, routingTable->getPheromoneValue(destination, nodeA, interface));
+        CHECK(routingTable->getAllRoutesThatLeadOver(nodeA).size() == 1);
+
+        // the destination is known but the next hop is not
+        RouteHandle otherRoute = routingTable->findRoute(destination, nodeB, interface);
+        CHECK_FALSE(otherRoute.exists());
+        otherRoute.setPheromoneValue(2);
+        BYTES_EQUAL(2, routingTable->getTotalNumberOfEntries());
+
+        // the route exists and is updated in place
+        RouteHandle existingRoute = routingTable->findRoute(destination, nodeA, interface);
+        CHECK_TRUE(existingRoute.exists());
+        CHECK_EQUAL(1.5, existingRoute.getPheromoneValue());
+        existingRoute.setPheromoneValue(3);
+        CHECK_EQUAL(3, routingTable->getPheromoneValue(destination, nodeA, interface));
+        CHECK_EQUAL(2, routingTable->getPheromoneValue(destination, nodeB, interface));
+        BYTES_EQUAL(2, routingTable->getTotalNumberOfEntries());
+    }
+};
+
+TEST(RouteHandleTest, lookupOrInsert) {
+    checkLookupOrInsert(client->getRoutingTable());
+}
+
+TEST(RouteHandleTest, lookupOrInsertInFlatRoutingTable) {
+    FlatRoutingTable routingTable;
+    routingTable.setEvaporationPolicy(client->getRoutingTable()->getEvaporationPolicy());
+    checkLookupOrInsert(&routingTable);
+}
+
+TEST(RouteHandleTest, energyAwareRoutingTableCanNotCreateRoutesWithoutEnergy) {
+    EnergyAwareRoutingTable routingTable;
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nextHop (new AddressMock("A"));
+
+    RouteHandle route = routingTable.findRoute(destination, nextHop, interface);
+    try {
+        route.setPheromoneValue(1);
+        FAIL("Creating a route in the EnergyAwareRoutingTable without an energy value should throw an exception");
+    }
+    catch (Exception& exception) {
+        STRCMP_EQUAL("EnergyAwareRoutingTable can only create/update entries when an energy value is supplied (Most likely a bug in EARA code?!)", exception.getMessage());
+    }
+
+    routingTable.update(destination, nextHop, interface, 1, 5);
+    route = routingTable.findRoute(destination, nextHop, interface);
+    route.setPheromoneValue(2);
+    CHECK_EQUAL(2, routingTable.getPheromoneValue(destination, nextHop, interface));
+    CHECK_EQUAL(5, routingTable.getEnergyValue(destination, nextHop, interface));
+}
+
+TEST(RouteHandleTest, handleStaysValidWhenTheFlatRoutingTableGrows) {
+    FlatRoutingTable routingTable;
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nextHop (new AddressMock("A"));
+    routingTable.update(destination, nextHop, interface, 1);
+
+    RouteHandle route = routingTable.findRoute(destination, nextHop, interface);
+    RoutingTableEntry* entryBeforeGrowing = route.getEntry();
+
+    // this exceeds the initial capacity of the table, so all slots are moved
+    for (unsigned int i = 0; i < 32; i++) {
+        AddressPtr otherDestination (new AddressMock("destination" + std::to_string(i)));
+        routingTable.update(otherDestination, nextHop, interface, 2);
+    }
+    CHECK(route.getEntry() != entryBeforeGrowing);
+    CHECK(route.getEntry() == routingTable.findRoute(destination, nextHop, interface).getEntry());
+
+    CHECK_TRUE(route.exists());
+    CHECK_EQUAL(1, route.getPheromoneValue());
+    route.setPheromoneValue(3);
+    CHECK_EQUAL(3, routingTable.getPheromoneValue(destination, nextHop, interface));
+    BYTES_EQUAL(33, routingTable.getTotalNumberOfEntries());
+}
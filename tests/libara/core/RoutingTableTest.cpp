@@ -11,10 +11,16 @@
 #include "testAPI/mocks/PacketMock.h"
 #include "testAPI/mocks/NetworkInterfaceMock.h"
 #include "testAPI/mocks/ExponentialEvaporationPolicyMock.h"
+#include "testAPI/mocks/BatchCountingEvaporationPolicyMock.h"
 #include "testAPI/mocks/time/TimeMock.h"
 #include "testAPI/mocks/ARAClientMock.h"
+#include "testAPI/mocks/RouteEvictionListenerMock.h"
+#include "Exception.h"
 
+#include <cstdio>
 #include <deque>
+#include <fstream>
+#include <string>
 
 using namespace ARA;
 
@@ -498,6 +504,35 @@ TEST(RoutingTableTest, getAllRoutesThatLeadOverSpecificNextHop) {
     CHECK(entriesOverUnkown.empty());
 }
 
+TEST(RoutingTableTest, routesThatLeadOverSpecificNextHopAreUpdatedOnRemoval) {
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr dest1 (new AddressMock("dest1"));
+    AddressPtr dest2 (new AddressMock("dest2"));
+    NetworkInterfaceMock* otherInterface = client->createNewNetworkInterfaceMock("otherInterface");
+
+    routingTable->update(dest1, nodeB, interface, 10);
+    routingTable->update(dest1, nodeB, otherInterface, 10);
+    routingTable->update(dest2, nodeB, interface, 0.5); // this one should be removed due to evaporation
+    BYTES_EQUAL(3, routingTable->getAllRoutesThatLeadOver(nodeB).size());
+
+    // the route over the other interface still leads over B
+    CHECK_TRUE(routingTable->removeEntry(dest1, nodeB, interface));
+    CHECK_FALSE(routingTable->removeEntry(dest1, nodeB, interface));
+    std::deque<RoutingTableEntryTupel> entriesOverB = routingTable->getAllRoutesThatLeadOver(nodeB);
+    BYTES_EQUAL(2, entriesOverB.size());
+
+    routingTable->triggerEvaporation();
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+    entriesOverB = routingTable->getAllRoutesThatLeadOver(nodeB);
+    BYTES_EQUAL(1, entriesOverB.size());
+    CHECK(entriesOverB.front().destination->equals(dest1));
+    CHECK(entriesOverB.front().entry->getNetworkInterface()->equals(otherInterface));
+
+    CHECK_TRUE(routingTable->removeEntry(dest1, nodeB, otherInterface));
+    CHECK(routingTable->getAllRoutesThatLeadOver(nodeB).empty());
+}
+
 /**
  * This test checks if an evaporation can delete elements from the routing table.
  * Also I want to know if there are any internal problems with the iterators when
@@ -555,3 +590,453 @@ TEST(RoutingTableTest, doNotReturnSourceOrSenderOfAPacketAsPossibleNextHop) {
     CHECK(nextHop->equals(possibleHop->getAddress()));
     CHECK_EQUAL(interface, possibleHop->getNetworkInterface());
 }
+
+TEST(RoutingTableTest, lazyEvaporationIsAppliedOnLookup) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    routingTable->setLazyEvaporation(true);
+    CHECK_TRUE(routingTable->isLazyEvaporationActivated());
+
+    routingTable->triggerEvaporation();
+    routingTable->update(destination, nodeA, interface, 2.5);
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    // the route to B is younger and must only be evaporated by its own age
+    routingTable->update(destination, nodeB, interface, 3.8);
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    DOUBLES_EQUAL(2.5 * evaporationFactor * evaporationFactor, routingTable->getPheromoneValue(destination, nodeA, interface), 0.00001);
+    DOUBLES_EQUAL(3.8 * evaporationFactor, routingTable->getPheromoneValue(destination, nodeB, interface), 0.00001);
+
+    // looking the value up again must not evaporate it twice
+    DOUBLES_EQUAL(3.8 * evaporationFactor, routingTable->getPheromoneValue(destination, nodeB, interface), 0.00001);
+}
+
+TEST(RoutingTableTest, lazyEvaporationRemovesEvaporatedRoutesOnLookup) {
+    AddressPtr destination (new AddressMock("Destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    routingTable->setLazyEvaporation(true);
+
+    routingTable->triggerEvaporation();
+    routingTable->update(destination, nodeA, interface, 0.6);
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+
+    // 0.6 * 0.8 is below the threshold of the evaporation policy
+    CHECK_FALSE(routingTable->isDeliverable(destination));
+    BYTES_EQUAL(0, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nodeA).empty());
+}
+
+TEST(RoutingTableTest, lazyEvaporationRemovesRoutesThatAreNotLookedUpAnymore) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->setLazyEvaporation(true);
+
+    routingTable->triggerEvaporation();
+    for (int i = 0; i < 100; i++) {
+        AddressPtr destination (new AddressMock("destination" + std::to_string(i)));
+        routingTable->update(destination, nextHop, interface, 2);
+    }
+    BYTES_EQUAL(100, routingTable->getTotalNumberOfEntries());
+
+    // the background pass only visits a few buckets per call
+    TimeMock::letTimePass(100000);
+    routingTable->triggerEvaporation();
+    CHECK(routingTable->getTotalNumberOfEntries() > 0);
+
+    for (int i = 0; i < 1000; i++) {
+        routingTable->triggerEvaporation();
+    }
+    BYTES_EQUAL(0, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nextHop).empty());
+}
+
+TEST(RoutingTableTest, incrementalEvaporationReachesTheSameValuesAsTheFullSweep) {
+    RoutingTable referenceTable;
+    referenceTable.setEvaporationPolicy(evaporationPolicy);
+    routingTable->setMaxNrOfBucketsPerEvaporation(2);
+    BYTES_EQUAL(2, routingTable->getMaxNrOfBucketsPerEvaporation());
+
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    std::deque<AddressPtr> destinations;
+    for (int i = 0; i < 50; i++) {
+        destinations.push_back(AddressPtr(new AddressMock("destination" + std::to_string(i))));
+    }
+
+    routingTable->triggerEvaporation();
+    referenceTable.triggerEvaporation();
+    for (auto& destination: destinations) {
+        routingTable->update(destination, nextHop, interface, 10);
+        referenceTable.update(destination, nextHop, interface, 10);
+    }
+
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->triggerEvaporation();
+    referenceTable.triggerEvaporation();
+
+    // only a few buckets have been evaporated so far
+    int nrOfEvaporatedEntries = 0;
+    for (auto& destination: destinations) {
+        if (routingTable->getPheromoneValue(destination, nextHop, interface) < 10) {
+            nrOfEvaporatedEntries++;
+        }
+    }
+    CHECK(nrOfEvaporatedEntries < 50);
+
+    // now let the sweeper finish a whole round
+    for (int i = 0; i < 1000; i++) {
+        routingTable->triggerEvaporation();
+    }
+
+    for (auto& destination: destinations) {
+        DOUBLES_EQUAL(referenceTable.getPheromoneValue(destination, nextHop, interface), routingTable->getPheromoneValue(destination, nextHop, interface), 0.00001);
+    }
+}
+
+TEST(RoutingTableTest, incrementalEvaporationRemovesEntries) {
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    routingTable->setMaxNrOfBucketsPerEvaporation(1);
+
+    routingTable->triggerEvaporation();
+    routingTable->update(nodeA, nodeB, interface, 2);
+    routingTable->update(nodeB, nodeA, interface, 2);
+
+    TimeMock::letTimePass(100000);
+    for (int i = 0; i < 100; i++) {
+        routingTable->triggerEvaporation();
+    }
+    BYTES_EQUAL(0, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nodeA).empty());
+    CHECK(routingTable->getAllRoutesThatLeadOver(nodeB).empty());
+}
+
+TEST(RoutingTableTest, iterateOverAllEntries) {
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+
+    CHECK(routingTable->begin() == routingTable->end());
+
+    routingTable->update(nodeA, nodeB, interface, 1);
+    routingTable->update(nodeA, nodeC, interface, 2);
+    routingTable->update(nodeB, nodeC, interface, 4);
+    routingTable->update(nodeC, nodeA, interface, 8);
+
+    // each entry is visited exactly once and in the same order as by getEntryAt
+    int position = 0;
+    float sumOfPheromoneValues = 0;
+    for (auto tupel: *routingTable) {
+        RoutingTableEntryTupel expectedTupel = routingTable->getEntryAt(position);
+        CHECK(tupel.destination->equals(expectedTupel.destination));
+        CHECK(tupel.entry == expectedTupel.entry);
+        sumOfPheromoneValues += tupel.entry->getPheromoneValue();
+        position++;
+    }
+    CHECK_EQUAL(4, position);
+    CHECK_EQUAL(15, sumOfPheromoneValues);
+}
+
+TEST(RoutingTableTest, forEachEntry) {
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+
+    routingTable->update(nodeA, nodeB, interface, 1);
+    routingTable->update(nodeA, nodeC, interface, 2);
+    routingTable->update(nodeB, nodeC, interface, 4);
+
+    int nrOfRoutesToA = 0;
+    float sumOfPheromoneValues = 0;
+    routingTable->forEachEntry([&](const AddressPtr& destination, RoutingTableEntry* entry) {
+        if (destination->equals(nodeA)) {
+            nrOfRoutesToA++;
+        }
+        sumOfPheromoneValues += entry->getPheromoneValue();
+    });
+    CHECK_EQUAL(2, nrOfRoutesToA);
+    CHECK_EQUAL(7, sumOfPheromoneValues);
+}
+
+TEST(RoutingTableTest, leastRecentlyUpdatedRouteIsEvictedIfTableIsFull) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+    AddressPtr destination3 (new AddressMock("3"));
+    AddressPtr destination4 (new AddressMock("4"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setPheromoneAwareEviction(false);
+    routingTable->setMaxNrOfEntries(3);
+
+    routingTable->update(destination1, nextHop, interface, 1);
+    routingTable->update(destination2, nextHop, interface, 2);
+    routingTable->update(destination3, nextHop, interface, 3);
+    CHECK_EQUAL(3, routingTable->getTotalNumberOfEntries());
+    CHECK(listener.evictedDestinations.empty());
+
+    // updating an existing route does not evict anything but makes it the most recently updated one
+    routingTable->update(destination1, nextHop, interface, 5);
+    CHECK(listener.evictedDestinations.empty());
+
+    routingTable->update(destination4, nextHop, interface, 4);
+    CHECK_EQUAL(3, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->isDeliverable(destination2) == false);
+    CHECK(routingTable->exists(destination1, nextHop, interface));
+    CHECK(routingTable->exists(destination3, nextHop, interface));
+    CHECK(routingTable->exists(destination4, nextHop, interface));
+
+    BYTES_EQUAL(1, listener.evictedDestinations.size());
+    CHECK(listener.evictedDestinations.front()->equals(destination2));
+    CHECK(listener.evictedNextHops.front()->equals(nextHop));
+}
+
+/**
+ * Looks at the table while it is notified about an evicted route.
+ */
+class QueryingRouteEvictionListener : public RouteEvictionListener {
+    public:
+        QueryingRouteEvictionListener(RoutingTable* routingTable, AddressPtr newDestination) : routingTable(routingTable), newDestination(newDestination) {}
+
+        void routeHasBeenEvicted(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+            nrOfNotifications++;
+            nrOfEntries = routingTable->getTotalNumberOfEntries();
+            evictedRouteExists = routingTable->exists(destination, nextHop, interface);
+            newRouteExists = routingTable->isDeliverable(newDestination);
+        }
+
+        RoutingTable* routingTable;
+        AddressPtr newDestination;
+        unsigned int nrOfNotifications = 0;
+        unsigned int nrOfEntries = 0;
+        bool evictedRouteExists = true;
+        bool newRouteExists = false;
+};
+
+TEST(RoutingTableTest, evictionListenerIsNotifiedAfterTheNewRouteHasBeenInserted) {
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    AddressPtr destination1 (new AddressMock("1"));
+    AddressPtr destination2 (new AddressMock("2"));
+    AddressPtr destination3 (new AddressMock("3"));
+    QueryingRouteEvictionListener listener (routingTable, destination3);
+    routingTable->setEvictionListener(&listener);
+    routingTable->setMaxNrOfEntries(2);
+
+    routingTable->update(destination1, nextHop, interface, 1);
+    routingTable->update(destination2, nextHop, interface, 2);
+    RouteHandle route = routingTable->findRoute(destination3, nextHop, interface);
+    route.setPheromoneValue(3);
+
+    BYTES_EQUAL(1, listener.nrOfNotifications);
+    BYTES_EQUAL(2, listener.nrOfEntries);
+    CHECK_FALSE(listener.evictedRouteExists);
+    CHECK_TRUE(listener.newRouteExists);
+}
+
+TEST(RoutingTableTest, routeWithLowestPheromoneValueIsEvictedIfTableIsFull) {
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    RouteEvictionListenerMock listener;
+    routingTable->setEvictionListener(&listener);
+    routingTable->setMaxNrOfEntries(2);
+
+    routingTable->update(destination, nodeA, interface, 10);
+    RouteHandle route = routingTable->findRoute(destination, nodeB, interface);
+    route.setPheromoneValue(1);
+    route = routingTable->findRoute(destination, nodeC, interface);
+    route.setPheromoneValue(5);
+
+    CHECK_EQUAL(2, routingTable->getTotalNumberOfEntries());
+    CHECK(routingTable->exists(destination, nodeA, interface));
+    CHECK(routingTable->exists(destination, nodeB, interface) == false);
+    CHECK_EQUAL(5, routingTable->getPheromoneValue(destination, nodeC, interface));
+    BYTES_EQUAL(1, listener.evictedNextHops.size());
+    CHECK(listener.evictedNextHops.front()->equals(nodeB));
+}
+
+/**
+ * Resolves the addresses of a snapshot to AddressMocks and knows a fixed list of interfaces.
+ */
+class RouteSnapshotResolverMock : public RouteSnapshotResolver {
+    public:
+        AddressPtr resolveAddress(const std::string& address) {
+            return AddressPtr(new AddressMock(address));
+        }
+
+        NetworkInterface* resolveInterface(AddressPtr localAddress) {
+            for (auto& interface: interfaces) {
+                if (interface->getLocalAddress()->equals(localAddress)) {
+                    return interface;
+                }
+            }
+            return nullptr;
+        }
+
+        std::deque<NetworkInterface*> interfaces;
+};
+
+TEST(RoutingTableTest, restoreRoutesFromSnapshot) {
+    const std::string snapshotFile = "RoutingTableTest.snapshot";
+    AddressPtr destination1 (new AddressMock("destination1"));
+    AddressPtr destination2 (new AddressMock("destination2"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    NetworkInterfaceMock* otherInterface = client->createNewNetworkInterfaceMock("otherInterface");
+    RouteSnapshotResolverMock resolver;
+    resolver.interfaces.push_back(interface);
+    resolver.interfaces.push_back(otherInterface);
+
+    routingTable->update(destination1, nodeA, interface, 2.5);
+    routingTable->update(destination1, nodeB, otherInterface, 1.5);
+    routingTable->update(destination2, nodeA, interface, 3);
+    routingTable->snapshot(snapshotFile);
+
+    RoutingTable restoredTable;
+    restoredTable.setEvaporationPolicy(evaporationPolicy);
+    BYTES_EQUAL(3, restoredTable.restore(snapshotFile, &resolver));
+    std::remove(snapshotFile.c_str());
+
+    BYTES_EQUAL(3, restoredTable.getTotalNumberOfEntries());
+    DOUBLES_EQUAL(2.5, restoredTable.getPheromoneValue(destination1, nodeA, interface), 0.00001);
+    DOUBLES_EQUAL(1.5, restoredTable.getPheromoneValue(destination1, nodeB, otherInterface), 0.00001);
+    DOUBLES_EQUAL(3, restoredTable.getPheromoneValue(destination2, nodeA, interface), 0.00001);
+    BYTES_EQUAL(2, restoredTable.getAllRoutesThatLeadOver(nodeA).size());
+}
+
+TEST(RoutingTableTest, restoredRoutesAreEvaporatedByTheirAge) {
+    const std::string snapshotFile = "RoutingTableTest.snapshot";
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    RouteSnapshotResolverMock resolver;
+    resolver.interfaces.push_back(interface);
+
+    routingTable->triggerEvaporation();
+    routingTable->update(destination, nodeA, interface, 2.5);
+    routingTable->update(destination, nodeB, interface, 0.6);
+    TimeMock::letTimePass(evaporationPolicy->getTimeInterval());
+    routingTable->snapshot(snapshotFile);
+
+    RoutingTable restoredTable;
+    restoredTable.setEvaporationPolicy(evaporationPolicy);
+    // 0.6 * 0.8 is below the threshold of the evaporation policy
+    BYTES_EQUAL(1, restoredTable.restore(snapshotFile, &resolver));
+    std::remove(snapshotFile.c_str());
+
+    float evaporationFactor = evaporationPolicy->getEvaporationFactor();
+    // the (real) time between taking and restoring the snapshot is added to the age
+    DOUBLES_EQUAL(2.5 * evaporationFactor, restoredTable.getPheromoneValue(destination, nodeA, interface), 0.01);
+    CHECK_FALSE(restoredTable.exists(destination, nodeB, interface));
+}
+
+TEST(RoutingTableTest, routesOverUnknownInterfacesAreNotRestored) {
+    const std::string snapshotFile = "RoutingTableTest.snapshot";
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    NetworkInterfaceMock* otherInterface = client->createNewNetworkInterfaceMock("otherInterface");
+    RouteSnapshotResolverMock resolver;
+    resolver.interfaces.push_back(interface);
+
+    routingTable->update(destination, nodeA, interface, 2);
+    routingTable->update(destination, nodeB, otherInterface, 2);
+    routingTable->snapshot(snapshotFile);
+
+    RoutingTable restoredTable;
+    restoredTable.setEvaporationPolicy(evaporationPolicy);
+    BYTES_EQUAL(1, restoredTable.restore(snapshotFile, &resolver));
+    std::remove(snapshotFile.c_str());
+
+    CHECK(restoredTable.exists(destination, nodeA, interface));
+    CHECK_FALSE(restoredTable.exists(destination, nodeB, otherInterface));
+}
+
+TEST(RoutingTableTest, restoreThrowsExceptionForInvalidSnapshots) {
+    const std::string snapshotFile = "RoutingTableTest.snapshot";
+    RouteSnapshotResolverMock resolver;
+
+    try {
+        routingTable->restore("doesNotExist.snapshot", &resolver);
+        FAIL("Restoring a snapshot that does not exist should throw an exception");
+    } catch (Exception& exception) {
+        // this is expected
+    }
+
+    std::ofstream file(snapshotFile);
+    file << "this is not a routing table snapshot";
+    file.close();
+    try {
+        routingTable->restore(snapshotFile, &resolver);
+        FAIL("Restoring an invalid snapshot should throw an exception");
+    } catch (Exception& exception) {
+        // this is expected
+    }
+    std::remove(snapshotFile.c_str());
+    BYTES_EQUAL(0, routingTable->getTotalNumberOfEntries());
+}
+
+/**
+ * An alternative table layout which does not override any of the methods of the standard layout.
+ */
+class IncompleteRoutingTable : public RoutingTable {
+    public:
+        IncompleteRoutingTable() : RoutingTable(false) {}
+};
+
+TEST(RoutingTableTest, alternativeLayoutsThatDoNotOverrideAMethodThrowAnException) {
+    IncompleteRoutingTable incompleteTable;
+    AddressPtr destination (new AddressMock("destination"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+
+    try {
+        incompleteTable.update(destination, nextHop, interface, 1);
+        FAIL("Updating a route should throw an exception");
+    } catch (Exception& exception) {
+        // this is expected
+    }
+
+    try {
+        incompleteTable.isDeliverable(destination);
+        FAIL("Looking up a destination should throw an exception");
+    } catch (Exception& exception) {
+        // this is expected
+    }
+
+    try {
+        incompleteTable.getTotalNumberOfEntries();
+        FAIL("Counting the routes should throw an exception");
+    } catch (Exception& exception) {
+        // this is expected
+    }
+}
+
+TEST(RoutingTableTest, allRoutesAreEvaporatedInOneBatch) {
+    BatchCountingEvaporationPolicyMock batchCountingPolicy;
+    RoutingTable table;
+    table.setEvaporationPolicy(&batchCountingPolicy);
+    AddressPtr nodeA (new AddressMock("A"));
+    AddressPtr nodeB (new AddressMock("B"));
+    AddressPtr nodeC (new AddressMock("C"));
+    table.update(nodeA, nodeB, interface, 2);
+    table.update(nodeA, nodeC, interface, 0.6);
+    table.update(nodeB, nodeC, interface, 4);
+    table.update(nodeC, nodeA, interface, 0.6);
+    table.triggerEvaporation();
+
+    TimeMock::letTimePass(batchCountingPolicy.getTimeInterval());
+    table.triggerEvaporation();
+    BYTES_EQUAL(1, batchCountingPolicy.nrOfBatches);
+    BYTES_EQUAL(4, batchCountingPolicy.nrOfBatchedValues);
+
+    // the values are written back to the right routes
+    BYTES_EQUAL(2, table.getTotalNumberOfEntries());
+    DOUBLES_EQUAL(2 * batchCountingPolicy.getEvaporationFactor(), table.getPheromoneValue(nodeA, nodeB, interface), 0.00001);
+    DOUBLES_EQUAL(4 * batchCountingPolicy.getEvaporationFactor(), table.getPheromoneValue(nodeB, nodeC, interface), 0.00001);
+    CHECK_FALSE(table.isDeliverable(nodeC));
+}
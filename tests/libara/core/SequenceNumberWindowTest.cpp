@@ -0,0 +1,110 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "SequenceNumberWindow.h"
+
+using namespace ARA;
+
+TEST_GROUP(SequenceNumberWindowTest) {};
+
+TEST(SequenceNumberWindowTest, emptyWindowContainsNothing) {
+    SequenceNumberWindow window;
+    CHECK_FALSE(window.contains(0));
+    CHECK_FALSE(window.contains(1));
+    CHECK_FALSE(window.contains(4294967295u));
+}
+
+TEST(SequenceNumberWindowTest, insertedSequenceNumbersAreContained) {
+    SequenceNumberWindow window;
+    window.insert(10);
+    window.insert(12);
+    window.insert(11);
+
+    CHECK_TRUE(window.contains(10));
+    CHECK_TRUE(window.contains(11));
+    CHECK_TRUE(window.contains(12));
+    CHECK_FALSE(window.contains(9));
+    CHECK_FALSE(window.contains(13));
+    CHECK_FALSE(window.contains(1000));
+}
+
+TEST(SequenceNumberWindowTest, sequenceNumbersMayArriveOutOfOrder) {
+    SequenceNumberWindow window;
+    window.insert(500);
+    window.insert(100);
+
+    CHECK_TRUE(window.contains(100));
+    CHECK_TRUE(window.contains(500));
+    CHECK_FALSE(window.contains(101));
+    CHECK_FALSE(window.contains(499));
+}
+
+TEST(SequenceNumberWindowTest, oldSequenceNumbersFallOutOfTheWindow) {
+    SequenceNumberWindow window;
+    window.insert(1);
+    window.insert(SequenceNumberWindow::SIZE);
+    CHECK_TRUE(window.contains(1));
+
+    CHECK_FALSE(window.isOutdated(1));
+
+    // 1 is now too old to tell, so it is neither contained nor inserted again
+    window.insert(SequenceNumberWindow::SIZE + 1);
+    CHECK_TRUE(window.isOutdated(1));
+    CHECK_TRUE(window.isOutdated(0));
+    CHECK_FALSE(window.contains(1));
+    CHECK_FALSE(window.contains(0));
+    window.insert(1);
+    CHECK_FALSE(window.contains(1));
+    CHECK_FALSE(window.isOutdated(2));
+
+    // the bit of 1 is reused for SIZE + 1 and the others must have been cleared
+    CHECK_TRUE(window.contains(SequenceNumberWindow::SIZE + 1));
+    CHECK_FALSE(window.contains(2));
+    CHECK_FALSE(window.contains(SequenceNumberWindow::SIZE + 2));
+}
+
+TEST(SequenceNumberWindowTest, movingTheWindowClearsReusedBits) {
+    SequenceNumberWindow window;
+    for (unsigned int i = 0; i < SequenceNumberWindow::SIZE; i++) {
+        window.insert(i);
+    }
+
+    window.insert(SequenceNumberWindow::SIZE + 10);
+    for (unsigned int i = SequenceNumberWindow::SIZE; i < SequenceNumberWindow::SIZE + 10; i++) {
+        CHECK_FALSE(window.contains(i));
+    }
+    CHECK_TRUE(window.contains(SequenceNumberWindow::SIZE + 10));
+    for (unsigned int i = 11; i < SequenceNumberWindow::SIZE; i++) {
+        CHECK_TRUE(window.contains(i));
+    }
+
+    // the cleared range crosses the end of the ring buffer and several words
+    window.insert(2 * SequenceNumberWindow::SIZE - 5);
+    CHECK_TRUE(window.contains(SequenceNumberWindow::SIZE + 10));
+    for (unsigned int i = SequenceNumberWindow::SIZE + 11; i < 2 * SequenceNumberWindow::SIZE - 5; i++) {
+        CHECK_FALSE(window.contains(i));
+    }
+
+    // a jump over more than the whole window forgets everything
+    unsigned int farAway = 10 * SequenceNumberWindow::SIZE;
+    window.insert(farAway);
+    CHECK_TRUE(window.contains(farAway));
+    CHECK_FALSE(window.contains(farAway - 1));
+    CHECK_FALSE(window.contains(farAway - SequenceNumberWindow::SIZE + 1));
+}
+
+TEST(SequenceNumberWindowTest, sequenceNumbersWrapAround) {
+    SequenceNumberWindow window;
+    window.insert(4294967290u);
+    window.insert(4294967295u);
+    window.insert(3);
+
+    CHECK_TRUE(window.contains(4294967290u));
+    CHECK_TRUE(window.contains(4294967295u));
+    CHECK_TRUE(window.contains(3));
+    CHECK_FALSE(window.contains(0));
+    CHECK_FALSE(window.contains(4294967294u));
+    CHECK_FALSE(window.contains(4));
+}
@@ -0,0 +1,68 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "EvaporationKernels.h"
+
+using namespace ARA;
+
+TEST_GROUP(EvaporationKernelsTest) {
+    EvaporationKernels::InstructionSet originalInstructionSet;
+
+    void setup() {
+        originalInstructionSet = EvaporationKernels::getInstructionSet();
+    }
+
+    void teardown() {
+        EvaporationKernels::setInstructionSet(originalInstructionSet);
+    }
+};
+
+TEST(EvaporationKernelsTest, allInstructionSetsLeadToTheSameValues) {
+    // 21 values do not fill a whole number of SSE or AVX2 vectors
+    const int nrOfValues = 21;
+    float expectedMultiplication[nrOfValues];
+    float expectedSubtraction[nrOfValues];
+    EvaporationKernels::setInstructionSet(EvaporationKernels::SCALAR);
+    CHECK(EvaporationKernels::getInstructionSet() == EvaporationKernels::SCALAR);
+    for (int i = 0; i < nrOfValues; i++) {
+        expectedMultiplication[i] = i * 0.25;
+        expectedSubtraction[i] = i * 0.25;
+    }
+    EvaporationKernels::multiply(expectedMultiplication, nrOfValues, 0.8, 1);
+    EvaporationKernels::subtract(expectedSubtraction, nrOfValues, 1.5, 1);
+
+    EvaporationKernels::InstructionSet instructionSets[] = {EvaporationKernels::SSE, EvaporationKernels::AVX2};
+    for (auto instructionSet : instructionSets) {
+        EvaporationKernels::setInstructionSet(instructionSet);
+        float multipliedValues[nrOfValues];
+        float subtractedValues[nrOfValues];
+        for (int i = 0; i < nrOfValues; i++) {
+            multipliedValues[i] = i * 0.25;
+            subtractedValues[i] = i * 0.25;
+        }
+
+        EvaporationKernels::multiply(multipliedValues, nrOfValues, 0.8, 1);
+        EvaporationKernels::subtract(subtractedValues, nrOfValues, 1.5, 1);
+        for (int i = 0; i < nrOfValues; i++) {
+            DOUBLES_EQUAL(expectedMultiplication[i], multipliedValues[i], 0);
+            DOUBLES_EQUAL(expectedSubtraction[i], subtractedValues[i], 0);
+        }
+    }
+}
+
+TEST(EvaporationKernelsTest, valuesBelowTheThresholdAreSetToZero) {
+    float values[] = {1, 2, 3, 4, 5};
+    EvaporationKernels::subtract(values, 5, 2.5, 1);
+    DOUBLES_EQUAL(0, values[0], 0);
+    DOUBLES_EQUAL(0, values[1], 0);
+    DOUBLES_EQUAL(0, values[2], 0);
+    DOUBLES_EQUAL(1.5, values[3], 0);
+    DOUBLES_EQUAL(2.5, values[4], 0);
+}
+
+TEST(EvaporationKernelsTest, unsupportedInstructionSetsAreNotUsed) {
+    EvaporationKernels::setInstructionSet(EvaporationKernels::AVX2);
+    CHECK(EvaporationKernels::getInstructionSet() == EvaporationKernels::getSupportedInstructionSet());
+}
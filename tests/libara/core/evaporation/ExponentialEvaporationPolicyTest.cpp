@@ -75,3 +75,20 @@ TEST(ExponentialEvaporationPolicyTest, sequentialVsContinuousEvaporation) {
 
     DOUBLES_EQUAL(evaporationInOneStep, evaporationInMultipleSteps, 0.00001);
 }
+
+TEST(ExponentialEvaporationPolicyTest, batchEvaporationLeadsToTheSameValues) {
+    ExponentialEvaporationPolicy policy = ExponentialEvaporationPolicy(0.9, 2000, 0.75);
+    float pheromoneValues[19];
+    for (int i = 0; i < 19; i++) {
+        pheromoneValues[i] = 0.5 + i * 0.1;
+    }
+
+    policy.evaporate(pheromoneValues, 19, 3000);
+    for (int i = 0; i < 19; i++) {
+        DOUBLES_EQUAL(policy.evaporate(0.5 + i * 0.1, 3000), pheromoneValues[i], 0.00001);
+    }
+
+    // nothing should happen if no time has passed
+    policy.evaporate(pheromoneValues, 19, 0);
+    DOUBLES_EQUAL(policy.evaporate(2.3, 3000), pheromoneValues[18], 0.00001);
+}
@@ -47,3 +47,20 @@ TEST(LinearEvaporationPolicyTest, evaporateWithZeroTimeInterval) {
     pheromone = policy.evaporate(pheromone, 0);
     DOUBLES_EQUAL(10, pheromone, 0.00001);
 }
+
+TEST(LinearEvaporationPolicyTest, batchEvaporationLeadsToTheSameValues) {
+    LinearEvaporationPolicy policy = LinearEvaporationPolicy(0.25, 0.75, 1000);
+    float pheromoneValues[19];
+    for (int i = 0; i < 19; i++) {
+        pheromoneValues[i] = 0.5 + i * 0.1;
+    }
+
+    policy.evaporate(pheromoneValues, 19, 1500);
+    for (int i = 0; i < 19; i++) {
+        DOUBLES_EQUAL(policy.evaporate(0.5 + i * 0.1, 1500), pheromoneValues[i], 0.00001);
+    }
+
+    // nothing should happen if no time has passed
+    policy.evaporate(pheromoneValues, 19, 0);
+    DOUBLES_EQUAL(policy.evaporate(2.3, 1500), pheromoneValues[18], 0.00001);
+}
@@ -107,3 +107,25 @@ TEST(StochasticForwardingPolicyTest, neverChooseTheSenderOfAPacket) {
         CHECK(nextHop->getAddress()->equals(packet.getSender()) == false);
     }
 }
+
+TEST(StochasticForwardingPolicyTest, sameSeedLeadsToSameDecisions) {
+    PacketMock packet = PacketMock();
+    AddressPtr route1 (new AddressMock("A"));
+    AddressPtr route2 (new AddressMock("B"));
+    AddressPtr route3 (new AddressMock("C"));
+
+    routingTable->update(packet.getDestination(), route1, interface, 3.0);
+    routingTable->update(packet.getDestination(), route2, interface, 6.0);
+    routingTable->update(packet.getDestination(), route3, interface, 1.0);
+
+    StochasticForwardingPolicy policy = StochasticForwardingPolicy(routingTable);
+    StochasticForwardingPolicy otherPolicy = StochasticForwardingPolicy(routingTable);
+    policy.initializeRandomNumberGenerator(42, 3);
+    otherPolicy.initializeRandomNumberGenerator(42, 3);
+
+    for (int i = 0; i < 100; i++) {
+        NextHop* nextHop = policy.getNextHop(&packet);
+        NextHop* otherNextHop = otherPolicy.getNextHop(&packet);
+        CHECK(nextHop->getAddress()->equals(otherNextHop->getAddress()));
+    }
+}
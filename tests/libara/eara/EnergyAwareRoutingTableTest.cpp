@@ -7,6 +7,7 @@
 #include "testAPI/mocks/EARAClientMock.h"
 #include "testAPI/mocks/NetworkInterfaceMock.h"
 #include "testAPI/mocks/AddressMock.h"
+#include "testAPI/mocks/PacketMock.h"
 
 #include <deque>
 
@@ -61,3 +62,58 @@ TEST(EnergyAwareRoutingTableTest, updateEnergyValue) {
     DOUBLES_EQUAL(pheromoneValue, routingTable->getPheromoneValue(destination, nextHop, interface), 0.0001);
     DOUBLES_EQUAL(energyValue, routingTable->getEnergyValue(destination, nextHop, interface), 0.0001);
 }
+
+TEST(EnergyAwareRoutingTableTest, iterateOverAllEntries) {
+    AddressPtr destination1 (new AddressMock("destination1"));
+    AddressPtr destination2 (new AddressMock("destination2"));
+    AddressPtr nextHop (new AddressMock("nextHop"));
+    routingTable->update(destination1, nextHop, interface, 10, 1);
+    routingTable->update(destination2, nextHop, interface, 20, 2);
+
+    float sumOfEnergyValues = 0;
+    int nrOfEntries = 0;
+    for (EnergyAwareRoutingTable::const_iterator iterator = routingTable->begin(); iterator != routingTable->end(); ++iterator) {
+        EARARoutingTableEntryTupel tupel = *iterator;
+        CHECK(tupel.entry->getAddress()->equals(nextHop));
+        sumOfEnergyValues += tupel.entry->getEnergyValue();
+        nrOfEntries++;
+    }
+    CHECK_EQUAL(2, nrOfEntries);
+    CHECK_EQUAL(3, sumOfEnergyValues);
+
+    sumOfEnergyValues = 0;
+    routingTable->forEachEntry([&](const AddressPtr& destination, EARARoutingTableEntry* entry) {
+        sumOfEnergyValues += entry->getEnergyValue();
+    });
+    CHECK_EQUAL(3, sumOfEnergyValues);
+}
+
+TEST(EnergyAwareRoutingTableTest, fitnessWeighting) {
+    PacketMock packet = PacketMock("source", "destination", "sender");
+    AddressPtr destination = packet.getDestination();
+    AddressPtr nextHopA (new AddressMock("A"));
+    AddressPtr nextHopB (new AddressMock("B"));
+
+    routingTable->activateFitnessWeighting(WeightedFitness(1, 2));
+    CHECK_TRUE(routingTable->isFitnessWeightingActivated(WeightedFitness(1, 2)));
+    CHECK_FALSE(routingTable->isFitnessWeightingActivated(WeightedFitness(1, 1)));
+
+    routingTable->update(destination, nextHopA, interface, 4, 1);
+    routingTable->update(destination, nextHopB, interface, 1, 2);
+    NextHopCandidates candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0.4)->getAddress()->equals(nextHopA));
+    CHECK(candidates.sample(0.6)->getAddress()->equals(nextHopB));
+
+    // the cached fitness must be calculated again if the energy changes
+    routingTable->updateEnergyValue(destination, nextHopB, interface, 3);
+    candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0.3)->getAddress()->equals(nextHopA));
+    CHECK(candidates.sample(0.4)->getAddress()->equals(nextHopB));
+
+    // without the fitness weighting only the pheromone values count
+    routingTable->deactivateFitnessWeighting();
+    CHECK_FALSE(routingTable->isFitnessWeightingActivated());
+    candidates = routingTable->getNextHopCandidates(&packet);
+    CHECK(candidates.sample(0.7)->getAddress()->equals(nextHopA));
+    CHECK(candidates.sample(0.9)->getAddress()->equals(nextHopB));
+}
@@ -0,0 +1,51 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "WeightedFitness.h"
+
+#include <cmath>
+
+using namespace ARA;
+
+TEST_GROUP(WeightedFitnessTest) {
+    void checkFitness(float pheromoneWeight, float energyWeight) {
+        WeightedFitness fitness = WeightedFitness(pheromoneWeight, energyWeight);
+        float values[] = {0, 0.3, 1, 2.5, 7, 10};
+        for (float pheromoneValue: values) {
+            for (float energyValue: values) {
+                float expectedFitness = std::pow(pheromoneValue, pheromoneWeight) * std::pow(energyValue, energyWeight);
+                DOUBLES_EQUAL(expectedFitness, fitness.calculate(pheromoneValue, energyValue), expectedFitness * 0.00001);
+            }
+        }
+    }
+};
+
+TEST(WeightedFitnessTest, integerWeights) {
+    checkFitness(1, 2);
+    checkFitness(0, 1);
+    checkFitness(3, 8);
+}
+
+TEST(WeightedFitnessTest, halfIntegerWeights) {
+    checkFitness(0.5, 1.5);
+    checkFitness(2.5, 4.5);
+}
+
+TEST(WeightedFitnessTest, otherWeights) {
+    checkFitness(0.3, 1.7);
+    checkFitness(9, 12.5);
+}
+
+TEST(WeightedFitnessTest, changeWeights) {
+    WeightedFitness fitness = WeightedFitness();
+    DOUBLES_EQUAL(1, fitness.getPheromoneWeight(), 0);
+    DOUBLES_EQUAL(2, fitness.getEnergyWeight(), 0);
+    CHECK(fitness == WeightedFitness(1, 2));
+
+    fitness.setPheromoneWeight(0.5);
+    fitness.setEnergyWeight(3);
+    CHECK(fitness != WeightedFitness(1, 2));
+    DOUBLES_EQUAL(2 * 27, fitness.calculate(4, 3), 0.0001);
+}
@@ -0,0 +1,58 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "CppUTest/TestHarness.h"
+#include "RandomNumberGenerator.h"
+
+using namespace ARA;
+
+TEST_GROUP(RandomNumberGeneratorTest) {};
+
+TEST(RandomNumberGeneratorTest, producesReferenceSequence) {
+    // the first numbers of the PCG32 reference implementation for seed 42 on stream 54
+    RandomNumberGenerator generator = RandomNumberGenerator(42, 54);
+    CHECK(generator.next() == 0xa15c02b7);
+    CHECK(generator.next() == 0x7b47f409);
+    CHECK(generator.next() == 0xba1d3330);
+    CHECK(generator.next() == 0x83d2f293);
+    CHECK(generator.next() == 0xbfa4784b);
+    CHECK(generator.next() == 0xcbed606e);
+}
+
+TEST(RandomNumberGeneratorTest, sameSeedAndStreamLeadToSameSequence) {
+    RandomNumberGenerator generator = RandomNumberGenerator(1234, 5);
+    RandomNumberGenerator otherGenerator = RandomNumberGenerator();
+    otherGenerator.next();
+    otherGenerator.seed(1234, 5);
+
+    for (int i = 0; i < 100; i++) {
+        CHECK(generator.next() == otherGenerator.next());
+    }
+}
+
+TEST(RandomNumberGeneratorTest, streamsAreIndependent) {
+    RandomNumberGenerator generator = RandomNumberGenerator(1234, 1);
+    RandomNumberGenerator otherGenerator = RandomNumberGenerator(1234, 2);
+
+    int nrOfEqualNumbers = 0;
+    for (int i = 0; i < 100; i++) {
+        if (generator.next() == otherGenerator.next()) {
+            nrOfEqualNumbers++;
+        }
+    }
+    CHECK(nrOfEqualNumbers < 2);
+}
+
+TEST(RandomNumberGeneratorTest, nextFloatIsUniformBetweenZeroAndOne) {
+    RandomNumberGenerator generator = RandomNumberGenerator(7);
+    int nrOfIterations = 10000;
+    double sum = 0;
+    for (int i = 0; i < nrOfIterations; i++) {
+        float randomNumber = generator.nextFloat();
+        CHECK(randomNumber >= 0);
+        CHECK(randomNumber < 1);
+        sum += randomNumber;
+    }
+    DOUBLES_EQUAL(0.5, sum / nrOfIterations, 0.02);
+}
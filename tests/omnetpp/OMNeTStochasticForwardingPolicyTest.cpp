@@ -21,7 +21,7 @@ TEST_GROUP(OMNeTStochasticForwardingPolicyTest) {};
 /*
 TEST(OMNeTStochasticForwardingPolicyTest, testGetRandomNumber) {
     // create a routing table without content 
-    RoutingTable routingTable = RoutingTable();
+    RoutingTable routingTable;
     // create a policy
     OMNeTStochasticForwardingPolicy policy(&routingTable);
     // try to get a random number
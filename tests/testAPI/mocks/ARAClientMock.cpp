@@ -94,21 +94,27 @@ void ARAClientMock::forget(AddressPtr neighbor) {
         routingTable->removeEntry(route.destination, neighbor, route.entry->getNetworkInterface());
     }
 
-    NeighborActivityMap::const_iterator foundNeighbor = neighborActivityTimes.find(neighbor);
-    if(foundNeighbor != neighborActivityTimes.end()) {
-        // delete the associated Time object first
-        delete foundNeighbor->second.first;
-        neighborActivityTimes.erase(neighbor);
+    PeerState* state = peerStates.find(neighbor);
+    if(state != nullptr) {
+        // delete the associated Time object so this is no longer a known neighbor
+        delete state->lastActivityTime;
+        state->lastActivityTime = nullptr;
+        forgetPeerIfUnused(neighbor);
     }
 }
 
 Timer* ARAClientMock::getPANTsTimer(AddressPtr destination) {
-    if (scheduledPANTs.find(destination) == scheduledPANTs.end()) {
+    PeerState* state = peerStates.find(destination);
+    if (state == nullptr) {
         return nullptr;
     }
     else {
-        return scheduledPANTs[destination];
+        return state->pantTimer;
     }
 }
 
+bool ARAClientMock::hasPeerState(AddressPtr peer) {
+    return peerStates.find(peer) != nullptr;
+}
+
 ARA_NAMESPACE_END
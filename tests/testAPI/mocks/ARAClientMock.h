@@ -55,6 +55,11 @@ public:
 
     Timer* getPANTsTimer(AddressPtr destination);
 
+    /**
+     * Returns true if the client still keeps a PeerState for the given node.
+     */
+    bool hasPeerState(AddressPtr peer);
+
     // make some methods public for testing purposes
     using AbstractARAClient::hasBeenReceivedEarlier;
     using AbstractARAClient::registerReceivedPacket;
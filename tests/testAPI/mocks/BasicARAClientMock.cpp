@@ -0,0 +1,50 @@
+/*
+ * $FU-Copyright$
+ */
+
+#include "BasicARAClientMock.h"
+#include "PacketFactory.h"
+
+ARA_NAMESPACE_BEGIN
+
+BasicARAClientMock::BasicARAClientMock(Configuration& configuration) : StaticARAClient(configuration) {
+    // nothing to do here
+}
+
+BasicConfiguration BasicARAClientMock::getStandardConfiguration() {
+    float initialPhi = 5.0;
+    float deltaPhi = 5.0;
+    RoutingTable* routingTable = new RoutingTableMock();
+    return BasicConfiguration(
+        routingTable,
+        new PacketFactory(15),
+        new ExponentialEvaporationPolicyMock(),
+        new LinearPathReinforcementPolicy(deltaPhi),
+        new BestPheromoneForwardingPolicy(routingTable),
+        initialPhi
+    );
+}
+
+void BasicARAClientMock::deliverToSystem(const Packet* packet) {
+    storeDeliveredPacket(packet);
+}
+
+void BasicARAClientMock::packetNotDeliverable(const Packet* packet) {
+    storeUndeliverablePacket(packet);
+}
+
+PacketTrap* BasicARAClientMock::getPacketTrap() {
+    return packetTrap;
+}
+
+RoutingTable* BasicARAClientMock::getRoutingTable() {
+    return routingTable;
+}
+
+NetworkInterfaceMock* BasicARAClientMock::createNewNetworkInterfaceMock(const std::string localAddressName) {
+    NetworkInterfaceMock* mock = AbstractClientMockBase::createNewNetworkInterfaceMock(localAddressName);
+    addNetworkInterface(mock);
+    return mock;
+}
+
+ARA_NAMESPACE_END
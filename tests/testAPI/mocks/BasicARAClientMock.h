@@ -0,0 +1,44 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef BASIC_ARA_CLIENT_MOCK_H_
+#define BASIC_ARA_CLIENT_MOCK_H_
+
+#include "ARAMacros.h"
+#include "BasicARAClient.h"
+#include "AbstractClientMockBase.h"
+#include "BasicConfiguration.h"
+#include "BestPheromoneForwardingPolicy.h"
+#include "LinearPathReinforcementPolicy.h"
+#include "NetworkInterfaceMock.h"
+#include "RoutingTableMock.h"
+#include "ExponentialEvaporationPolicyMock.h"
+
+#include <string>
+
+ARA_NAMESPACE_BEGIN
+
+typedef BasicARAClient<RoutingTableMock, BestPheromoneForwardingPolicy, LinearPathReinforcementPolicy, ExponentialEvaporationPolicyMock> StaticARAClient;
+
+/**
+ * A BasicARAClientMock implements the BasicARAClient with the same routing table and policies
+ * that are used by the ARAClientMock.
+ */
+class BasicARAClientMock: public StaticARAClient, public AbstractClientMockBase {
+public:
+    BasicARAClientMock(Configuration& configuration);
+
+    static BasicConfiguration getStandardConfiguration();
+
+    void deliverToSystem(const Packet* packet);
+    void packetNotDeliverable(const Packet* packet);
+
+    PacketTrap* getPacketTrap();
+    RoutingTable* getRoutingTable();
+    NetworkInterfaceMock* createNewNetworkInterfaceMock(const std::string localAddressName = "localhost");
+};
+
+ARA_NAMESPACE_END
+
+#endif
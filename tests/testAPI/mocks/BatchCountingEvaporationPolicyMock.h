@@ -0,0 +1,30 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef BATCH_COUNTING_EVAPORATION_POLICY_MOCK_H_
+#define BATCH_COUNTING_EVAPORATION_POLICY_MOCK_H_
+
+#include "ExponentialEvaporationPolicyMock.h"
+
+namespace ARA {
+
+/**
+ * Counts how often and with how many values the batch evaporation has been called.
+ */
+class BatchCountingEvaporationPolicyMock : public ExponentialEvaporationPolicyMock {
+    public:
+        using ExponentialEvaporationPolicyMock::evaporate;
+
+        void evaporate(float* pheromoneValues, size_t nrOfValues, int millisecondsSinceLastEvaporation) {
+            nrOfBatches++;
+            nrOfBatchedValues += nrOfValues;
+            ExponentialEvaporationPolicyMock::evaporate(pheromoneValues, nrOfValues, millisecondsSinceLastEvaporation);
+        }
+
+        unsigned int nrOfBatches = 0;
+        size_t nrOfBatchedValues = 0;
+};
+
+} /* namespace ARA */
+#endif /* BATCH_COUNTING_EVAPORATION_POLICY_MOCK_H_ */
@@ -100,8 +100,9 @@ EARAPacketFactory* EARAClientMock::getPacketFactory() {
 }
 
 TimerMock* EARAClientMock::getRouteDiscoveryDelayTimer(AddressPtr source) {
-    if (runningRouteDiscoveryDelayTimers.find(source) != runningRouteDiscoveryDelayTimers.end()) {
-        return (TimerMock*) runningRouteDiscoveryDelayTimers[source];
+    RouteDiscoveryDelayTimerMap::const_iterator found = runningRouteDiscoveryDelayTimers.find(AddressTable::getId(source));
+    if (found != runningRouteDiscoveryDelayTimers.end()) {
+        return (TimerMock*) found->second;
     }
     else {
         return nullptr;
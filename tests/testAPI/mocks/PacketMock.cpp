@@ -14,13 +14,7 @@ typedef std::shared_ptr<Address> AddressPtr;
 
 PacketMock::PacketMock(const char* sourceName, const char* destinationName, unsigned int sequenceNumber, int ttl, char packetType)
  : Packet(AddressPtr(new AddressMock(sourceName)), AddressPtr(new AddressMock(destinationName)), AddressPtr(new AddressMock(sourceName)), packetType, sequenceNumber, ttl, nullptr, 0){
-    const char* payloadString = "Hello World";
-    payloadSize = std::strlen(payloadString);
-    char* tmpPayload = new char[payloadSize+1];
-    strncpy(tmpPayload, payloadString, payloadSize);
-    tmpPayload[payloadSize] = '\0';
-    payloadSize++;
-    payload = tmpPayload;
+    payload = PayloadBuffer("Hello World", 0);
 }
 
 PacketMock::PacketMock(const char* sourceName, const char* destinationName, const char* senderName, unsigned int sequenceNumber, int ttl, char packetType, const char* payloadString)
@@ -0,0 +1,31 @@
+/*
+ * $FU-Copyright$
+ */
+
+#ifndef ROUTE_EVICTION_LISTENER_MOCK_H_
+#define ROUTE_EVICTION_LISTENER_MOCK_H_
+
+#include "RouteEvictionListener.h"
+#include "Address.h"
+#include "NetworkInterface.h"
+
+#include <deque>
+
+namespace ARA {
+
+/**
+ * Remembers all routes it has been notified about.
+ */
+class RouteEvictionListenerMock : public RouteEvictionListener {
+    public:
+        void routeHasBeenEvicted(AddressPtr destination, AddressPtr nextHop, NetworkInterface* interface) {
+            evictedDestinations.push_back(destination);
+            evictedNextHops.push_back(nextHop);
+        }
+
+        std::deque<AddressPtr> evictedDestinations;
+        std::deque<AddressPtr> evictedNextHops;
+};
+
+} /* namespace ARA */
+#endif /* ROUTE_EVICTION_LISTENER_MOCK_H_ */
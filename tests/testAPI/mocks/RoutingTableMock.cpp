@@ -1,13 +0,0 @@
-/*
- * $FU-Copyright$
- */
-
-#include "RoutingTableMock.h"
-
-namespace ARA {
-
-RoutingTableEntryList RoutingTableMock::getPossibleNextHops(AddressPtr destination) {
-    return *(table[destination]);
-}
-
-} /* namespace ARA */
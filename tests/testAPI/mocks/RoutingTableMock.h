@@ -10,12 +10,7 @@
 
 namespace ARA {
 
-class RoutingTableMock: public RoutingTable {
-public:
-
-    RoutingTableEntryList getPossibleNextHops(AddressPtr address);
-
-};
+class RoutingTableMock: public RoutingTable {};
 
 } /* namespace ARA */
 #endif /* ROUTING_TABLE_MOCK_H_ */